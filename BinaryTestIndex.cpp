@@ -0,0 +1,152 @@
+#include "BinaryTestIndex.h"
+
+#include <cstring>
+#include <stdexcept>
+
+#include "TestUnitPath.h"
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+namespace
+{
+
+bool IsWithin(std::size_t size, std::uint64_t offset, std::uint64_t length)
+{
+    return (offset <= size) && (length <= (size - offset));
+}
+
+bool IsAligned(std::uintptr_t address, std::size_t alignment)
+{
+    return (address % alignment) == 0;
+}
+
+/**
+ * @brief Validates a hash table: each bucket is either empty or refers to a record, and at least one bucket is empty so that probing terminates
+ */
+bool IsValidHashTable(const std::uint32_t* buckets, std::uint32_t bucketCount, std::uint32_t unitCount)
+{
+    bool empty = false;
+
+    for (std::uint32_t i = 0; i < bucketCount; ++i)
+    {
+        if (buckets[i] == c_binaryTestIndexNone)
+        {
+            empty = true;
+        }
+        else if (buckets[i] >= unitCount)
+        {
+            return false;
+        }
+    }
+
+    return empty;
+}
+
+} // namespace anonymous
+
+CBinaryTestIndex::CBinaryTestIndex(const void* data, std::size_t size) :
+    m_header(static_cast<const SBinaryTestIndexHeader*>(data))
+{
+    const char* base = static_cast<const char*>(data);
+
+    if ((size < sizeof(SBinaryTestIndexHeader)) || (std::memcmp(m_header->m_magic, c_binaryTestIndexMagic, sizeof(c_binaryTestIndexMagic)) != 0))
+    {
+        throw std::runtime_error("Malformed binary test index");
+    }
+
+    if (m_header->m_version != c_binaryTestIndexVersion)
+    {
+        throw std::runtime_error("Unsupported binary test index version");
+    }
+
+    // Records are accessed in place; the records hold 64-bit values, the hash tables 32-bit values
+    if (!IsAligned(reinterpret_cast<std::uintptr_t>(data), alignof(SBinaryTestIndexUnit)) ||
+        !IsAligned(m_header->m_unitsOffset, alignof(SBinaryTestIndexUnit)) ||
+        !IsAligned(m_header->m_pathBucketsOffset, alignof(std::uint32_t)) ||
+        !IsAligned(m_header->m_idBucketsOffset, alignof(std::uint32_t)))
+    {
+        throw std::runtime_error("Malformed binary test index");
+    }
+
+    const std::uint32_t buckets = m_header->m_bucketCount;
+
+    if ((buckets == 0) || ((buckets & (buckets - 1)) != 0) || (buckets <= m_header->m_unitCount) ||
+        !IsWithin(size, m_header->m_unitsOffset, std::uint64_t(m_header->m_unitCount) * sizeof(SBinaryTestIndexUnit)) ||
+        !IsWithin(size, m_header->m_pathBucketsOffset, std::uint64_t(buckets) * sizeof(std::uint32_t)) ||
+        !IsWithin(size, m_header->m_idBucketsOffset, std::uint64_t(buckets) * sizeof(std::uint32_t)) ||
+        !IsWithin(size, m_header->m_stringsOffset, m_header->m_stringsSize) ||
+        (m_header->m_stringsSize == 0) || (base[m_header->m_stringsOffset + m_header->m_stringsSize - 1] != '\0'))
+    {
+        throw std::runtime_error("Malformed binary test index");
+    }
+
+    m_units = reinterpret_cast<const SBinaryTestIndexUnit*>(base + m_header->m_unitsOffset);
+    m_pathBuckets = reinterpret_cast<const std::uint32_t*>(base + m_header->m_pathBucketsOffset);
+    m_idBuckets = reinterpret_cast<const std::uint32_t*>(base + m_header->m_idBucketsOffset);
+    m_strings = base + m_header->m_stringsOffset;
+
+    // Validate the references once so that lookups need not check them
+    const std::uint32_t units = m_header->m_unitCount;
+    const std::uint32_t strings = m_header->m_stringsSize;
+
+    if ((m_header->m_source >= strings) || !IsValidHashTable(m_pathBuckets, buckets, units) || !IsValidHashTable(m_idBuckets, buckets, units))
+    {
+        throw std::runtime_error("Malformed binary test index");
+    }
+
+    for (std::uint32_t i = 0; i < units; ++i)
+    {
+        const SBinaryTestIndexUnit& unit = m_units[i];
+
+        if ((unit.m_name >= strings) || (unit.m_path >= strings) || (unit.m_file >= strings) ||
+            ((unit.m_parent != c_binaryTestIndexNone) && (unit.m_parent >= units)))
+        {
+            throw std::runtime_error("Malformed binary test index");
+        }
+    }
+}
+
+const SBinaryTestIndexUnit* CBinaryTestIndex::FindByPath(const std::string& path) const
+{
+    const std::uint64_t hash = HashTestUnitPath(path);
+    const std::uint32_t mask = m_header->m_bucketCount - 1;
+
+    // Linear probing; the table always contains at least one empty bucket
+    for (std::uint32_t bucket = static_cast<std::uint32_t>(hash & mask); m_pathBuckets[bucket] != c_binaryTestIndexNone; bucket = (bucket + 1) & mask)
+    {
+        const SBinaryTestIndexUnit& unit = m_units[m_pathBuckets[bucket]];
+
+        if ((unit.m_pathHash == hash) && (path == GetString(unit.m_path)))
+        {
+            return &unit;
+        }
+    }
+
+    return nullptr;
+}
+
+const SBinaryTestIndexUnit* CBinaryTestIndex::FindById(std::uint32_t id) const
+{
+    const std::uint32_t mask = m_header->m_bucketCount - 1;
+
+    for (std::uint32_t bucket = GetBinaryTestIndexIdBucket(id, m_header->m_bucketCount); m_idBuckets[bucket] != c_binaryTestIndexNone; bucket = (bucket + 1) & mask)
+    {
+        const SBinaryTestIndexUnit& unit = m_units[m_idBuckets[bucket]];
+
+        if (unit.m_id == id)
+        {
+            return &unit;
+        }
+    }
+
+    return nullptr;
+}
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
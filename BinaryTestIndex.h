@@ -0,0 +1,155 @@
+#if !defined( _BinaryTestIndex_H_ )
+#define _BinaryTestIndex_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+/**
+ * @brief Layout of the binary test index (version 1) as written by CBinaryTestIndexWriter.
+ *
+ * The file consists of a header, an array of fixed-size test unit records, two open addressing hash tables
+ * (keyed by test unit path and by test unit id) and a table of NUL terminated strings. All offsets are byte
+ * offsets from the beginning of the file; all values are stored in the byte order of the writing machine.
+ * The file is intended to be memory mapped and queried in place via CBinaryTestIndex.
+ */
+const char c_binaryTestIndexMagic[4] = { 'B', 'E', 'T', 'I' };
+
+/**
+ * @brief Current version of the binary test index layout
+ */
+const std::uint32_t c_binaryTestIndexVersion = 1;
+
+/**
+ * @brief Value denoting an absent record index (e.g. an empty hash bucket or the parent of the master test suite)
+ */
+const std::uint32_t c_binaryTestIndexNone = 0xFFFFFFFF;
+
+struct SBinaryTestIndexHeader
+{
+    char m_magic[4];
+    std::uint32_t m_version;
+    std::uint32_t m_unitCount;          ///< number of test unit records
+    std::uint32_t m_bucketCount;        ///< number of buckets of each hash table (a power of 2)
+    std::uint32_t m_unitsOffset;        ///< offset of the SBinaryTestIndexUnit array
+    std::uint32_t m_pathBucketsOffset;  ///< offset of the hash table keyed by path (record indices)
+    std::uint32_t m_idBucketsOffset;    ///< offset of the hash table keyed by id (record indices)
+    std::uint32_t m_stringsOffset;      ///< offset of the string table
+    std::uint32_t m_stringsSize;        ///< size of the string table in bytes
+    std::uint32_t m_source;             ///< string offset of the test module file-path
+};
+
+enum EBinaryTestIndexUnitType
+{
+    BinaryTestIndexSuite = 0,
+    BinaryTestIndexCase = 1
+};
+
+struct SBinaryTestIndexUnit
+{
+    std::uint64_t m_pathHash;           ///< HashTestUnitPath of the test unit path
+    std::uint32_t m_id;                 ///< Boost UTF test unit id
+    std::uint32_t m_parent;             ///< record index of the parent test suite
+    std::uint32_t m_name;               ///< string offset of the test unit name
+    std::uint32_t m_path;               ///< string offset of the test unit path (as returned by GetTestUnitPath)
+    std::uint32_t m_file;               ///< string offset of the source file in which the test unit is declared
+    std::uint32_t m_line;               ///< source line at which the test unit is declared
+    std::uint32_t m_type;               ///< EBinaryTestIndexUnitType
+    std::uint32_t m_enabled;            ///< 1 in case the test unit is enabled by default; 0 otherwise
+};
+
+static_assert(sizeof(SBinaryTestIndexHeader) == 40, "binary test index header layout");
+static_assert(sizeof(SBinaryTestIndexUnit) == 40, "binary test index record layout");
+
+/**
+ * @brief Computes the bucket of a test unit id within the id hash table
+ *
+ * @param[in] id the Boost UTF test unit id
+ * @param[in] bucketCount the number of buckets (a power of 2)
+ */
+inline std::uint32_t GetBinaryTestIndexIdBucket(std::uint32_t id, std::uint32_t bucketCount)
+{
+    return static_cast<std::uint32_t>((id * 2654435761u) & (bucketCount - 1));
+}
+
+/**
+ * @brief Read-only view over a (memory mapped) binary test index. Lookups by path and by id take constant time.
+ */
+class CBinaryTestIndex
+{
+public:
+    /**
+     * @brief Constructor. Validates the index layout, the alignment of its sections and the record indices and string offsets it holds.
+     *
+     * @param[in] data pointer to the beginning of the index; must outlive this instance and be suitably aligned
+     * @param[in] size size of the index in bytes
+     * @throw std::runtime_error in case the data is not a valid binary test index of a supported version
+     */
+    CBinaryTestIndex(const void* data, std::size_t size);
+
+    /**
+     * @brief Getter for the number of test unit records
+     */
+    std::uint32_t GetUnitCount() const
+    {
+        return m_header->m_unitCount;
+    }
+
+    /**
+     * @brief Getter for the test unit record at the provided index
+     */
+    const SBinaryTestIndexUnit& GetUnit(std::uint32_t index) const
+    {
+        return m_units[index];
+    }
+
+    /**
+     * @brief Resolves a string offset of the index
+     */
+    const char* GetString(std::uint32_t offset) const
+    {
+        return m_strings + offset;
+    }
+
+    /**
+     * @brief Getter for the file-path of the test module the index was generated from
+     */
+    const char* GetSource() const
+    {
+        return GetString(m_header->m_source);
+    }
+
+    /**
+     * @brief Looks up a test unit by its path, e.g. "ExampleTestSuite/NumberTestCaseA"
+     *
+     * @return the test unit record or nullptr in case no such test unit exists
+     */
+    const SBinaryTestIndexUnit* FindByPath(const std::string& path) const;
+
+    /**
+     * @brief Looks up a test unit by its Boost UTF test unit id
+     *
+     * @return the test unit record or nullptr in case no such test unit exists
+     */
+    const SBinaryTestIndexUnit* FindById(std::uint32_t id) const;
+
+private:
+    const SBinaryTestIndexHeader* m_header;
+    const SBinaryTestIndexUnit* m_units;
+    const std::uint32_t* m_pathBuckets;
+    const std::uint32_t* m_idBuckets;
+    const char* m_strings;
+};
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
+
+#endif // _BinaryTestIndex_H_
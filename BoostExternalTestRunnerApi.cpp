@@ -0,0 +1,395 @@
+// Boost.Test
+#ifndef BOOST_TEST_DYN_LINK
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#include "BoostExternalTestRunnerApi.h"
+
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+//suppression of warnings related to 3rd party files
+#pragma warning ( disable: 6001 )
+#pragma warning ( disable: 6011 )
+#pragma warning ( disable: 6031 )
+
+#include <boost/test/framework.hpp>
+#include <boost/test/tree/test_unit.hpp>
+#include <boost/test/tree/traverse.hpp>
+#include <boost/test/tree/visitor.hpp>
+
+//end suppression of warnings related to 3rd party files
+#pragma warning ( default: 6001 )
+#pragma warning ( default: 6011 )
+#pragma warning ( default: 6031 )
+
+#include "CTestLibrary.h"
+#include "CTestResultObserver.h"
+#include "TestCaseResult.h"
+#include "TestUnitPath.h"
+
+using ::etas::boost::unit_test::CTestLibrary;
+using ::etas::boost::unit_test::CTestResultObserver;
+using ::etas::boost::unit_test::ITestResultListener;
+using ::etas::boost::unit_test::STestCaseResult;
+
+static_assert(BETR_FLAKY == static_cast<int>(::etas::boost::unit_test::OutcomeFlaky), "betr_outcome needs to mirror ETestOutcome");
+static_assert(BETR_RESOURCE_LIMIT == static_cast<int>(::etas::boost::unit_test::OutcomeResourceLimit), "betr_outcome needs to mirror ETestOutcome");
+
+struct betr_library
+{
+    std::vector<STestCaseResult> m_results;
+};
+
+namespace
+{
+
+/**
+ * @brief Description of the last error per thread
+ */
+thread_local std::string s_lastError;
+
+/**
+ * @brief The open test library handle, if any
+ */
+betr_library* s_library = nullptr;
+
+/**
+ * @brief The test library loaded into the process, if any.
+ *
+ * The Boost UTF framework cannot rebuild its test tree once it has been cleared, hence the test library and its
+ * test tree are kept for the lifetime of the process. Opening the same test library again reuses them.
+ */
+std::unique_ptr<CTestLibrary> s_loaded;
+
+bool InitTestLibrary()
+{
+    return s_loaded->Load();
+}
+
+/**
+ * @brief Releases a test library which failed to initialize, so that it can be opened again
+ */
+void ReleaseTestLibrary()
+{
+    // The test units registered so far may have been created by the test library, hence are destroyed first
+    ::boost::unit_test::framework::clear();
+
+    s_loaded.reset();
+}
+
+int Fail(int status, const std::string& error)
+{
+    s_lastError = error;
+    return status;
+}
+
+/**
+ * @brief Visitor reporting test units to a betr_unit_callback
+ */
+class CUnitEnumerator : public ::boost::unit_test::test_tree_visitor
+{
+public:
+    CUnitEnumerator(betr_unit_callback callback, void* context) :
+        m_callback(callback),
+        m_context(context),
+        m_stopped(false)
+    {
+    }
+
+    virtual void visit(const ::boost::unit_test::test_case& testCase) override
+    {
+        Report(testCase, BETR_TEST_CASE);
+    }
+
+    virtual bool test_suite_start(const ::boost::unit_test::test_suite& testSuite) override
+    {
+        return Report(testSuite, BETR_TEST_SUITE);
+    }
+
+private:
+    bool Report(const ::boost::unit_test::test_unit& testUnit, betr_unit_type type)
+    {
+        if (m_stopped)
+        {
+            return false;
+        }
+
+        const std::string path = ::etas::boost::unit_test::GetTestUnitPath(testUnit);
+        const std::string file(testUnit.p_file_name.begin(), testUnit.p_file_name.end());
+
+        betr_unit unit;
+
+        unit.id = testUnit.p_id;
+        unit.parent_id = (testUnit.p_parent_id == ::boost::unit_test::INV_TEST_UNIT_ID) ? 0 : testUnit.p_parent_id;
+        unit.type = type;
+        // The run status is only assigned once tests are executed; the default run status is settled by finalize_setup_phase
+        unit.enabled = (testUnit.p_default_status == ::boost::unit_test::test_unit::RS_ENABLED) ? 1 : 0;
+        unit.name = testUnit.p_name.value.c_str();
+        unit.path = path.c_str();
+        unit.file = file.c_str();
+        unit.line = static_cast<unsigned long>(testUnit.p_line_num);
+
+        m_stopped = (m_callback(&unit, m_context) != 0);
+
+        return !m_stopped;
+    }
+
+    betr_unit_callback m_callback;
+    void* m_context;
+    bool m_stopped;
+};
+
+/**
+ * @brief Visitor mapping test unit paths to test unit ids
+ */
+class CUnitPathCollector : public ::boost::unit_test::test_tree_visitor
+{
+public:
+    typedef std::map<std::string, ::boost::unit_test::test_unit_id> TUnits;
+
+    virtual void visit(const ::boost::unit_test::test_case& testCase) override
+    {
+        m_units[::etas::boost::unit_test::GetTestUnitPath(testCase)] = testCase.p_id;
+    }
+
+    virtual bool test_suite_start(const ::boost::unit_test::test_suite& testSuite) override
+    {
+        m_units[::etas::boost::unit_test::GetTestUnitPath(testSuite)] = testSuite.p_id;
+        return true;
+    }
+
+    const TUnits& GetUnits() const
+    {
+        return m_units;
+    }
+
+private:
+    TUnits m_units;
+};
+
+void ToResult(const STestCaseResult& source, betr_result& result)
+{
+    result.id = source.m_id;
+    result.outcome = static_cast<int>(source.m_outcome);
+    result.elapsed = source.m_elapsed;
+    result.path = source.m_path.c_str();
+    result.message = source.m_message.c_str();
+}
+
+/**
+ * @brief Listener recording the results of a run and forwarding them to a betr_result_callback
+ */
+class CResultRecorder : public ITestResultListener
+{
+public:
+    CResultRecorder(betr_library& library, betr_result_callback callback, void* context) :
+        m_library(&library),
+        m_callback(callback),
+        m_context(context)
+    {
+    }
+
+    virtual void OnTestCaseFinished(const STestCaseResult& result) override
+    {
+        m_library->m_results.push_back(result);
+
+        if (m_callback != nullptr)
+        {
+            betr_result converted;
+            ToResult(result, converted);
+
+            m_callback(&converted, m_context);
+        }
+    }
+
+private:
+    betr_library* m_library;
+    betr_result_callback m_callback;
+    void* m_context;
+};
+
+} // namespace anonymous
+
+extern "C"
+{
+
+BETR_API int BETR_CALL betr_api_version(void)
+{
+    return BETR_API_VERSION;
+}
+
+BETR_API const char* BETR_CALL betr_last_error(void)
+{
+    return s_lastError.c_str();
+}
+
+BETR_API int BETR_CALL betr_open(const char* path, const char* init_function, betr_library** library)
+{
+    if ((path == nullptr) || (library == nullptr))
+    {
+        return Fail(BETR_INVALID_ARGUMENT, "path and library are required");
+    }
+
+    if (s_library != nullptr)
+    {
+        return Fail(BETR_ERROR, "a test library is already open");
+    }
+
+    if (s_loaded)
+    {
+        if (s_loaded->GetPath() != path)
+        {
+            return Fail(BETR_ERROR, "a different test library has already been loaded into this process: " + s_loaded->GetPath());
+        }
+    }
+    else
+    {
+        s_loaded.reset(new CTestLibrary(path, (init_function == nullptr) ? "init_unit_test" : init_function));
+
+        try
+        {
+            // The Boost UTF runtime configuration is left at its defaults
+            char name[] = "BoostExternalTestRunner";
+            char* argv[] = { name, nullptr };
+
+            ::boost::unit_test::framework::init(&InitTestLibrary, 1, argv);
+            ::boost::unit_test::framework::finalize_setup_phase();
+        }
+        catch (const std::exception& ex)
+        {
+            // The exception may have been thrown by the test library; its message is copied before the library is released
+            const std::string error = ex.what();
+
+            ReleaseTestLibrary();
+            return Fail(BETR_ERROR, error);
+        }
+        catch (...)
+        {
+            ReleaseTestLibrary();
+            return Fail(BETR_ERROR, "Fail to initialize test library: " + std::string(path));
+        }
+    }
+
+    s_library = new betr_library;
+    *library = s_library;
+
+    return BETR_OK;
+}
+
+BETR_API void BETR_CALL betr_close(betr_library* library)
+{
+    if ((library == nullptr) || (library != s_library))
+    {
+        return;
+    }
+
+    // The test library itself stays loaded (see s_loaded)
+    s_library = nullptr;
+    delete library;
+}
+
+BETR_API int BETR_CALL betr_enumerate(betr_library* library, betr_unit_callback callback, void* context)
+{
+    if ((library == nullptr) || (library != s_library) || (callback == nullptr))
+    {
+        return Fail(BETR_INVALID_ARGUMENT, "an open library and a callback are required");
+    }
+
+    try
+    {
+        CUnitEnumerator enumerator(callback, context);
+        ::boost::unit_test::traverse_test_tree(::boost::unit_test::framework::master_test_suite(), enumerator, true);
+    }
+    catch (const std::exception& ex)
+    {
+        return Fail(BETR_ERROR, ex.what());
+    }
+
+    return BETR_OK;
+}
+
+BETR_API int BETR_CALL betr_run(betr_library* library, const char* const* paths, size_t count, betr_result_callback callback, void* context)
+{
+    if ((library == nullptr) || (library != s_library) || ((count > 0) && (paths == nullptr)))
+    {
+        return Fail(BETR_INVALID_ARGUMENT, "an open library is required");
+    }
+
+    std::vector<::boost::unit_test::test_unit_id> selection;
+
+    if (count == 0)
+    {
+        selection.push_back(::boost::unit_test::framework::master_test_suite().p_id);
+    }
+    else
+    {
+        CUnitPathCollector collector;
+        ::boost::unit_test::traverse_test_tree(::boost::unit_test::framework::master_test_suite(), collector, true);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            CUnitPathCollector::TUnits::const_iterator unit = collector.GetUnits().find((paths[i] == nullptr) ? std::string() : paths[i]);
+
+            if (unit == collector.GetUnits().end())
+            {
+                return Fail(BETR_INVALID_ARGUMENT, "Unknown test unit: " + std::string((paths[i] == nullptr) ? "" : paths[i]));
+            }
+
+            selection.push_back(unit->second);
+        }
+    }
+
+    library->m_results.clear();
+
+    CResultRecorder recorder(*library, callback, context);
+
+    CTestResultObserver observer;
+    observer.AddListener(recorder);
+
+    ::boost::unit_test::framework::register_observer(observer);
+
+    int status = BETR_OK;
+
+    try
+    {
+        for (auto i = selection.begin(), end = selection.end(); i != end; ++i)
+        {
+            ::boost::unit_test::framework::run(*i);
+        }
+    }
+    catch (const std::exception& ex)
+    {
+        status = Fail(BETR_ERROR, ex.what());
+    }
+    catch (...)
+    {
+        status = Fail(BETR_ERROR, "Fail to execute tests");
+    }
+
+    ::boost::unit_test::framework::deregister_observer(observer);
+
+    return status;
+}
+
+BETR_API size_t BETR_CALL betr_result_count(const betr_library* library)
+{
+    return (library == nullptr) ? 0 : library->m_results.size();
+}
+
+BETR_API int BETR_CALL betr_get_result(const betr_library* library, size_t index, betr_result* result)
+{
+    if ((library == nullptr) || (result == nullptr) || (index >= library->m_results.size()))
+    {
+        return Fail(BETR_INVALID_ARGUMENT, "an open library, a result and a valid index are required");
+    }
+
+    ToResult(library->m_results[index], *result);
+
+    return BETR_OK;
+}
+
+} // extern "C"
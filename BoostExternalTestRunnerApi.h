@@ -0,0 +1,183 @@
+#if !defined( _BoostExternalTestRunnerApi_H_ )
+#define _BoostExternalTestRunnerApi_H_
+
+/**
+ * @file
+ * @brief C interface of the Boost External Test Runner library.
+ *
+ * Allows tools to discover and execute the tests of a Boost UTF test library in-process, i.e. without
+ * spawning a Boost External Test Runner process per request. The Boost UTF framework is a per-process
+ * singleton which cannot rebuild its test tree, hence a single test library can be loaded per process:
+ * it stays loaded once opened and opening it again is cheap. Calls must not be made concurrently.
+ * Strings passed to callbacks are only valid for the duration of the callback.
+ */
+
+#include <stddef.h>
+
+#if defined(_WIN32)
+#if defined(BETR_API_EXPORTS)
+#define BETR_API __declspec(dllexport)
+#else
+#define BETR_API __declspec(dllimport)
+#endif
+#define BETR_CALL __cdecl
+#else
+#define BETR_API __attribute__((visibility("default")))
+#define BETR_CALL
+#endif
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @brief Version of this interface. Incremented whenever the interface changes incompatibly.
+ */
+#define BETR_API_VERSION 1
+
+/**
+ * @brief Status codes returned by the interface functions
+ */
+typedef enum betr_status
+{
+    BETR_OK = 0,                ///< the call succeeded
+    BETR_ERROR = -1,            ///< the call failed; refer to betr_last_error
+    BETR_INVALID_ARGUMENT = -2  ///< an argument is invalid (e.g. an unknown test unit path); refer to betr_last_error
+} betr_status;
+
+/**
+ * @brief Test unit types
+ */
+typedef enum betr_unit_type
+{
+    BETR_TEST_SUITE = 0,
+    BETR_TEST_CASE = 1
+} betr_unit_type;
+
+/**
+ * @brief Test case outcomes
+ */
+typedef enum betr_outcome
+{
+    BETR_PASSED = 0,
+    BETR_FAILED = 1,
+    BETR_ABORTED = 2,
+    BETR_SKIPPED = 3,
+    BETR_TIMEOUT = 4,
+    BETR_FLAKY = 5,
+    BETR_RESOURCE_LIMIT = 6
+} betr_outcome;
+
+/**
+ * @brief Description of a test unit
+ */
+typedef struct betr_unit
+{
+    unsigned long id;           ///< test unit id as assigned by the Boost UTF framework
+    unsigned long parent_id;    ///< id of the parent test suite; 0 for the master test suite
+    int type;                   ///< betr_unit_type
+    int enabled;                ///< non-zero in case the test unit is enabled by default
+    const char* name;           ///< test unit name
+    const char* path;           ///< full test unit path, e.g. "ExampleTestSuite/NumberTestCaseA"; empty for the master test suite
+    const char* file;           ///< source file in which the test unit is declared (may be empty)
+    unsigned long line;         ///< source line at which the test unit is declared
+} betr_unit;
+
+/**
+ * @brief Result of a test case execution
+ */
+typedef struct betr_result
+{
+    unsigned long id;           ///< test case id as assigned by the Boost UTF framework
+    int outcome;                ///< betr_outcome
+    unsigned long elapsed;      ///< elapsed execution time in microseconds
+    const char* path;           ///< full test case path
+    const char* message;        ///< optional detail on the outcome (may be empty)
+} betr_result;
+
+/**
+ * @brief Opaque handle of an open test library
+ */
+typedef struct betr_library betr_library;
+
+/**
+ * @brief Callback receiving test units during enumeration (parents precede their children)
+ * @return 0 to continue the enumeration; any other value to stop it
+ */
+typedef int (BETR_CALL *betr_unit_callback)(const betr_unit* unit, void* context);
+
+/**
+ * @brief Callback receiving test case results as soon as test cases finish
+ */
+typedef void (BETR_CALL *betr_result_callback)(const betr_result* result, void* context);
+
+/**
+ * @brief Returns BETR_API_VERSION of the library
+ */
+BETR_API int BETR_CALL betr_api_version(void);
+
+/**
+ * @brief Returns a description of the last error of the calling thread (never NULL)
+ */
+BETR_API const char* BETR_CALL betr_last_error(void);
+
+/**
+ * @brief Loads a test library and initializes its test tree. In case the test library has been loaded
+ *        before, the loaded test tree is reused.
+ *
+ * @param[in] path file-path of the test library
+ * @param[in] init_function name of the initialization function; NULL for "init_unit_test"
+ * @param[out] library receives the handle of the open library
+ * @return BETR_OK on success
+ */
+BETR_API int BETR_CALL betr_open(const char* path, const char* init_function, betr_library** library);
+
+/**
+ * @brief Closes a test library handle. The handle is invalid afterwards; the test library stays loaded.
+ */
+BETR_API void BETR_CALL betr_close(betr_library* library);
+
+/**
+ * @brief Enumerates the test units of an open test library
+ *
+ * @param[in] library the open library
+ * @param[in] callback receives each test unit
+ * @param[in] context passed as-is to the callback
+ * @return BETR_OK on success
+ */
+BETR_API int BETR_CALL betr_enumerate(betr_library* library, betr_unit_callback callback, void* context);
+
+/**
+ * @brief Executes a selection of test units of an open test library
+ *
+ * Results of a previous run are discarded.
+ *
+ * @param[in] library the open library
+ * @param[in] paths paths of the test units (suites or cases) to execute
+ * @param[in] count number of paths; 0 to execute all test units
+ * @param[in] callback optional callback receiving each test case result as soon as the test case finishes
+ * @param[in] context passed as-is to the callback
+ * @return BETR_OK in case the selection has been executed (irrespective of the test outcomes)
+ */
+BETR_API int BETR_CALL betr_run(betr_library* library, const char* const* paths, size_t count, betr_result_callback callback, void* context);
+
+/**
+ * @brief Returns the number of test case results of the last run
+ */
+BETR_API size_t BETR_CALL betr_result_count(const betr_library* library);
+
+/**
+ * @brief Reads a test case result of the last run
+ *
+ * @param[in] library the open library
+ * @param[in] index index of the result, less than betr_result_count
+ * @param[out] result receives the result; its strings are valid until the next run or until the library is closed
+ * @return BETR_OK on success
+ */
+BETR_API int BETR_CALL betr_get_result(const betr_library* library, size_t index, betr_result* result);
+
+#if defined(__cplusplus)
+} // extern "C"
+#endif
+
+#endif // _BoostExternalTestRunnerApi_H_
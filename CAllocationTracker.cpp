@@ -0,0 +1,455 @@
+#include "CAllocationTracker.h"
+
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+
+//suppression of warnings related to 3rd party files
+#pragma warning ( disable: 6001 )
+#pragma warning ( disable: 6031 )
+
+#include <boost/test/tree/test_unit.hpp>
+#include <boost/test/utils/xml_printer.hpp>
+
+//end suppression of warnings related to 3rd party files
+#pragma warning ( default: 6001 )
+#pragma warning ( default: 6031 )
+
+#include "TestUnitPath.h"
+
+#if defined(_MSC_VER) && defined(_DEBUG)        // Windows debug CRT
+
+#define ETAS_ALLOCATION_HOOK_CRT
+#include <crtdbg.h>
+
+#elif defined(__GLIBC__)                        // glibc symbol interposition
+
+#define ETAS_ALLOCATION_HOOK_GLIBC
+#include <malloc.h>
+
+#endif
+
+namespace
+{
+
+// Counters are plain atomics since the interception hooks may be invoked concurrently
+// from any thread and must neither allocate nor lock.
+std::atomic<bool> s_enabled(false);
+std::atomic<unsigned long long> s_allocations(0);
+std::atomic<unsigned long long> s_bytes(0);
+std::atomic<long long> s_liveBytes(0);
+std::atomic<long long> s_peakBytes(0);
+
+/**
+ * @brief Accounts an allocation
+ *
+ * @param[in] size the size of the block
+ * @param[in] tracked true in case the release of the block is recognized as the release of a block allocated during the test,
+ *            i.e. the block counts towards the live bytes
+ */
+inline void OnAllocate(std::size_t size, bool tracked)
+{
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    s_bytes.fetch_add(size, std::memory_order_relaxed);
+
+    if (!tracked)
+    {
+        return;
+    }
+
+    long long live = s_liveBytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed) + static_cast<long long>(size);
+    long long peak = s_peakBytes.load(std::memory_order_relaxed);
+
+    while ((live > peak) && !s_peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+    {
+    }
+}
+
+/**
+ * @brief Accounts the release of a block allocated during the test. Blocks allocated ahead of the test are not accounted
+ *        so that the live bytes do not go negative.
+ */
+inline void OnFree(std::size_t size)
+{
+    s_liveBytes.fetch_sub(static_cast<long long>(size), std::memory_order_relaxed);
+}
+
+inline bool IsEnabled()
+{
+    return s_enabled.load(std::memory_order_relaxed);
+}
+
+// Utility function which is used to simply avoid writing '::boost::unit_test::attr_value()'
+::boost::unit_test::attr_value attr_value()
+{
+    return ::boost::unit_test::attr_value();
+};
+
+#if defined(ETAS_ALLOCATION_HOOK_CRT)
+
+// Request number of the first block allocated during the test; the debug CRT numbers the blocks in order of allocation
+std::atomic<long> s_firstRequest(LONG_MAX);
+
+void ResetBlocks()
+{
+    s_firstRequest = LONG_MAX;
+}
+
+/**
+ * @brief Determines whether a block has been allocated during the test
+ */
+bool IsTestBlock(void* userData, int blockType)
+{
+    long request = 0;
+
+    return _CrtIsMemoryBlock(userData, static_cast<unsigned int>(_msize_dbg(userData, blockType)), &request, NULL, NULL) &&
+           (request >= s_firstRequest.load(std::memory_order_relaxed));
+}
+
+void OnAllocateRequest(long requestNumber, std::size_t size)
+{
+    long first = s_firstRequest.load(std::memory_order_relaxed);
+
+    while ((requestNumber < first) && !s_firstRequest.compare_exchange_weak(first, requestNumber, std::memory_order_relaxed))
+    {
+    }
+
+    OnAllocate(size, true);
+}
+
+int __cdecl AllocHook(int allocType, void* userData, size_t size, int blockType, long requestNumber, const unsigned char* fileName, int lineNumber)
+{
+    // CRT internal allocations are not of interest
+    if (IsEnabled() && (blockType != _CRT_BLOCK))
+    {
+        switch (allocType)
+        {
+        case _HOOK_ALLOC:
+            OnAllocateRequest(requestNumber, size);
+            break;
+
+        case _HOOK_REALLOC:
+            if ((userData != NULL) && IsTestBlock(userData, blockType))
+            {
+                OnFree(_msize_dbg(userData, blockType));
+            }
+
+            OnAllocateRequest(requestNumber, size);
+            break;
+
+        case _HOOK_FREE:
+            if ((userData != NULL) && IsTestBlock(userData, blockType))
+            {
+                OnFree(_msize_dbg(userData, blockType));
+            }
+            break;
+        }
+    }
+
+    return TRUE;
+}
+
+#elif defined(ETAS_ALLOCATION_HOOK_GLIBC)
+
+// Blocks allocated during the test, as open addressing table of their addresses (nullptr denoting a free slot).
+// The table is zero-initialized static storage whose pages are only committed once used. Blocks which find no free
+// slot within the probing distance are counted as allocations but not towards the live bytes.
+const std::size_t c_blockSlots = 1 << 18;
+const std::size_t c_maxProbes = 32;
+
+std::atomic<void*> s_blocks[c_blockSlots];
+std::atomic<bool> s_blocksUsed(false);
+
+inline std::size_t GetBlockSlot(void* ptr)
+{
+    // Fibonacci hashing of the address, ignoring the bits which are 0 due to the alignment of the blocks
+    return static_cast<std::size_t>(((reinterpret_cast<std::uintptr_t>(ptr) >> 4) * 11400714819323198485ull) >> 46) & (c_blockSlots - 1);
+}
+
+bool InsertBlock(void* ptr)
+{
+    const std::size_t slot = GetBlockSlot(ptr);
+
+    for (std::size_t i = 0; i < c_maxProbes; ++i)
+    {
+        std::atomic<void*>& entry = s_blocks[(slot + i) & (c_blockSlots - 1)];
+        void* expected = nullptr;
+
+        if ((entry.load(std::memory_order_relaxed) == nullptr) && entry.compare_exchange_strong(expected, ptr, std::memory_order_relaxed))
+        {
+            s_blocksUsed.store(true, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool EraseBlock(void* ptr)
+{
+    const std::size_t slot = GetBlockSlot(ptr);
+
+    // Released slots are nullptr as well, hence the whole probing distance is searched
+    for (std::size_t i = 0; i < c_maxProbes; ++i)
+    {
+        std::atomic<void*>& entry = s_blocks[(slot + i) & (c_blockSlots - 1)];
+        void* expected = ptr;
+
+        if ((entry.load(std::memory_order_relaxed) == ptr) && entry.compare_exchange_strong(expected, nullptr, std::memory_order_relaxed))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ResetBlocks()
+{
+    // Blocks which outlive their test are forgotten so that their release does not count towards a later test
+    if (s_blocksUsed.exchange(false))
+    {
+        for (std::size_t i = 0; i < c_blockSlots; ++i)
+        {
+            s_blocks[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief Accounts the block returned by an allocation function
+ */
+inline void* OnAllocated(void* ptr)
+{
+    if ((ptr != NULL) && IsEnabled())
+    {
+        OnAllocate(malloc_usable_size(ptr), InsertBlock(ptr));
+    }
+
+    return ptr;
+}
+
+#else
+
+void ResetBlocks()
+{
+}
+
+#endif
+
+void Reset()
+{
+    ResetBlocks();
+
+    s_allocations = 0;
+    s_bytes = 0;
+    s_liveBytes = 0;
+    s_peakBytes = 0;
+}
+
+} // namespace anonymous
+
+#if defined(ETAS_ALLOCATION_HOOK_GLIBC)
+
+// Interpose the C allocation functions for the whole process (operator new/delete are implemented in terms of these).
+// Sizes are accounted in terms of usable block sizes since that is the only information available on release.
+
+extern "C"
+{
+
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void* __libc_valloc(size_t size);
+void* __libc_pvalloc(size_t size);
+void __libc_free(void* ptr);
+
+void* malloc(size_t size)
+{
+    return OnAllocated(__libc_malloc(size));
+}
+
+void* calloc(size_t count, size_t size)
+{
+    return OnAllocated(__libc_calloc(count, size));
+}
+
+void* realloc(void* ptr, size_t size)
+{
+    const std::size_t previous = ((ptr != NULL) && IsEnabled()) ? malloc_usable_size(ptr) : 0;
+    const bool tracked = (previous > 0) && EraseBlock(ptr);
+
+    if (tracked)
+    {
+        OnFree(previous);
+    }
+
+    void* result = __libc_realloc(ptr, size);
+
+    if ((result == NULL) && (ptr != NULL) && (size > 0))
+    {
+        // The original block is left untouched on failure
+        if (tracked && InsertBlock(ptr))
+        {
+            s_liveBytes.fetch_add(static_cast<long long>(previous), std::memory_order_relaxed);
+        }
+
+        return result;
+    }
+
+    return OnAllocated(result);
+}
+
+void* memalign(size_t alignment, size_t size)
+{
+    return OnAllocated(__libc_memalign(alignment, size));
+}
+
+void* aligned_alloc(size_t alignment, size_t size)
+{
+    return memalign(alignment, size);
+}
+
+int posix_memalign(void** ptr, size_t alignment, size_t size)
+{
+    if ((alignment == 0) || ((alignment & (alignment - 1)) != 0) || ((alignment % sizeof(void*)) != 0))
+    {
+        return EINVAL;
+    }
+
+    void* result = memalign(alignment, size);
+
+    if (result == NULL)
+    {
+        return ENOMEM;
+    }
+
+    *ptr = result;
+    return 0;
+}
+
+void* valloc(size_t size)
+{
+    return OnAllocated(__libc_valloc(size));
+}
+
+void* pvalloc(size_t size)
+{
+    return OnAllocated(__libc_pvalloc(size));
+}
+
+void free(void* ptr)
+{
+    if ((ptr != NULL) && IsEnabled() && EraseBlock(ptr))
+    {
+        OnFree(malloc_usable_size(ptr));
+    }
+
+    __libc_free(ptr);
+}
+
+} // extern "C"
+
+#endif
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+CAllocationTracker::SAllocationStats::SAllocationStats() :
+    m_allocations(0),
+    m_bytes(0),
+    m_peakBytes(0),
+    m_liveBytes(0)
+{
+}
+
+CAllocationTracker::CAllocationTracker(const std::string& source, std::ostream* out) :
+    m_out(out),
+    m_source(source)
+{
+#if defined(ETAS_ALLOCATION_HOOK_CRT)
+    _CrtSetAllocHook(AllocHook);
+#endif
+}
+
+CAllocationTracker::~CAllocationTracker()
+{
+    s_enabled = false;
+
+#if defined(ETAS_ALLOCATION_HOOK_CRT)
+    _CrtSetAllocHook(NULL);
+#endif
+}
+
+bool CAllocationTracker::IsSupported()
+{
+#if defined(ETAS_ALLOCATION_HOOK_CRT) || defined(ETAS_ALLOCATION_HOOK_GLIBC)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void CAllocationTracker::test_start(::boost::unit_test::counter_t)
+{
+    *m_out << "<?xml version=\"1.0\" encoding=\"UTF-8\" ?>" << std::endl
+           << "<AllocationReport source" << attr_value() << m_source << '>' << std::endl;
+}
+
+void CAllocationTracker::test_finish()
+{
+    *m_out << "</AllocationReport>" << std::endl;
+}
+
+void CAllocationTracker::test_unit_start(const ::boost::unit_test::test_unit& testUnit)
+{
+    if (testUnit.p_type == ::boost::unit_test::TUT_CASE)
+    {
+        Reset();
+        s_enabled = true;
+    }
+}
+
+void CAllocationTracker::test_unit_finish(const ::boost::unit_test::test_unit& testUnit, unsigned long)
+{
+    if (testUnit.p_type != ::boost::unit_test::TUT_CASE)
+    {
+        return;
+    }
+
+    s_enabled = false;
+
+    SAllocationStats stats = Collect();
+
+    *m_out << "    <TestCase"
+              " id" << attr_value() << testUnit.p_id <<
+              " path" << attr_value() << GetTestUnitPath(testUnit) <<
+              " allocations" << attr_value() << stats.m_allocations <<
+              " bytes" << attr_value() << stats.m_bytes <<
+              " peak" << attr_value() << stats.m_peakBytes <<
+              " live" << attr_value() << stats.m_liveBytes <<
+              " />" << std::endl;
+}
+
+CAllocationTracker::SAllocationStats CAllocationTracker::Collect()
+{
+    SAllocationStats stats;
+
+    stats.m_allocations = s_allocations;
+    stats.m_bytes = s_bytes;
+    stats.m_peakBytes = s_peakBytes;
+    stats.m_liveBytes = s_liveBytes;
+
+    return stats;
+}
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
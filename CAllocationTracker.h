@@ -0,0 +1,101 @@
+#if !defined( _CAllocationTracker_H_ )
+#define _CAllocationTracker_H_
+
+#include <ostream>
+#include <string>
+
+#include <boost/noncopyable.hpp>
+#include <boost/test/tree/observer.hpp>
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+/**
+ * @brief Boost test_observer implementation which accounts heap allocations per test case
+ *        and generates an xml report of the collected figures.
+ *
+ * Allocations are intercepted process-wide (i.e. including those performed by the test library)
+ * by interposing malloc/free on glibc based systems and via a CRT allocation hook on Windows debug builds.
+ * Accounting is only active in between the start and the end of a test case. The live and peak figures only
+ * consider blocks allocated during the test case; releasing blocks allocated ahead of it does not affect them.
+ */
+class CAllocationTracker :
+    public ::boost::unit_test::test_observer,
+    private ::boost::noncopyable
+{
+public:
+    typedef ::boost::unit_test::test_observer TBase;
+
+    /**
+     * @brief Allocation figures collected for a single test case
+     */
+    struct SAllocationStats
+    {
+        SAllocationStats();
+
+        unsigned long long m_allocations;   ///< number of allocations performed
+        unsigned long long m_bytes;         ///< total number of bytes allocated
+        long long m_peakBytes;              ///< peak number of bytes allocated during the test live at any point during the test
+        long long m_liveBytes;              ///< number of bytes allocated during the test which are still live at its end
+    };
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] source file-path to the exe/dll module which contains a Boost test framework
+     * @param[in] out a pointer to the output stream which will be used to output the xml result
+     */
+    CAllocationTracker(const std::string& source, std::ostream* out);
+
+    /**
+     * @brief Destructor
+     */
+    virtual ~CAllocationTracker();
+
+    /**
+     * @brief States whether allocations can be intercepted on this platform/build configuration
+     */
+    static bool IsSupported();
+
+    // test observer interface
+
+    /**
+     * @brief Observer method for the start of the test run. Writes the xml preamble.
+     */
+    virtual void test_start(::boost::unit_test::counter_t testCasesAmount) override;
+
+    /**
+     * @brief Observer method for the end of the test run. Writes the closing xml elements.
+     */
+    virtual void test_finish() override;
+
+    /**
+     * @brief Observer method for the start of a test unit. Resets and enables accounting for test cases.
+     */
+    virtual void test_unit_start(const ::boost::unit_test::test_unit& testUnit) override;
+
+    /**
+     * @brief Observer method for the end of a test unit. Disables accounting and reports the figures of test cases.
+     */
+    virtual void test_unit_finish(const ::boost::unit_test::test_unit& testUnit, unsigned long elapsed) override;
+
+private:
+    /**
+     * @brief Collects the figures accounted since the last reset
+     */
+    static SAllocationStats Collect();
+
+    std::ostream* m_out;
+
+    std::string m_source;
+};
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
+
+#endif // _CAllocationTracker_H_
@@ -0,0 +1,358 @@
+#include "CAsyncLogSink.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+
+#include <boost/config.hpp>
+
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32) // WIN32 API
+
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+
+#else // POSIX API
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#endif
+
+#include "CrashHandler.h"
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+namespace
+{
+
+// Interval at which the writer thread polls the ring buffer while it is empty
+const std::chrono::milliseconds c_pollInterval(1);
+
+const std::size_t c_minimumCapacity = 4096;
+
+/**
+ * @brief Formats the log line reporting discarded output
+ * @return the length of the line; a negative value on error
+ */
+int FormatDropMarker(char (&marker)[64], std::size_t dropped)
+{
+    return std::snprintf(marker, sizeof(marker), "\n[%lu bytes of log output dropped]\n", static_cast<unsigned long>(dropped));
+}
+
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32) // WIN32 API
+
+int OpenDestination(const std::string& destination, bool append)
+{
+    return _open(destination.c_str(), _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY | (append ? 0 : _O_TRUNC), _S_IREAD | _S_IWRITE);
+}
+
+int DuplicateDestination(int fd)
+{
+    return _dup(fd);
+}
+
+void WriteAll(int fd, const char* data, std::size_t size)
+{
+    while (size > 0)
+    {
+        int written = _write(fd, data, static_cast<unsigned int>(std::min<std::size_t>(size, 0x40000000)));
+
+        if (written <= 0)
+        {
+            return;
+        }
+
+        data += written;
+        size -= static_cast<std::size_t>(written);
+    }
+}
+
+void CloseDestination(int fd)
+{
+    _close(fd);
+}
+
+#else // POSIX API
+
+int OpenDestination(const std::string& destination, bool append)
+{
+    return open(destination.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC | (append ? 0 : O_TRUNC), 0644);
+}
+
+int DuplicateDestination(int fd)
+{
+    return fcntl(fd, F_DUPFD_CLOEXEC, 0);
+}
+
+void WriteAll(int fd, const char* data, std::size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t written = write(fd, data, size);
+
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return;
+        }
+
+        data += written;
+        size -= static_cast<std::size_t>(written);
+    }
+}
+
+void CloseDestination(int fd)
+{
+    close(fd);
+}
+
+#endif
+
+} // namespace anonymous
+
+std::atomic<CAsyncLogSink*> CAsyncLogSink::s_instance(nullptr);
+
+CAsyncLogSink::CAsyncLogSink(const std::string& destination, std::size_t capacity, EOverflowPolicy policy, bool append) :
+    m_mask(0),
+    m_policy(policy),
+    m_fd(-1),
+    m_head(0),
+    m_tail(0),
+    m_dropped(0),
+    m_droppedTotal(0),
+    m_stop(false),
+    m_stream(this)
+{
+    // The standard streams are written via duplicates, since the output capture (see COutputCapture) redirects
+    // their descriptors to the capture file of the running test case while the writer thread may still be writing
+    if (destination == "stdout")
+    {
+        // Whatever has been written via stdio so far precedes the log
+        std::fflush(stdout);
+        m_fd = DuplicateDestination(1);
+    }
+    else if (destination == "stderr")
+    {
+        m_fd = DuplicateDestination(2);
+    }
+    else
+    {
+        m_fd = OpenDestination(destination, append);
+    }
+
+    if (m_fd < 0)
+    {
+        throw std::runtime_error("Fail to open log file: " + destination);
+    }
+
+    std::size_t size = c_minimumCapacity;
+
+    while (size < capacity)
+    {
+        size <<= 1;
+    }
+
+    m_buffer.resize(size);
+    m_mask = size - 1;
+
+    m_writer = std::thread(&CAsyncLogSink::Drain, this);
+
+    s_instance = this;
+    AddCrashCallback(&CAsyncLogSink::FlushOnCrash);
+}
+
+CAsyncLogSink::~CAsyncLogSink()
+{
+    m_stop = true;
+    m_writer.join();
+
+    RemoveCrashCallback(&CAsyncLogSink::FlushOnCrash);
+    s_instance = nullptr;
+
+    if (m_dropped > 0)
+    {
+        char marker[64];
+        int length = FormatDropMarker(marker, m_dropped);
+
+        if (length > 0)
+        {
+            WriteAll(m_fd, marker, static_cast<std::size_t>(length));
+        }
+    }
+
+    CloseDestination(m_fd);
+}
+
+bool CAsyncLogSink::ParseOverflowPolicy(const std::string& name, EOverflowPolicy& policy)
+{
+    if (name == "block")
+    {
+        policy = OverflowBlock;
+        return true;
+    }
+
+    if (name == "drop")
+    {
+        policy = OverflowDrop;
+        return true;
+    }
+
+    return false;
+}
+
+CAsyncLogSink::int_type CAsyncLogSink::overflow(int_type c)
+{
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+    {
+        const char ch = traits_type::to_char_type(c);
+        Push(&ch, 1);
+    }
+
+    return traits_type::not_eof(c);
+}
+
+std::streamsize CAsyncLogSink::xsputn(const char* s, std::streamsize n)
+{
+    Push(s, static_cast<std::size_t>(n));
+    return n;
+}
+
+void CAsyncLogSink::Push(const char* data, std::size_t size)
+{
+    const std::size_t capacity = m_buffer.size();
+
+    if (m_policy == OverflowDrop)
+    {
+        std::size_t free = capacity - (m_head.load(std::memory_order_relaxed) - m_tail.load(std::memory_order_acquire));
+
+        if (m_dropped > 0)
+        {
+            // Report the discarded output as soon as there is room to do so
+            char marker[64];
+            int length = FormatDropMarker(marker, m_dropped);
+
+            if ((length < 0) || (free < (static_cast<std::size_t>(length) + size)))
+            {
+                m_dropped += size;
+                m_droppedTotal += size;
+                return;
+            }
+
+            Copy(marker, static_cast<std::size_t>(length));
+            free -= static_cast<std::size_t>(length);
+            m_dropped = 0;
+        }
+
+        if (free < size)
+        {
+            m_dropped += size;
+            m_droppedTotal += size;
+            return;
+        }
+
+        Copy(data, size);
+        return;
+    }
+
+    while (size > 0)
+    {
+        const std::size_t free = capacity - (m_head.load(std::memory_order_relaxed) - m_tail.load(std::memory_order_acquire));
+        const std::size_t chunk = std::min(size, free);
+
+        if (chunk == 0)
+        {
+            // Back-pressure: wait for the writer thread to make room
+            std::this_thread::yield();
+            continue;
+        }
+
+        Copy(data, chunk);
+
+        data += chunk;
+        size -= chunk;
+    }
+}
+
+void CAsyncLogSink::Copy(const char* data, std::size_t size)
+{
+    const std::size_t head = m_head.load(std::memory_order_relaxed);
+    const std::size_t index = head & m_mask;
+    const std::size_t first = std::min(size, m_buffer.size() - index);
+
+    std::copy(data, data + first, &m_buffer[index]);
+    std::copy(data + first, data + size, &m_buffer[0]);
+
+    m_head.store(head + size, std::memory_order_release);
+}
+
+void CAsyncLogSink::Drain()
+{
+    for (;;)
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        const std::size_t head = m_head.load(std::memory_order_acquire);
+
+        if (head != tail)
+        {
+            // Everything accumulated since the last iteration is written at once
+            WriteRange(tail, head);
+            m_tail.store(head, std::memory_order_release);
+        }
+        else if (m_stop)
+        {
+            // The producer has stopped; make sure nothing was pushed in the meantime
+            if (m_head.load(std::memory_order_acquire) == tail)
+            {
+                return;
+            }
+        }
+        else
+        {
+            std::this_thread::sleep_for(c_pollInterval);
+        }
+    }
+}
+
+void CAsyncLogSink::WriteRange(std::size_t tail, std::size_t head)
+{
+    while (tail != head)
+    {
+        const std::size_t index = tail & m_mask;
+        const std::size_t length = std::min(head - tail, m_buffer.size() - index);
+
+        WriteAll(m_fd, &m_buffer[index], length);
+
+        tail += length;
+    }
+}
+
+void CAsyncLogSink::FlushOnCrash()
+{
+    CAsyncLogSink* instance = s_instance.exchange(nullptr);
+
+    if (instance != nullptr)
+    {
+        // The writer thread may be in the middle of writing the same range; duplicating
+        // some output is preferable to losing the output which led to the crash.
+        const std::size_t tail = instance->m_tail.load(std::memory_order_acquire);
+        const std::size_t head = instance->m_head.load(std::memory_order_acquire);
+
+        instance->WriteRange(tail, head);
+    }
+}
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
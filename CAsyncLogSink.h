@@ -0,0 +1,145 @@
+#if !defined( _CAsyncLogSink_H_ )
+#define _CAsyncLogSink_H_
+
+#include <atomic>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+/**
+ * @brief Output stream buffer which decouples the Boost UTF log from the (slow) log destination.
+ *
+ * Characters written by the test thread are copied into a lock-free single-producer/single-consumer
+ * ring buffer and written to the destination in batches by a background writer thread. Flushing the
+ * stream (e.g. std::endl) does not wait for the writer. In case the process crashes, whatever is still
+ * buffered is written from the crash handler.
+ *
+ * Only a single instance may be alive at any time.
+ */
+class CAsyncLogSink :
+    public std::streambuf,
+    private ::boost::noncopyable
+{
+public:
+    /**
+     * @brief Behaviour of the producer when the ring buffer is full
+     */
+    enum EOverflowPolicy
+    {
+        OverflowBlock,  ///< wait for the writer thread to make room (back-pressure); no output is lost
+        OverflowDrop    ///< discard the output which does not fit and report the amount discarded in the log
+    };
+
+    /**
+     * @brief Constructor. Opens the destination and starts the writer thread.
+     *
+     * @param[in] destination "stdout", "stderr" or the file-path of the log file
+     * @param[in] capacity ring buffer capacity in bytes (rounded up to a power of 2)
+     * @param[in] policy behaviour when the ring buffer is full
+     * @param[in] append true to append to an existing log file (e.g. in the child processes of a test runner which
+     *                   share the log file); false to start the log file afresh. Log files are written in append mode
+     *                   either way, so that processes sharing a log file do not overwrite each other's output.
+     * @throw std::runtime_error in case the destination cannot be opened
+     */
+    CAsyncLogSink(const std::string& destination, std::size_t capacity, EOverflowPolicy policy, bool append);
+
+    /**
+     * @brief Destructor. Writes all buffered output and stops the writer thread.
+     */
+    virtual ~CAsyncLogSink();
+
+    /**
+     * @brief Getter for the output stream writing into this buffer
+     */
+    std::ostream& GetStream()
+    {
+        return m_stream;
+    }
+
+    /**
+     * @brief Getter for the amount of bytes discarded so far (OverflowDrop only)
+     */
+    std::size_t GetDropped() const
+    {
+        return m_droppedTotal;
+    }
+
+    /**
+     * @brief Parses an overflow policy name ("block" or "drop")
+     *
+     * @param[in] name the policy name
+     * @param[out] policy the parsed policy
+     * @return true if the name is a valid policy name
+     */
+    static bool ParseOverflowPolicy(const std::string& name, EOverflowPolicy& policy);
+
+    /**
+     * @brief Writes whatever is buffered by the living instance (if any). Intended to be called from crash handlers.
+     * @note async-signal-safe
+     */
+    static void FlushOnCrash();
+
+protected:
+    // stream buffer interface
+    virtual int_type overflow(int_type c) override;
+    virtual std::streamsize xsputn(const char* s, std::streamsize n) override;
+
+private:
+    /**
+     * @brief Copies the provided characters into the ring buffer according to the overflow policy
+     */
+    void Push(const char* data, std::size_t size);
+
+    /**
+     * @brief Copies the provided characters into the ring buffer. The caller ensures that there is room.
+     */
+    void Copy(const char* data, std::size_t size);
+
+    /**
+     * @brief Writer thread procedure
+     */
+    void Drain();
+
+    /**
+     * @brief Writes the buffered output in range [tail, head) to the destination
+     * @note async-signal-safe
+     */
+    void WriteRange(std::size_t tail, std::size_t head);
+
+    std::vector<char> m_buffer;
+    std::size_t m_mask;
+    EOverflowPolicy m_policy;
+
+    int m_fd;
+
+    // Monotonic write (producer) and read (consumer) positions; the ring buffer index is the position & m_mask
+    std::atomic<std::size_t> m_head;
+    std::atomic<std::size_t> m_tail;
+
+    std::size_t m_dropped;
+    std::atomic<std::size_t> m_droppedTotal;
+
+    std::atomic<bool> m_stop;
+    std::thread m_writer;
+
+    std::ostream m_stream;
+
+    static std::atomic<CAsyncLogSink*> s_instance;
+};
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
+
+#endif // _CAsyncLogSink_H_
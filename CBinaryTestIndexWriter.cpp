@@ -0,0 +1,174 @@
+#include "CBinaryTestIndexWriter.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+//suppression of warnings related to 3rd party files
+#pragma warning ( disable: 6001 )
+#pragma warning ( disable: 6031 )
+
+#include <boost/test/tree/test_unit.hpp>
+
+//end suppression of warnings related to 3rd party files
+#pragma warning ( default: 6001 )
+#pragma warning ( default: 6031 )
+
+#include "TestUnitPath.h"
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+namespace
+{
+
+template <typename T>
+void WriteArray(std::ostream& out, const std::vector<T>& values)
+{
+    if (!values.empty())
+    {
+        out.write(reinterpret_cast<const char*>(&values[0]), values.size() * sizeof(T));
+    }
+}
+
+} // namespace anonymous
+
+CBinaryTestIndexWriter::CBinaryTestIndexWriter(const std::string& source)
+{
+    // Offset 0 is the empty string
+    AddString(std::string());
+    m_source = AddString(source);
+}
+
+CBinaryTestIndexWriter::~CBinaryTestIndexWriter()
+{
+}
+
+void CBinaryTestIndexWriter::visit(const ::boost::unit_test::test_case& testCase)
+{
+    AddUnit(testCase, BinaryTestIndexCase);
+}
+
+bool CBinaryTestIndexWriter::test_suite_start(const ::boost::unit_test::test_suite& testSuite)
+{
+    m_suites.push_back(AddUnit(testSuite, BinaryTestIndexSuite));
+    return true;
+}
+
+void CBinaryTestIndexWriter::test_suite_finish(const ::boost::unit_test::test_suite& /* testSuite */)
+{
+    m_suites.pop_back();
+}
+
+std::uint32_t CBinaryTestIndexWriter::AddUnit(const ::boost::unit_test::test_unit& testUnit, EBinaryTestIndexUnitType type)
+{
+    const std::string path = GetTestUnitPath(testUnit);
+
+    SBinaryTestIndexUnit unit;
+
+    unit.m_pathHash = HashTestUnitPath(path);
+    unit.m_id = static_cast<std::uint32_t>(testUnit.p_id);
+    unit.m_parent = m_suites.empty() ? c_binaryTestIndexNone : m_suites.back();
+    unit.m_name = AddString(testUnit.p_name.value);
+    unit.m_path = AddString(path);
+    unit.m_file = AddString(std::string(testUnit.p_file_name.begin(), testUnit.p_file_name.end()));
+    unit.m_line = static_cast<std::uint32_t>(testUnit.p_line_num);
+    unit.m_type = type;
+    // The run status is only assigned once tests are executed; the default run status is settled by finalize_setup_phase
+    unit.m_enabled = (testUnit.p_default_status == ::boost::unit_test::test_unit::RS_ENABLED) ? 1 : 0;
+
+    m_units.push_back(unit);
+
+    return static_cast<std::uint32_t>(m_units.size() - 1);
+}
+
+std::uint32_t CBinaryTestIndexWriter::AddString(const std::string& value)
+{
+    auto existing = m_stringOffsets.find(value);
+
+    if (existing != m_stringOffsets.end())
+    {
+        return existing->second;
+    }
+
+    const std::uint32_t offset = static_cast<std::uint32_t>(m_strings.size());
+
+    m_strings.append(value).push_back('\0');
+    m_stringOffsets.insert(std::make_pair(value, offset));
+
+    return offset;
+}
+
+std::ostream& CBinaryTestIndexWriter::Write(std::ostream& out) const
+{
+    const std::uint32_t count = static_cast<std::uint32_t>(m_units.size());
+
+    // Keep the load factor at or below 1/2 so that probe sequences stay short
+    std::uint32_t buckets = 1;
+
+    while (buckets <= (2 * count))
+    {
+        buckets <<= 1;
+    }
+
+    std::vector<std::uint32_t> pathBuckets(buckets, c_binaryTestIndexNone);
+    std::vector<std::uint32_t> idBuckets(buckets, c_binaryTestIndexNone);
+
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        std::uint32_t bucket = static_cast<std::uint32_t>(m_units[i].m_pathHash & (buckets - 1));
+
+        while (pathBuckets[bucket] != c_binaryTestIndexNone)
+        {
+            bucket = (bucket + 1) & (buckets - 1);
+        }
+
+        pathBuckets[bucket] = i;
+
+        bucket = GetBinaryTestIndexIdBucket(m_units[i].m_id, buckets);
+
+        while (idBuckets[bucket] != c_binaryTestIndexNone)
+        {
+            bucket = (bucket + 1) & (buckets - 1);
+        }
+
+        idBuckets[bucket] = i;
+    }
+
+    const std::uint64_t size = sizeof(SBinaryTestIndexHeader) + std::uint64_t(count) * sizeof(SBinaryTestIndexUnit) +
+                               2 * std::uint64_t(buckets) * sizeof(std::uint32_t) + m_strings.size();
+
+    // Offsets are 32-bit
+    if (size > c_binaryTestIndexNone)
+    {
+        throw std::runtime_error("Binary test index exceeds 4 GiB");
+    }
+
+    SBinaryTestIndexHeader header;
+
+    std::copy(c_binaryTestIndexMagic, c_binaryTestIndexMagic + sizeof(c_binaryTestIndexMagic), header.m_magic);
+    header.m_version = c_binaryTestIndexVersion;
+    header.m_unitCount = count;
+    header.m_bucketCount = buckets;
+    header.m_unitsOffset = sizeof(SBinaryTestIndexHeader);
+    header.m_pathBucketsOffset = header.m_unitsOffset + count * sizeof(SBinaryTestIndexUnit);
+    header.m_idBucketsOffset = header.m_pathBucketsOffset + buckets * sizeof(std::uint32_t);
+    header.m_stringsOffset = header.m_idBucketsOffset + buckets * sizeof(std::uint32_t);
+    header.m_stringsSize = static_cast<std::uint32_t>(m_strings.size());
+    header.m_source = m_source;
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    WriteArray(out, m_units);
+    WriteArray(out, pathBuckets);
+    WriteArray(out, idBuckets);
+    out.write(m_strings.data(), m_strings.size());
+
+    return out;
+}
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
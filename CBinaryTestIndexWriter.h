@@ -0,0 +1,98 @@
+#if !defined( _CBinaryTestIndexWriter_H_ )
+#define _CBinaryTestIndexWriter_H_
+
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+#include <boost/test/tree/visitor.hpp>
+
+#include "BinaryTestIndex.h"
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+/**
+ * @brief Boost test_tree_visitor implementation which traverses the test tree and
+ *        generates a binary test index (refer to BinaryTestIndex.h for the layout)
+ *
+ * The enabled state of a test unit is its default run status, hence the test tree is to be traversed once the
+ * Boost UTF framework has finalized the setup phase (i.e. applied decorators such as disabled).
+ */
+class CBinaryTestIndexWriter :
+    public ::boost::unit_test::test_tree_visitor,
+    private ::boost::noncopyable
+{
+public:
+    typedef ::boost::unit_test::test_tree_visitor TBase;
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] source file-path to the exe/dll module which contains a Boost test framework
+     */
+    explicit CBinaryTestIndexWriter(const std::string& source);
+
+    /**
+     * @brief Destructor
+     */
+    virtual ~CBinaryTestIndexWriter();
+
+    // test tree visitor interface
+
+    /**
+     * @brief Visitor method for a Boost test case. Records the test case.
+     */
+    virtual void visit(const ::boost::unit_test::test_case& testCase) override;
+
+    /**
+     * @brief Visitor method for the start of a Boost test suite. Records the test suite.
+     */
+    virtual bool test_suite_start(const ::boost::unit_test::test_suite& testSuite) override;
+
+    /**
+     * @brief Visitor method for the end of a Boost test suite.
+     */
+    virtual void test_suite_finish(const ::boost::unit_test::test_suite& testSuite) override;
+
+    /**
+     * @brief Writes the index of the test units visited so far
+     *
+     * @param[in] out the (binary) output stream to write to
+     * @return the output stream which we are writing to
+     */
+    std::ostream& Write(std::ostream& out) const;
+
+private:
+    /**
+     * @brief Records a test unit as a child of the innermost test suite being visited
+     * @return the record index of the test unit
+     */
+    std::uint32_t AddUnit(const ::boost::unit_test::test_unit& testUnit, EBinaryTestIndexUnitType type);
+
+    /**
+     * @brief Adds a string to the string table. Identical strings (e.g. source files) are stored once.
+     * @return the string offset
+     */
+    std::uint32_t AddString(const std::string& value);
+
+    std::uint32_t m_source;
+
+    std::vector<SBinaryTestIndexUnit> m_units;
+    std::vector<std::uint32_t> m_suites;
+
+    std::string m_strings;
+    std::unordered_map<std::string, std::uint32_t> m_stringOffsets;
+};
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
+
+#endif // _CBinaryTestIndexWriter_H_
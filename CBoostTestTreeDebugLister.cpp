@@ -229,7 +229,10 @@ SSourceInfo GetSourceInfo(const SSearchRequest& request)
 CBoostTestTreeDebugLister::CBoostTestTreeDebugLister(const std::string& source) :
     TBase(source),
     m_handle(NULL),
-    m_dllBase(-1)
+    m_dllBase(-1),
+    m_fileDictionary(false),
+    m_locationLine(0),
+    m_locationFileIndex(0)
 {
     Init();
 }
@@ -237,7 +240,10 @@ CBoostTestTreeDebugLister::CBoostTestTreeDebugLister(const std::string& source)
 CBoostTestTreeDebugLister::CBoostTestTreeDebugLister(const std::string& source, std::ostream* out) :
     TBase(source, out),
     m_handle(NULL),
-    m_dllBase(0)
+    m_dllBase(0),
+    m_fileDictionary(false),
+    m_locationLine(0),
+    m_locationFileIndex(0)
 {
     Init();
 }
@@ -271,26 +277,56 @@ void CBoostTestTreeDebugLister::Init()
     }
 }
 
-void CBoostTestTreeDebugLister::visit(const ::boost::unit_test::test_case& testCase)
+void CBoostTestTreeDebugLister::PrepareSourceLocation(const ::boost::unit_test::test_case& testCase)
 {
     SSourceInfo info = GetSourceInfo(SSearchRequest(m_handle, m_dllBase, m_suites, testCase));
 
-    Tab() << "<TestCase"
-          " id" << attr_value() << testCase.p_id <<
-          " name" << attr_value() << testCase.p_name.value;
-
     // Avoid listing source information for unkown sources
-    if (info.m_file != SSourceInfo::c_unkownLocation)
+    const bool known = (info.m_file != SSourceInfo::c_unkownLocation);
+
+    m_locationFile = known ? info.m_file : std::string();
+    m_locationLine = info.m_lineNumber;
+    m_locationFileIndex = 0;
+
+    if (known && m_fileDictionary)
     {
-        Out() << " file" << attr_value() << info.m_file <<
-              " line" << attr_value() << info.m_lineNumber;
+        auto file = m_files.find(info.m_file);
+
+        if (file == m_files.end())
+        {
+            // Introduce the file-path before it is first referred to so that the document can be read in a single pass
+            file = m_files.insert(std::make_pair(info.m_file, m_files.size())).first;
+
+            Tab() << "<File"
+                  " index" << attr_value() << file->second <<
+                  " path" << attr_value() << file->first << " />";
+
+            if (GetPrettyPrint())
+            {
+                Out() << std::endl;
+            }
+        }
+
+        m_locationFileIndex = file->second;
     }
+}
 
-    Out() << " />";
+void CBoostTestTreeDebugLister::WriteSourceLocation()
+{
+    if (m_locationFile.empty())
+    {
+        return;
+    }
 
-    if (GetPrettyPrint())
+    if (m_fileDictionary)
     {
-        Out() << std::endl;
+        Out() << " fileIndex" << attr_value() << m_locationFileIndex <<
+              " line" << attr_value() << m_locationLine;
+    }
+    else
+    {
+        Out() << " file" << attr_value() << m_locationFile <<
+              " line" << attr_value() << m_locationLine;
     }
 }
 
@@ -301,6 +337,9 @@ bool CBoostTestTreeDebugLister::IsMasterTestSuite(const ::boost::unit_test::test
 
 bool CBoostTestTreeDebugLister::test_suite_start(const ::boost::unit_test::test_suite& testSuite)
 {
+    // Source locations of pending test cases are looked up against the current test suite stack
+    FlushFamily();
+
     // Skip the master test suite
     if (!IsMasterTestSuite(testSuite))
     {
@@ -312,6 +351,8 @@ bool CBoostTestTreeDebugLister::test_suite_start(const ::boost::unit_test::test_
 
 void CBoostTestTreeDebugLister::test_suite_finish(const ::boost::unit_test::test_suite& testSuite)
 {
+    FlushFamily();
+
     if (!IsMasterTestSuite(testSuite))
     {
         m_suites.pop_back();
@@ -1,6 +1,7 @@
 #if !defined( _CBoostTestTreeDebugLister_H_ )
 #define _CBoostTestTreeDebugLister_H_
 
+#include <map>
 #include <vector>
 
 #define WIN32_LEAN_AND_MEAN
@@ -41,10 +42,29 @@ public:
     virtual ~CBoostTestTreeDebugLister();
 
     // test tree visitor interface
-    virtual void visit(const ::boost::unit_test::test_case& testCase) override;
     virtual bool test_suite_start(const ::boost::unit_test::test_suite& testSuite) override;
     virtual void test_suite_finish(const ::boost::unit_test::test_suite& testSuite) override;
 
+    /**
+     * @brief States whether or not source file-paths are written via a file dictionary
+     */
+    bool GetFileDictionary() const
+    {
+        return m_fileDictionary;
+    }
+
+    /**
+     * @brief Sets whether or not source file-paths are written via a file dictionary. When enabled, each distinct
+     *        file-path is written once as a File element (preceding the first test case declared in it) and test
+     *        cases refer to it by its index rather than repeating the file-path.
+     *
+     * @param[in] fileDictionary true to enable the file dictionary; false to write file-paths on each test case
+     */
+    void SetFileDictionary(bool fileDictionary)
+    {
+        m_fileDictionary = fileDictionary;
+    }
+
     /**
      * @brief States whether or not debug information is available for the requested source module
      */
@@ -53,6 +73,18 @@ public:
         return m_dllBase > 0;
     };
 
+protected:
+    /**
+     * @brief Looks up the source location of a test case via the debug information of the source module and
+     *        introduces its file-path in case the file dictionary is enabled
+     */
+    virtual void PrepareSourceLocation(const ::boost::unit_test::test_case& testCase) override;
+
+    /**
+     * @brief Writes the file (or file index) and line attributes of the source location prepared last, if known
+     */
+    virtual void WriteSourceLocation() override;
+
 private:
     /**
      * @brief Common initialisation logic shared between constructors
@@ -72,6 +104,13 @@ private:
 
     typedef const ::boost::unit_test::test_suite* TConstTestSuitePtr;
     std::vector<TConstTestSuitePtr> m_suites;
+
+    bool m_fileDictionary;
+    std::map<std::string, std::size_t> m_files;
+
+    std::string m_locationFile;             ///< file-path of the source location prepared last; empty if unknown
+    unsigned long m_locationLine;
+    std::size_t m_locationFileIndex;
 };
 
 } // namespace unit_test
@@ -6,6 +6,7 @@
 #pragma warning ( disable: 6001 )
 #pragma warning ( disable: 6031 )
 
+#include <boost/test/tree/test_unit.hpp>
 #include <boost/test/utils/xml_printer.hpp>
 
 //end suppression of warnings related to 3rd party files
@@ -27,6 +28,26 @@ std::ostream& noop(std::ostream& out)
     return ::boost::unit_test::attr_value();
 };
 
+// States whether a test case name is the one generated for the data sample with the provided index
+bool IsDataTestCaseName(const std::string& name, std::size_t index)
+{
+    return name == ("_" + std::to_string(index));
+}
+
+// Getter for the name of the test case template a test case has been generated from (e.g. "name" for "name<int>");
+// an empty string in case the test case has not been generated from a template
+std::string GetTemplateName(const std::string& name)
+{
+    const std::string::size_type open = name.find('<');
+
+    if ((open == std::string::npos) || (open == 0) || (name[name.length() - 1] != '>'))
+    {
+        return std::string();
+    }
+
+    return name.substr(0, open);
+}
+
 } // namespace anonymous
 
 namespace etas
@@ -42,7 +63,9 @@ CBoostTestTreeLister::CBoostTestTreeLister(const std::string& source) :
     m_out(&std::cout),
     m_source(source),
     m_level(0),
-    m_prettyPrint(true)
+    m_prettyPrint(true),
+    m_expandFamilies(false),
+    m_familyKind(FamilyNone)
 {
     WriteHeader();
 }
@@ -51,7 +74,9 @@ CBoostTestTreeLister::CBoostTestTreeLister(const std::string& source, std::ostre
     m_out(out),
     m_source(source),
     m_level(0),
-    m_prettyPrint(true)
+    m_prettyPrint(true),
+    m_expandFamilies(false),
+    m_familyKind(FamilyNone)
 {
 }
 
@@ -61,11 +86,21 @@ CBoostTestTreeLister::~CBoostTestTreeLister()
 
 void CBoostTestTreeLister::visit(const ::boost::unit_test::test_case& testCase)
 {
-    Tab() << "<TestCase id" << attr_value() << testCase.p_id << " name" << attr_value() << testCase.p_name.value << " />" << ENDLINE;
+    EFamilyKind kind = FamilyNone;
+
+    if (!ContinuesFamily(testCase, kind))
+    {
+        FlushFamily();
+    }
+
+    m_family.push_back(&testCase);
+    m_familyKind = kind;
 }
 
 bool CBoostTestTreeLister::test_suite_start(const ::boost::unit_test::test_suite& testSuite)
 {
+    FlushFamily();
+
     Tab() << "<TestSuite id" << attr_value() << testSuite.p_id << " name" << attr_value() << testSuite.p_name.value << '>' << ENDLINE;
     ++m_level;
 
@@ -74,6 +109,8 @@ bool CBoostTestTreeLister::test_suite_start(const ::boost::unit_test::test_suite
 
 void CBoostTestTreeLister::test_suite_finish(const ::boost::unit_test::test_suite& testSuite)
 {
+    FlushFamily();
+
     m_level = (m_level == 0) ? 0 : (m_level - 1);
     Tab() << "</TestSuite>" << ENDLINE;
 }
@@ -90,11 +127,122 @@ std::ostream& CBoostTestTreeLister::WriteHeader()
 
 std::ostream& CBoostTestTreeLister::WriteTrailer()
 {
+    FlushFamily();
+
     --m_level;
 
     return Out() << "</BoostTestFramework>" << ENDLINE;
 }
 
+void CBoostTestTreeLister::FlushFamily()
+{
+    if (m_family.empty())
+    {
+        return;
+    }
+
+    // The members of a family share their source location
+    PrepareSourceLocation(*m_family.front());
+
+    if ((m_familyKind == FamilyNone) || m_expandFamilies)
+    {
+        for (auto i = m_family.begin(), end = m_family.end(); i != end; ++i)
+        {
+            WriteTestCase(**i);
+        }
+    }
+    else
+    {
+        const ::boost::unit_test::test_case& first = *m_family.front();
+
+        Tab() << "<TestCaseFamily kind" << attr_value() << ((m_familyKind == FamilyData) ? "data" : "template");
+
+        if (m_familyKind == FamilyTemplate)
+        {
+            Out() << " name" << attr_value() << GetTemplateName(first.p_name.value);
+        }
+
+        Out() << " firstId" << attr_value() << first.p_id <<
+                 " lastId" << attr_value() << m_family.back()->p_id <<
+                 " size" << attr_value() << m_family.size();
+
+        WriteSourceLocation();
+
+        if (m_familyKind == FamilyData)
+        {
+            // The names of the members are implied by their position, i.e. "_0", "_1", ...
+            Out() << " />" << ENDLINE;
+        }
+        else
+        {
+            Out() << '>' << ENDLINE;
+            ++m_level;
+
+            for (auto i = m_family.begin(), end = m_family.end(); i != end; ++i)
+            {
+                Tab() << "<Instance name" << attr_value() << (*i)->p_name.value << " />" << ENDLINE;
+            }
+
+            --m_level;
+            Tab() << "</TestCaseFamily>" << ENDLINE;
+        }
+    }
+
+    m_family.clear();
+    m_familyKind = FamilyNone;
+}
+
+void CBoostTestTreeLister::PrepareSourceLocation(const ::boost::unit_test::test_case&)
+{
+}
+
+void CBoostTestTreeLister::WriteSourceLocation()
+{
+}
+
+bool CBoostTestTreeLister::ContinuesFamily(const ::boost::unit_test::test_case& testCase, EFamilyKind& kind) const
+{
+    if (m_family.empty())
+    {
+        return false;
+    }
+
+    const ::boost::unit_test::test_case& last = *m_family.back();
+
+    // Generated test cases are registered one after another from the same source location
+    if ((testCase.p_parent_id != last.p_parent_id) || (testCase.p_id != (last.p_id + 1)) ||
+        (testCase.p_file_name != last.p_file_name) || (testCase.p_line_num != last.p_line_num))
+    {
+        return false;
+    }
+
+    if ((m_familyKind != FamilyTemplate) && IsDataTestCaseName(testCase.p_name.value, m_family.size()) &&
+        ((m_familyKind == FamilyData) || IsDataTestCaseName(m_family.front()->p_name.value, 0)))
+    {
+        kind = FamilyData;
+        return true;
+    }
+
+    const std::string name = GetTemplateName(testCase.p_name.value);
+
+    if ((m_familyKind != FamilyData) && !name.empty() && (name == GetTemplateName(last.p_name.value)))
+    {
+        kind = FamilyTemplate;
+        return true;
+    }
+
+    return false;
+}
+
+void CBoostTestTreeLister::WriteTestCase(const ::boost::unit_test::test_case& testCase)
+{
+    Tab() << "<TestCase id" << attr_value() << testCase.p_id << " name" << attr_value() << testCase.p_name.value;
+
+    WriteSourceLocation();
+
+    Out() << " />" << ENDLINE;
+}
+
 std::ostream& CBoostTestTreeLister::Tab()
 {
     if (m_prettyPrint)
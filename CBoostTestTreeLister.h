@@ -3,6 +3,7 @@
 
 #include <ostream>
 #include <string>
+#include <vector>
 
 #include <boost/noncopyable.hpp>
 #include <boost/test/tree/visitor.hpp>
@@ -17,6 +18,11 @@ namespace unit_test
 /**
  * @brief Boost test_tree_visitor implementation which traverses the test tree and 
  * 		  generates an xml file of available tests
+ *
+ * Families of generated test cases (the test cases of a BOOST_DATA_TEST_CASE or of a test case template) are
+ * detected during traversal: sibling test cases with consecutive ids declared at the same source location and named
+ * "_0", "_1", ... (data test cases) or "name<...>" (test case templates). Unless expanded, a family is written as a
+ * single TestCaseFamily element carrying the id range, the size and the shared source location of the family.
  */
 class CBoostTestTreeLister :
     public ::boost::unit_test::test_tree_visitor,
@@ -66,6 +72,27 @@ public:
         m_prettyPrint = prettyPrint;
     }
 
+    /**
+     * @brief States whether or not families of generated test cases are written as individual test cases
+     */
+    bool GetExpandFamilies() const
+    {
+        return m_expandFamilies;
+    }
+
+    /**
+     * @brief Sets whether or not families of generated test cases are written as individual test cases. When disabled (default),
+     *        each family is written as a single TestCaseFamily element, e.g.
+     *        <c>&lt;TestCaseFamily kind="data" firstId="65538" lastId="75537" size="10000" /&gt;</c> for test cases "_0" to "_9999".
+     *        Source locations are looked up once per family in either case.
+     *
+     * @param[in] expandFamilies true to write the test cases of families individually; false to write families compactly
+     */
+    void SetExpandFamilies(bool expandFamilies)
+    {
+        m_expandFamilies = expandFamilies;
+    }
+
     /**
      * @brief Destructor
      */
@@ -74,7 +101,7 @@ public:
     // test tree visitor interface
     
     /**
-     * @brief Visitor method for a Boost test case. Describes the test is an xml element.
+     * @brief Visitor method for a Boost test case. Describes the test is an xml element, possibly as part of a family of test cases.
      */
     virtual void visit(const ::boost::unit_test::test_case& testCase) override;
     
@@ -101,6 +128,22 @@ public:
     std::ostream& WriteTrailer();
 
 protected:
+    /**
+     * @brief Writes the pending family of test cases (if any). Needs to be called before the test suite stack changes.
+     */
+    void FlushFamily();
+
+    /**
+     * @brief Looks up the source location of a test case ahead of writing its element (or the elements of its family).
+     *        Does nothing by default.
+     */
+    virtual void PrepareSourceLocation(const ::boost::unit_test::test_case& testCase);
+
+    /**
+     * @brief Writes the attributes of the source location prepared last. Writes nothing by default.
+     */
+    virtual void WriteSourceLocation();
+
     /**
      * @brief Properly sets up tabulation characters if pretty-printing is enabled
      * @return the output stream which we are writing to
@@ -114,12 +157,36 @@ protected:
     std::ostream& Out();
 
 private:
+    /**
+     * @brief Kinds of families of generated test cases
+     */
+    enum EFamilyKind
+    {
+        FamilyNone,                         ///< less than two test cases pending
+        FamilyData,                         ///< test cases of a BOOST_DATA_TEST_CASE: "_0", "_1", ...
+        FamilyTemplate                      ///< test cases of a test case template: "name<T1>", "name<T2>", ...
+    };
+
+    /**
+     * @brief States whether the provided test case continues the pending family of test cases
+     */
+    bool ContinuesFamily(const ::boost::unit_test::test_case& testCase, EFamilyKind& kind) const;
+
+    /**
+     * @brief Writes a test case as an individual xml element
+     */
+    void WriteTestCase(const ::boost::unit_test::test_case& testCase);
+
     std::ostream* m_out;
 
     std::string m_source;
 
     std::size_t m_level;
     bool m_prettyPrint;
+
+    bool m_expandFamilies;
+    EFamilyKind m_familyKind;
+    std::vector<const ::boost::unit_test::test_case*> m_family;
 };
 
 } // namespace unit_test
@@ -0,0 +1,850 @@
+#include "CChildProcess.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32) // WIN32 API
+
+#define _NO_CVCONST_H
+#include <DbgHelp.h>
+
+#else // POSIX API
+
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+
+#include <dirent.h>
+#include <execinfo.h>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#endif
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+const unsigned long CChildProcess::c_infinite = static_cast<unsigned long>(-1);
+
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32) // WIN32 API
+
+namespace
+{
+
+/**
+ * @brief Quotes a command line argument according to the rules of CommandLineToArgvW
+ */
+std::string QuoteArgument(const std::string& arg)
+{
+    if (!arg.empty() && (arg.find_first_of(" \t\n\v\"") == std::string::npos))
+    {
+        return arg;
+    }
+
+    std::string quoted(1, '"');
+
+    for (std::string::const_iterator i = arg.begin(), end = arg.end(); ; ++i)
+    {
+        std::size_t backslashes = 0;
+
+        for (; (i != end) && (*i == '\\'); ++i)
+        {
+            ++backslashes;
+        }
+
+        if (i == end)
+        {
+            quoted.append(backslashes * 2, '\\');
+            break;
+        }
+        else if (*i == '"')
+        {
+            quoted.append((backslashes * 2) + 1, '\\');
+        }
+        else
+        {
+            quoted.append(backslashes, '\\');
+        }
+
+        quoted.push_back(*i);
+    }
+
+    quoted.push_back('"');
+
+    return quoted;
+}
+
+} // namespace anonymous
+
+CChildProcess::CChildProcess() :
+    m_running(false),
+    m_exitedNormally(false),
+    m_exitCode(0),
+    m_process(NULL),
+    m_job(NULL),
+    m_pid(0)
+{
+}
+
+CChildProcess::~CChildProcess()
+{
+    Terminate();
+
+    if (m_job != NULL)
+    {
+        CloseHandle(m_job);
+    }
+
+    if (m_process != NULL)
+    {
+        CloseHandle(m_process);
+    }
+}
+
+void CChildProcess::Start(const std::string& executable, const TArguments& args)
+{
+    std::string commandLine = QuoteArgument(executable);
+
+    for (auto i = args.begin(), end = args.end(); i != end; ++i)
+    {
+        commandLine.append(1, ' ').append(QuoteArgument(*i));
+    }
+
+    // The job object ensures that processes spawned by the child are terminated along with it
+    m_job = CreateJobObject(NULL, NULL);
+
+    if (m_job != NULL)
+    {
+        JOBOBJECT_EXTENDED_LIMIT_INFORMATION limits = {};
+        limits.BasicLimitInformation.LimitFlags = JOB_OBJECT_LIMIT_KILL_ON_JOB_CLOSE;
+
+        if (m_limits.m_memory > 0)
+        {
+            limits.BasicLimitInformation.LimitFlags |= JOB_OBJECT_LIMIT_PROCESS_MEMORY;
+            limits.ProcessMemoryLimit = static_cast<SIZE_T>(m_limits.m_memory);
+        }
+
+        if (m_limits.m_cpuTime > 0)
+        {
+            limits.BasicLimitInformation.LimitFlags |= JOB_OBJECT_LIMIT_PROCESS_TIME;
+            limits.BasicLimitInformation.PerProcessUserTimeLimit.QuadPart = static_cast<LONGLONG>(m_limits.m_cpuTime) * 10000000;
+        }
+
+        if (m_limits.m_processes > 0)
+        {
+            limits.BasicLimitInformation.LimitFlags |= JOB_OBJECT_LIMIT_ACTIVE_PROCESS;
+            limits.BasicLimitInformation.ActiveProcessLimit = static_cast<DWORD>(m_limits.m_processes);
+        }
+
+        SetInformationJobObject(m_job, JobObjectExtendedLimitInformation, &limits, sizeof(limits));
+    }
+
+    STARTUPINFO startupInfo = {};
+    startupInfo.cb = sizeof(startupInfo);
+
+    PROCESS_INFORMATION processInfo = {};
+
+    std::vector<char> buffer(commandLine.begin(), commandLine.end());
+    buffer.push_back('\0');
+
+    if (!CreateProcess(executable.c_str(), &buffer[0], NULL, NULL, TRUE, CREATE_SUSPENDED, NULL, NULL, &startupInfo, &processInfo))
+    {
+        std::ostringstream error;
+        error << "Failed to start " << executable << " (error " << GetLastError() << ')';
+        throw std::runtime_error(error.str());
+    }
+
+    if (m_job != NULL)
+    {
+        AssignProcessToJobObject(m_job, processInfo.hProcess);
+    }
+
+    ResumeThread(processInfo.hThread);
+    CloseHandle(processInfo.hThread);
+
+    m_process = processInfo.hProcess;
+    m_pid = processInfo.dwProcessId;
+    m_running = true;
+}
+
+bool CChildProcess::Wait(unsigned long timeout)
+{
+    if (!m_running)
+    {
+        return true;
+    }
+
+    if (m_limits.IsEmpty())
+    {
+        if (WaitForSingleObject(m_process, (timeout == c_infinite) ? INFINITE : timeout) != WAIT_OBJECT_0)
+        {
+            return false;
+        }
+    }
+    else
+    {
+        // Sample the resource usage while waiting
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        for (;;)
+        {
+            SampleResourceUsage();
+
+            const unsigned long long elapsed = static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+
+            if ((timeout != c_infinite) && (elapsed >= timeout))
+            {
+                return false;
+            }
+
+            const DWORD slice = (timeout == c_infinite) ? 100 : static_cast<DWORD>(std::min<unsigned long long>(100, timeout - elapsed));
+
+            if (WaitForSingleObject(m_process, slice) == WAIT_OBJECT_0)
+            {
+                break;
+            }
+        }
+
+        // Job accounting remains available once the process has exited
+        SampleResourceUsage();
+    }
+
+    DWORD exitCode = 0;
+    GetExitCodeProcess(m_process, &exitCode);
+
+    m_running = false;
+    m_exitCode = static_cast<int>(exitCode);
+
+    // NTSTATUS error codes (e.g. 0xC0000005 access violation) signify abnormal termination
+    m_exitedNormally = ((exitCode & 0xC0000000) != 0xC0000000);
+
+    return true;
+}
+
+void CChildProcess::Terminate()
+{
+    if (!m_running)
+    {
+        return;
+    }
+
+    if (m_job != NULL)
+    {
+        TerminateJobObject(m_job, static_cast<UINT>(-1));
+    }
+    else
+    {
+        TerminateProcess(m_process, static_cast<UINT>(-1));
+    }
+
+    WaitForSingleObject(m_process, INFINITE);
+
+    m_running = false;
+    m_exitedNormally = false;
+    m_exitCode = -1;
+}
+
+bool CChildProcess::WriteSnapshot(const std::string& file)
+{
+    if (!m_running)
+    {
+        return false;
+    }
+
+    HANDLE dump = CreateFile(file.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+
+    if (dump == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    BOOL written = MiniDumpWriteDump(m_process, m_pid, dump, MiniDumpWithThreadInfo, NULL, NULL, NULL);
+    CloseHandle(dump);
+
+    return (written != FALSE);
+}
+
+void CChildProcess::InstallSnapshotHandler(const std::string&)
+{
+    // Snapshots are written by the parent process via MiniDumpWriteDump
+}
+
+std::string CChildProcess::GetCurrentExecutable(const std::string& fallback)
+{
+    char path[MAX_PATH] = {};
+    DWORD length = GetModuleFileName(NULL, path, MAX_PATH);
+
+    return ((length > 0) && (length < MAX_PATH)) ? std::string(path, length) : fallback;
+}
+
+CChildProcess::TNativeHandle CChildProcess::GetNativeHandle() const
+{
+    return m_process;
+}
+
+void CChildProcess::SampleResourceUsage()
+{
+    if (m_job != NULL)
+    {
+        JOBOBJECT_EXTENDED_LIMIT_INFORMATION limits = {};
+
+        if (QueryInformationJobObject(m_job, JobObjectExtendedLimitInformation, &limits, sizeof(limits), NULL))
+        {
+            m_usage.m_peakMemory = std::max<std::uint64_t>(m_usage.m_peakMemory, limits.PeakProcessMemoryUsed);
+        }
+
+        JOBOBJECT_BASIC_ACCOUNTING_INFORMATION accounting = {};
+
+        if (QueryInformationJobObject(m_job, JobObjectBasicAccountingInformation, &accounting, sizeof(accounting), NULL))
+        {
+            m_usage.m_cpuTime = static_cast<std::uint64_t>(accounting.TotalUserTime.QuadPart + accounting.TotalKernelTime.QuadPart) / 10;
+            m_usage.m_peakProcesses = std::max<unsigned long>(m_usage.m_peakProcesses, accounting.ActiveProcesses);
+        }
+    }
+
+    DWORD handles = 0;
+
+    if ((m_process != NULL) && GetProcessHandleCount(m_process, &handles))
+    {
+        m_usage.m_peakOpenFiles = std::max<unsigned long>(m_usage.m_peakOpenFiles, handles);
+    }
+}
+
+#else // POSIX API
+
+namespace
+{
+
+int s_snapshotFile = -1;
+
+extern "C" void SnapshotSignalHandler(int)
+{
+    // Only async-signal-safe calls in here. backtrace is not strictly safe on its first invocation
+    // hence it is primed when the handler is installed.
+    if (s_snapshotFile >= 0)
+    {
+        void* frames[128];
+        int count = backtrace(frames, 128);
+        backtrace_symbols_fd(frames, count, s_snapshotFile);
+        fsync(s_snapshotFile);
+    }
+}
+
+/**
+ * @brief Interval, in milliseconds, between samples of the resource usage of a child process
+ */
+const long c_sampleInterval = 100;
+
+std::string ReadLine(const std::string& file)
+{
+    std::ifstream in(file);
+    std::string line;
+    std::getline(in, line);
+
+    return line;
+}
+
+bool WriteValue(const std::string& file, const std::string& value)
+{
+    std::ofstream out(file);
+    out << value;
+
+    return static_cast<bool>(out.flush());
+}
+
+/**
+ * @brief Reads a value of a flat keyed cgroup file (e.g. "oom_kill 1" of memory.events)
+ */
+unsigned long long ReadKeyedValue(const std::string& file, const std::string& key)
+{
+    std::ifstream in(file);
+    std::string name;
+    unsigned long long value = 0;
+
+    while (in >> name >> value)
+    {
+        if (name == key)
+        {
+            return value;
+        }
+    }
+
+    return 0;
+}
+
+#if defined(__linux__)
+/**
+ * @brief Determines the cgroup v2 directory of the current process; empty in case cgroup v2 is not mounted
+ */
+std::string GetOwnControlGroup()
+{
+    // The mount point of the unified hierarchy: <id> <parent> <major:minor> <root> <mount point> ... - cgroup2 ...
+    std::ifstream mounts("/proc/self/mountinfo");
+    std::string mount;
+    std::string mountPoint;
+
+    while (std::getline(mounts, mount))
+    {
+        if (mount.find(" - cgroup2 ") != std::string::npos)
+        {
+            std::istringstream fields(mount);
+            std::string field;
+
+            for (int i = 0; (i < 5) && (fields >> field); ++i)
+            {
+                mountPoint = field;
+            }
+
+            break;
+        }
+    }
+
+    if (mountPoint.empty())
+    {
+        return std::string();
+    }
+
+    // The unified hierarchy is listed as "0::<path>"
+    std::ifstream groups("/proc/self/cgroup");
+    std::string group;
+
+    while (std::getline(groups, group))
+    {
+        if (group.compare(0, 3, "0::") == 0)
+        {
+            return mountPoint + ((group.length() > 4) ? group.substr(3) : std::string());
+        }
+    }
+
+    return std::string();
+}
+
+/**
+ * @brief Creates a cgroup v2 group enforcing the memory and process limits; empty in case no group could be created
+ */
+std::string CreateControlGroup(const SResourceLimits& limits, const std::string& root)
+{
+    static unsigned long s_count = 0;
+
+    if ((limits.m_memory == 0) && (limits.m_processes == 0))
+    {
+        return std::string();
+    }
+
+    const std::string parent = root.empty() ? GetOwnControlGroup() : root;
+
+    if (parent.empty())
+    {
+        return std::string();
+    }
+
+    // Delegate the controllers to the groups below the parent. This fails for a parent which contains processes
+    // (other than the root group), in which case the controllers need to have been delegated beforehand.
+    WriteValue(parent + "/cgroup.subtree_control", std::string(limits.m_memory > 0 ? "+memory " : "") + (limits.m_processes > 0 ? "+pids" : ""));
+
+    std::ostringstream path;
+    path << parent << "/betr-" << getpid() << '-' << s_count++;
+
+    if (mkdir(path.str().c_str(), 0755) != 0)
+    {
+        return std::string();
+    }
+
+    bool applied = true;
+
+    if (limits.m_memory > 0)
+    {
+        applied = WriteValue(path.str() + "/memory.max", std::to_string(limits.m_memory));
+
+        // Keep the worker from pushing the machine into swap; not available on all systems
+        WriteValue(path.str() + "/memory.swap.max", "0");
+    }
+
+    if (applied && (limits.m_processes > 0))
+    {
+        applied = WriteValue(path.str() + "/pids.max", std::to_string(limits.m_processes));
+    }
+
+    if (!applied)
+    {
+        rmdir(path.str().c_str());
+        return std::string();
+    }
+
+    return path.str();
+}
+#endif
+
+/**
+ * @brief Kills the processes of a cgroup created by CreateControlGroup and removes the cgroup
+ */
+void RemoveControlGroup(const std::string& path)
+{
+    WriteValue(path + "/cgroup.kill", "1");
+
+    // The kill is asynchronous and the cgroup cannot be removed (EBUSY) as long as it is populated
+    const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+
+    while ((ReadKeyedValue(path + "/cgroup.events", "populated") != 0) && (std::chrono::steady_clock::now() < deadline))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    rmdir(path.c_str());
+}
+
+/**
+ * @brief Counts the entries of a directory (excluding '.' and '..')
+ */
+unsigned long CountEntries(const std::string& directory)
+{
+    unsigned long count = 0;
+
+    if (DIR* entries = opendir(directory.c_str()))
+    {
+        while (dirent* entry = readdir(entries))
+        {
+            count += (entry->d_name[0] != '.') ? 1 : 0;
+        }
+
+        closedir(entries);
+    }
+
+    return count;
+}
+
+} // namespace anonymous
+
+CChildProcess::CChildProcess() :
+    m_running(false),
+    m_exitedNormally(false),
+    m_exitCode(0),
+    m_pid(0)
+{
+}
+
+CChildProcess::~CChildProcess()
+{
+    Terminate();
+}
+
+void CChildProcess::Start(const std::string& executable, const TArguments& args)
+{
+    std::vector<char*> argv;
+    argv.push_back(const_cast<char*>(executable.c_str()));
+
+    for (auto i = args.begin(), end = args.end(); i != end; ++i)
+    {
+        argv.push_back(const_cast<char*>(i->c_str()));
+    }
+
+    argv.push_back(nullptr);
+
+#if defined(__linux__)
+    m_controlGroup = CreateControlGroup(m_limits, m_controlGroupRoot);
+#endif
+
+    // Prepare everything the child needs ahead of fork; only async-signal-safe calls are permitted in between fork and exec
+    const std::string procs = m_controlGroup.empty() ? std::string() : (m_controlGroup + "/cgroup.procs");
+
+    struct SLimit
+    {
+        int m_resource;
+        rlimit m_limit;
+    };
+
+    std::vector<SLimit> limits;
+
+    if ((m_limits.m_memory > 0) && m_controlGroup.empty())
+    {
+        SLimit limit = { RLIMIT_AS, { static_cast<rlim_t>(m_limits.m_memory), static_cast<rlim_t>(m_limits.m_memory) } };
+        limits.push_back(limit);
+    }
+
+    if (m_limits.m_cpuTime > 0)
+    {
+        // The soft limit raises SIGXCPU, the hard limit SIGKILL a second later
+        SLimit limit = { RLIMIT_CPU, { static_cast<rlim_t>(m_limits.m_cpuTime), static_cast<rlim_t>(m_limits.m_cpuTime + 1) } };
+        limits.push_back(limit);
+    }
+
+    if (m_limits.m_openFiles > 0)
+    {
+        SLimit limit = { RLIMIT_NOFILE, { static_cast<rlim_t>(m_limits.m_openFiles), static_cast<rlim_t>(m_limits.m_openFiles) } };
+        limits.push_back(limit);
+    }
+
+    pid_t pid = fork();
+
+    if (pid < 0)
+    {
+        if (!m_controlGroup.empty())
+        {
+            rmdir(m_controlGroup.c_str());
+            m_controlGroup.clear();
+        }
+
+        throw std::runtime_error(std::string("Failed to start ").append(executable).append(": ").append(std::strerror(errno)));
+    }
+
+    if (pid == 0)
+    {
+        // Run in a dedicated process group so that the whole group can be terminated at once
+        setpgid(0, 0);
+
+        if (!procs.empty())
+        {
+            // Writing 0 moves the writing process
+            int group = open(procs.c_str(), O_WRONLY);
+
+            if ((group < 0) || (write(group, "0", 1) != 1))
+            {
+                _exit(127);
+            }
+
+            close(group);
+        }
+
+        for (std::size_t i = 0; i < limits.size(); ++i)
+        {
+            if (setrlimit(limits[i].m_resource, &limits[i].m_limit) != 0)
+            {
+                _exit(127);
+            }
+        }
+
+        execv(executable.c_str(), &argv[0]);
+        _exit(127);
+    }
+
+    setpgid(pid, pid);
+
+    m_pid = pid;
+    m_running = true;
+}
+
+bool CChildProcess::Wait(unsigned long timeout)
+{
+    if (!m_running)
+    {
+        return true;
+    }
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point sample = start;
+
+    // Resource usage is sampled while waiting, hence the child is polled in case limits apply
+    const bool poll = (timeout != c_infinite) || !m_limits.IsEmpty();
+
+    for (;;)
+    {
+        if (!m_limits.IsEmpty() && (std::chrono::steady_clock::now() >= sample))
+        {
+            SampleResourceUsage();
+            sample += std::chrono::milliseconds(c_sampleInterval);
+        }
+
+        int status = 0;
+        rusage usage;
+        std::memset(&usage, 0, sizeof(usage));
+
+        pid_t result = wait4(m_pid, &status, poll ? WNOHANG : 0, &usage);
+
+        if ((result == m_pid) || ((result < 0) && (errno != EINTR)))
+        {
+            m_running = false;
+            m_exitedNormally = (result == m_pid) && WIFEXITED(status);
+            m_exitCode = m_exitedNormally ? WEXITSTATUS(status) : ((result == m_pid) && WIFSIGNALED(status) ? WTERMSIG(status) : -1);
+
+            if (result == m_pid)
+            {
+                // ru_maxrss is expressed in KiB (bytes on macOS)
+#if defined(__APPLE__)
+                const std::uint64_t maxrss = static_cast<std::uint64_t>(usage.ru_maxrss);
+#else
+                const std::uint64_t maxrss = static_cast<std::uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+                m_usage.m_peakMemory = std::max(m_usage.m_peakMemory, maxrss);
+                m_usage.m_cpuTime = (static_cast<std::uint64_t>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000) +
+                                    static_cast<std::uint64_t>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+                m_usage.m_peakProcesses = std::max(m_usage.m_peakProcesses, 1ul);
+            }
+
+            if (!m_controlGroup.empty())
+            {
+                m_usage.m_peakMemory = std::max<std::uint64_t>(m_usage.m_peakMemory, std::strtoull(ReadLine(m_controlGroup + "/memory.peak").c_str(), nullptr, 10));
+                m_usage.m_memoryLimitHits = static_cast<unsigned long>(ReadKeyedValue(m_controlGroup + "/memory.events", "oom_kill"));
+                m_usage.m_processLimitHits = static_cast<unsigned long>(ReadKeyedValue(m_controlGroup + "/pids.events", "max"));
+
+                // Processes which the child left behind are killed along with the group
+                RemoveControlGroup(m_controlGroup);
+                m_controlGroup.clear();
+            }
+
+            return true;
+        }
+
+        if ((timeout != c_infinite) && ((std::chrono::steady_clock::now() - start) >= std::chrono::milliseconds(timeout)))
+        {
+            return false;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+}
+
+void CChildProcess::Terminate()
+{
+    if (!m_running)
+    {
+        return;
+    }
+
+    kill(-m_pid, SIGKILL);
+    kill(m_pid, SIGKILL);
+
+    Wait(c_infinite);
+
+    m_exitedNormally = false;
+    m_exitCode = SIGKILL;
+}
+
+bool CChildProcess::WriteSnapshot(const std::string&)
+{
+    if (!m_running)
+    {
+        return false;
+    }
+
+    // The child writes its own stack to the file it has been configured with (see InstallSnapshotHandler)
+    if (kill(m_pid, SIGUSR2) != 0)
+    {
+        return false;
+    }
+
+    // Grant the child some time to write the snapshot
+    Wait(1000);
+
+    return true;
+}
+
+void CChildProcess::InstallSnapshotHandler(const std::string& file)
+{
+    s_snapshotFile = open(file.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+    if (s_snapshotFile < 0)
+    {
+        return;
+    }
+
+    // Prime backtrace so that it does not need to load libgcc within the signal handler
+    void* frame = nullptr;
+    backtrace(&frame, 1);
+
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = SnapshotSignalHandler;
+    sigemptyset(&action.sa_mask);
+
+    sigaction(SIGUSR2, &action, nullptr);
+}
+
+std::string CChildProcess::GetCurrentExecutable(const std::string& fallback)
+{
+    char path[4096];
+    ssize_t length = readlink("/proc/self/exe", path, sizeof(path));
+
+    return ((length > 0) && (static_cast<std::size_t>(length) < sizeof(path))) ? std::string(path, static_cast<std::size_t>(length)) : fallback;
+}
+
+CChildProcess::TNativeHandle CChildProcess::GetNativeHandle() const
+{
+    return m_pid;
+}
+
+void CChildProcess::SampleResourceUsage()
+{
+    if (!m_running)
+    {
+        return;
+    }
+
+    const std::string process = "/proc/" + std::to_string(m_pid);
+
+    // VmHWM is the peak resident set size in kB
+    std::ifstream status(process + "/status");
+    std::string line;
+
+    while (std::getline(status, line))
+    {
+        if (line.compare(0, 6, "VmHWM:") == 0)
+        {
+            m_usage.m_peakMemory = std::max<std::uint64_t>(m_usage.m_peakMemory, std::strtoull(line.c_str() + 6, nullptr, 10) * 1024);
+            break;
+        }
+    }
+
+    m_usage.m_peakOpenFiles = std::max(m_usage.m_peakOpenFiles, CountEntries(process + "/fd"));
+
+    if (!m_controlGroup.empty())
+    {
+        m_usage.m_peakProcesses = std::max(m_usage.m_peakProcesses, static_cast<unsigned long>(std::strtoul(ReadLine(m_controlGroup + "/pids.current").c_str(), nullptr, 10)));
+    }
+}
+
+#endif
+
+bool CChildProcess::IsRunning() const
+{
+    return m_running;
+}
+
+bool CChildProcess::HasExitedNormally() const
+{
+    return !m_running && m_exitedNormally;
+}
+
+int CChildProcess::GetExitCode() const
+{
+    return m_exitCode;
+}
+
+std::string CChildProcess::DescribeExit() const
+{
+    std::ostringstream description;
+
+    if (m_running)
+    {
+        description << "running";
+    }
+    else if (m_exitedNormally)
+    {
+        description << "exit code " << m_exitCode;
+    }
+    else
+    {
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32)
+        description << "abnormal termination (0x" << std::hex << static_cast<unsigned int>(m_exitCode) << ')';
+#else
+        description << "terminated by signal " << m_exitCode;
+#endif
+    }
+
+    return description.str();
+}
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
@@ -0,0 +1,182 @@
+#if !defined( _CChildProcess_H_ )
+#define _CChildProcess_H_
+
+#include <string>
+#include <vector>
+
+#include <boost/config.hpp>
+#include <boost/noncopyable.hpp>
+
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <sys/types.h>
+#endif
+
+#include "ResourceLimits.h"
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+/**
+ * @brief Platform abstraction of a child (worker) process of the test runner.
+ *
+ * The child process, along with any process it spawns, is terminated when the object is destroyed.
+ */
+class CChildProcess : private ::boost::noncopyable
+{
+public:
+    typedef std::vector<std::string> TArguments;
+
+    /**
+     * @brief Timeout value used to wait indefinitely
+     */
+    static const unsigned long c_infinite;
+
+    /**
+     * @brief Constructor
+     */
+    CChildProcess();
+
+    /**
+     * @brief Destructor. Terminates the child process in case it is still running.
+     */
+    ~CChildProcess();
+
+    /**
+     * @brief Sets the resource limits which are applied to the child process when it is started.
+     *
+     * On Linux, memory and process limits are enforced via a dedicated cgroup v2 group in case the cgroup of the
+     * test runner (or the provided control group root) permits to create one; memory is otherwise limited in terms
+     * of address space via setrlimit and processes are not limited. Processor time and open files are limited via
+     * setrlimit. On Windows, limits are enforced via the job object of the child process; open files are not limited.
+     *
+     * @param[in] limits the limits to apply
+     * @param[in] controlGroupRoot cgroup v2 directory under which the group of the child is created; empty for the cgroup of the test runner
+     */
+    void SetResourceLimits(const SResourceLimits& limits, const std::string& controlGroupRoot = std::string())
+    {
+        m_limits = limits;
+        m_controlGroupRoot = controlGroupRoot;
+    }
+
+    /**
+     * @brief Getter for the resource usage high-water marks of the child process. The figures are complete once the
+     *        child process has exited; resources are sampled while waiting for the child process (see Wait).
+     */
+    const SResourceUsage& GetResourceUsage() const
+    {
+        return m_usage;
+    }
+
+    /**
+     * @brief Starts the child process
+     *
+     * @param[in] executable file-path to the executable to start
+     * @param[in] args command line arguments (excluding the executable)
+     * @throw std::runtime_error in case the process could not be started
+     */
+    void Start(const std::string& executable, const TArguments& args);
+
+    /**
+     * @brief Waits for the child process to exit
+     *
+     * @param[in] timeout maximum amount of milliseconds to wait for
+     * @return true if the child process has exited; false if the timeout has elapsed
+     */
+    bool Wait(unsigned long timeout);
+
+    /**
+     * @brief Forcibly terminates the child process and any process it spawned
+     */
+    void Terminate();
+
+    /**
+     * @brief Captures a stack snapshot of the (running) child process.
+     *
+     * On Windows a minidump is written by the parent. On POSIX systems the child is signalled
+     * to write its own backtrace (see InstallSnapshotHandler).
+     *
+     * @param[in] file file-path where the snapshot is written to
+     * @return true if a snapshot was (most probably) written
+     */
+    bool WriteSnapshot(const std::string& file);
+
+    /**
+     * @brief States whether the child process has been started and has not yet exited
+     */
+    bool IsRunning() const;
+
+    /**
+     * @brief States whether the child process has exited normally, i.e. via exit/return from main
+     */
+    bool HasExitedNormally() const;
+
+    /**
+     * @brief Exit code of the child process. Only valid in case HasExitedNormally holds.
+     */
+    int GetExitCode() const;
+
+    /**
+     * @brief Human readable description of how the child process exited
+     */
+    std::string DescribeExit() const;
+
+    /**
+     * @brief Installs a handler in the current process which writes the current stack to the provided file
+     *        when the parent requests a snapshot (POSIX only; no-op on Windows).
+     */
+    static void InstallSnapshotHandler(const std::string& file);
+
+    /**
+     * @brief Returns the file-path of the currently running executable
+     *
+     * @param[in] fallback value to return in case the path cannot be determined (e.g. argv[0])
+     */
+    static std::string GetCurrentExecutable(const std::string& fallback);
+
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32)
+    typedef HANDLE TNativeHandle;
+#else
+    typedef pid_t TNativeHandle;
+#endif
+
+    /**
+     * @brief Native process handle (Windows) or process id (POSIX) of the child process
+     */
+    TNativeHandle GetNativeHandle() const;
+
+private:
+    /**
+     * @brief Samples the current resource usage of the running child process into the high-water marks
+     */
+    void SampleResourceUsage();
+
+    bool m_running;
+    bool m_exitedNormally;
+    int m_exitCode;
+
+    SResourceLimits m_limits;
+    std::string m_controlGroupRoot;
+    SResourceUsage m_usage;
+
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32)
+    HANDLE m_process;
+    HANDLE m_job;
+    DWORD m_pid;
+#else
+    pid_t m_pid;
+    std::string m_controlGroup;             ///< cgroup v2 directory of the child process (if any)
+#endif
+};
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
+
+#endif // _CChildProcess_H_
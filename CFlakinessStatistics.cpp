@@ -0,0 +1,121 @@
+#include "CFlakinessStatistics.h"
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "FileReplacement.h"
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+namespace
+{
+
+// File layout: a header line followed by one line per test case of the form
+// <runs> <failures> <flaky> <path>, where the path spans the remainder of the line
+const char* const c_header = "#flakiness 1";
+
+} // namespace anonymous
+
+CFlakinessStatistics::CFlakinessStatistics(const std::string& file) :
+    m_file(file)
+{
+}
+
+void CFlakinessStatistics::Load()
+{
+    m_statistics.clear();
+
+    std::ifstream in(m_file);
+
+    if (!in)
+    {
+        return;
+    }
+
+    std::string line;
+
+    if (!std::getline(in, line) || (line != c_header))
+    {
+        throw std::runtime_error("Malformed flakiness statistics: " + m_file);
+    }
+
+    while (std::getline(in, line))
+    {
+        if (line.empty())
+        {
+            continue;
+        }
+
+        std::istringstream record(line);
+
+        SStatistics statistics;
+        std::string path;
+
+        if (!(record >> statistics.m_runs >> statistics.m_failures >> statistics.m_flaky) || !std::getline(record >> std::ws, path))
+        {
+            throw std::runtime_error("Malformed flakiness statistics: " + m_file);
+        }
+
+        m_statistics[path] = statistics;
+    }
+}
+
+void CFlakinessStatistics::Update(const std::vector<STestCaseResult>& results)
+{
+    for (auto i = results.begin(), end = results.end(); i != end; ++i)
+    {
+        if (i->m_outcome == OutcomeSkipped)
+        {
+            continue;
+        }
+
+        SStatistics& statistics = m_statistics[i->m_path];
+
+        ++statistics.m_runs;
+
+        if (i->m_outcome == OutcomeFlaky)
+        {
+            ++statistics.m_flaky;
+        }
+        else if (i->m_outcome != OutcomePassed)
+        {
+            ++statistics.m_failures;
+        }
+    }
+}
+
+void CFlakinessStatistics::Save() const
+{
+    const std::string temporary = m_file + ".tmp";
+
+    {
+        std::ofstream out(temporary, std::ios_base::out | std::ios_base::trunc);
+
+        out << c_header << '\n';
+
+        for (auto i = m_statistics.begin(), end = m_statistics.end(); i != end; ++i)
+        {
+            out << i->second.m_runs << ' ' << i->second.m_failures << ' ' << i->second.m_flaky << ' ' << i->first << '\n';
+        }
+
+        if (!out.flush())
+        {
+            throw std::runtime_error("Fail to write flakiness statistics: " + temporary);
+        }
+    }
+
+    if (!ReplaceFileWith(m_file, temporary))
+    {
+        throw std::runtime_error("Fail to write flakiness statistics: " + m_file);
+    }
+}
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
@@ -0,0 +1,86 @@
+#if !defined( _CFlakinessStatistics_H_ )
+#define _CFlakinessStatistics_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "TestCaseResult.h"
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+/**
+ * @brief Per test case flakiness statistics which are accumulated across test runs in a local file
+ */
+class CFlakinessStatistics
+{
+public:
+    /**
+     * @brief Statistics of a single test case
+     */
+    struct SStatistics
+    {
+        SStatistics() :
+            m_runs(0),
+            m_failures(0),
+            m_flaky(0)
+        {
+        };
+
+        unsigned long m_runs;       ///< number of runs in which the test case was executed
+        unsigned long m_failures;   ///< number of runs in which the test case failed on every attempt
+        unsigned long m_flaky;      ///< number of runs in which the test case was classified as flaky
+    };
+
+    typedef std::map<std::string, SStatistics> TStatisticsMap;
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] file file-path of the statistics file
+     */
+    explicit CFlakinessStatistics(const std::string& file);
+
+    /**
+     * @brief Loads the statistics file. A missing file is equivalent to empty statistics.
+     *
+     * @throw std::runtime_error in case of malformed content
+     */
+    void Load();
+
+    /**
+     * @brief Accumulates the final classification of the test cases of a run
+     */
+    void Update(const std::vector<STestCaseResult>& results);
+
+    /**
+     * @brief Writes the statistics file. The file is replaced as a whole so that it is never left partially written.
+     *
+     * @throw std::runtime_error in case the file cannot be written
+     */
+    void Save() const;
+
+    /**
+     * @brief Getter for the accumulated statistics, keyed by test case path
+     */
+    const TStatisticsMap& GetStatistics() const
+    {
+        return m_statistics;
+    }
+
+private:
+    std::string m_file;
+
+    TStatisticsMap m_statistics;
+};
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
+
+#endif // _CFlakinessStatistics_H_
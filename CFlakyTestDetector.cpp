@@ -0,0 +1,139 @@
+#include "CFlakyTestDetector.h"
+
+#include <sstream>
+
+//suppression of warnings related to 3rd party files
+#pragma warning ( disable: 6001 )
+#pragma warning ( disable: 6031 )
+
+#include <boost/test/framework.hpp>
+#include <boost/test/tree/test_unit.hpp>
+
+//end suppression of warnings related to 3rd party files
+#pragma warning ( default: 6001 )
+#pragma warning ( default: 6031 )
+
+#include "CFlakinessStatistics.h"
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+CFlakyTestDetector::CFlakyTestDetector(unsigned int reruns, CIsolatedTestRunner& runner, std::ostream& log) :
+    m_reruns(reruns),
+    m_runner(&runner),
+    m_log(&log),
+    m_statistics(nullptr)
+{
+}
+
+CFlakyTestDetector::~CFlakyTestDetector()
+{
+}
+
+bool CFlakyTestDetector::HasFailures() const
+{
+    for (auto i = m_results.begin(), end = m_results.end(); i != end; ++i)
+    {
+        if (IsFailedOutcome(i->m_outcome))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void CFlakyTestDetector::OnRunStart()
+{
+    m_results.clear();
+
+    for (auto i = m_listeners.begin(), end = m_listeners.end(); i != end; ++i)
+    {
+        (*i)->OnRunStart();
+    }
+}
+
+void CFlakyTestDetector::OnTestCaseStarted(::boost::unit_test::test_unit_id id, const std::string& path)
+{
+    for (auto i = m_listeners.begin(), end = m_listeners.end(); i != end; ++i)
+    {
+        (*i)->OnTestCaseStarted(id, path);
+    }
+}
+
+void CFlakyTestDetector::OnTestCaseFinished(const STestCaseResult& result)
+{
+    m_results.push_back(result);
+
+    for (auto i = m_listeners.begin(), end = m_listeners.end(); i != end; ++i)
+    {
+        (*i)->OnTestCaseFinished(result);
+    }
+}
+
+void CFlakyTestDetector::OnRunFinish()
+{
+    for (auto result = m_results.begin(), last = m_results.end(); result != last; ++result)
+    {
+        if (IsFailedOutcome(result->m_outcome) && (m_reruns > 0))
+        {
+            Rerun(*result);
+
+            for (auto i = m_listeners.begin(), end = m_listeners.end(); i != end; ++i)
+            {
+                (*i)->OnTestCaseFinished(*result);
+            }
+        }
+    }
+
+    if (m_statistics != nullptr)
+    {
+        m_statistics->Update(m_results);
+    }
+
+    for (auto i = m_listeners.begin(), end = m_listeners.end(); i != end; ++i)
+    {
+        (*i)->OnRunFinish();
+    }
+}
+
+void CFlakyTestDetector::Rerun(STestCaseResult& result)
+{
+    const ::boost::unit_test::test_case& testCase = ::boost::unit_test::framework::get<::boost::unit_test::test_case>(result.m_id);
+
+    for (unsigned int attempt = 1; attempt <= m_reruns; ++attempt)
+    {
+        STestCaseResult rerun = m_runner->RunTestCase(testCase);
+
+        *m_log << "Rerun " << attempt << " of " << m_reruns << " of test case " << result.m_path << ' ' << GetOutcomeName(rerun.m_outcome) << std::endl;
+
+        if (rerun.m_outcome == OutcomePassed)
+        {
+            std::ostringstream message;
+            message << "initially " << GetOutcomeName(result.m_outcome) << "; passed on rerun " << attempt << " of " << m_reruns;
+
+            result.m_outcome = OutcomeFlaky;
+            result.m_message = message.str();
+
+            return;
+        }
+    }
+
+    std::ostringstream message;
+    message << "did not pass on any of " << m_reruns << " reruns";
+
+    if (!result.m_message.empty())
+    {
+        message << ": " << result.m_message;
+    }
+
+    result.m_message = message.str();
+}
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
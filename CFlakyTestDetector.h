@@ -0,0 +1,112 @@
+#if !defined( _CFlakyTestDetector_H_ )
+#define _CFlakyTestDetector_H_
+
+#include <ostream>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include "CIsolatedTestRunner.h"
+#include "TestCaseResult.h"
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+class CFlakinessStatistics;
+
+/**
+ * @brief ITestResultListener implementation which tells flaky test cases apart from real failures.
+ *
+ * Results are forwarded as-is to the downstream listeners. At the end of the run, every test case which
+ * did not pass is executed again, each time in a fresh child process, up to a configured number of times.
+ * A test case which passes on any of these attempts is classified as flaky; otherwise it is a real failure.
+ * The final classification of every rerun test case is reported to the downstream listeners ahead of the
+ * end of the run and supersedes the original result.
+ */
+class CFlakyTestDetector :
+    public ITestResultListener,
+    private ::boost::noncopyable
+{
+public:
+    typedef std::vector<STestCaseResult> TResults;
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] reruns maximum number of times a test case which did not pass is executed again
+     * @param[in] runner runner used to execute test cases in isolation. Needs to outlive this object.
+     * @param[in] log stream where rerun progress is reported to
+     */
+    CFlakyTestDetector(unsigned int reruns, CIsolatedTestRunner& runner, std::ostream& log);
+
+    /**
+     * @brief Destructor
+     */
+    virtual ~CFlakyTestDetector();
+
+    /**
+     * @brief Registers a listener to which results are forwarded. The listener needs to outlive this object.
+     */
+    void AddListener(ITestResultListener& listener)
+    {
+        m_listeners.push_back(&listener);
+    }
+
+    /**
+     * @brief Registers statistics which are updated with the final classifications at the end of the run
+     */
+    void SetStatistics(CFlakinessStatistics* statistics)
+    {
+        m_statistics = statistics;
+    }
+
+    /**
+     * @brief States whether any test case failed on every attempt
+     */
+    bool HasFailures() const;
+
+    /**
+     * @brief Getter for the final classification of all test cases of the run
+     */
+    const TResults& GetResults() const
+    {
+        return m_results;
+    }
+
+    // test result listener interface
+
+    virtual void OnRunStart() override;
+    virtual void OnTestCaseStarted(::boost::unit_test::test_unit_id id, const std::string& path) override;
+    virtual void OnTestCaseFinished(const STestCaseResult& result) override;
+
+    /**
+     * @brief Reruns test cases which did not pass and reports their final classification, then forwards the end of the run
+     */
+    virtual void OnRunFinish() override;
+
+private:
+    /**
+     * @brief Reruns the test case of the provided result and updates the result with the final classification
+     */
+    void Rerun(STestCaseResult& result);
+
+    unsigned int m_reruns;
+    CIsolatedTestRunner* m_runner;
+    std::ostream* m_log;
+
+    CFlakinessStatistics* m_statistics;
+
+    std::vector<ITestResultListener*> m_listeners;
+
+    TResults m_results;
+};
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
+
+#endif // _CFlakyTestDetector_H_
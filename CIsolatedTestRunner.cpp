@@ -0,0 +1,296 @@
+#include "CIsolatedTestRunner.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+//suppression of warnings related to 3rd party files
+#pragma warning ( disable: 6001 )
+#pragma warning ( disable: 6031 )
+
+#include <boost/cstdlib.hpp>
+#include <boost/test/tree/test_unit.hpp>
+
+//end suppression of warnings related to 3rd party files
+#pragma warning ( default: 6001 )
+#pragma warning ( default: 6031 )
+
+#include "TestUnitPath.h"
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+namespace
+{
+
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32)
+const char* const c_snapshotExtension = ".dmp";
+#else
+const char* const c_snapshotExtension = ".stack";
+#endif
+
+typedef std::chrono::steady_clock TClock;
+
+unsigned long ElapsedMicroseconds(TClock::time_point start)
+{
+    return static_cast<unsigned long>(std::chrono::duration_cast<std::chrono::microseconds>(TClock::now() - start).count());
+}
+
+} // namespace anonymous
+
+CIsolatedTestRunner::CIsolatedTestRunner(const std::string& executable, const CChildProcess::TArguments& args, const CTimeoutPolicy& policy) :
+    m_executable(executable),
+    m_args(args),
+    m_policy(&policy),
+    m_placement(nullptr),
+    m_timeline(nullptr)
+{
+}
+
+int CIsolatedTestRunner::Run(const CTestCaseCollector::TTestCases& testCases, std::ostream& log)
+{
+    m_results.clear();
+
+    const TClock::time_point start = TClock::now();
+    const unsigned long long global = static_cast<unsigned long long>(m_policy->GetGlobalTimeout()) * 1000;
+
+    std::size_t failures = 0;
+    std::size_t skipped = 0;
+    bool globalTimeout = false;
+
+    for (auto listener = m_listeners.begin(), end = m_listeners.end(); listener != end; ++listener)
+    {
+        (*listener)->OnRunStart();
+    }
+
+    for (auto i = testCases.begin(), end = testCases.end(); i != end; ++i)
+    {
+        unsigned long long timeout = static_cast<unsigned long long>(m_policy->GetTimeout(**i)) * 1000;
+        bool globalDeadline = false;
+
+        if (global > 0)
+        {
+            unsigned long long elapsed = static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::milliseconds>(TClock::now() - start).count());
+            unsigned long long remaining = (elapsed < global) ? (global - elapsed) : 0;
+
+            if ((timeout == 0) || (remaining < timeout))
+            {
+                timeout = remaining;
+                globalDeadline = true;
+            }
+        }
+
+        STestCaseResult result;
+
+        if (globalDeadline && (timeout == 0))
+        {
+            // The global time budget has been spent; do not start any further test cases
+            result.m_id = (*i)->p_id;
+            result.m_path = GetTestUnitPath(**i);
+            result.m_outcome = OutcomeSkipped;
+            result.m_message = "global timeout exceeded";
+
+            globalTimeout = true;
+        }
+        else
+        {
+            for (auto listener = m_listeners.begin(), last = m_listeners.end(); listener != last; ++listener)
+            {
+                (*listener)->OnTestCaseStarted((*i)->p_id, GetTestUnitPath(**i));
+            }
+
+            result = RunTestCase(**i, (timeout == 0) ? CChildProcess::c_infinite : static_cast<unsigned long>(timeout));
+
+            if (globalDeadline && (result.m_outcome == OutcomeTimeout))
+            {
+                result.m_message = "global timeout exceeded";
+            }
+        }
+
+        if (result.m_outcome == OutcomeSkipped)
+        {
+            ++skipped;
+        }
+        else if (result.m_outcome != OutcomePassed)
+        {
+            ++failures;
+        }
+
+        log << "Test case " << result.m_path << ' ' << GetOutcomeName(result.m_outcome)
+            << " (" << (result.m_elapsed / 1000) << "ms)";
+
+        if (!result.m_message.empty())
+        {
+            log << ": " << result.m_message;
+        }
+
+        log << std::endl;
+
+        m_results.push_back(result);
+
+        for (auto listener = m_listeners.begin(), last = m_listeners.end(); listener != last; ++listener)
+        {
+            (*listener)->OnTestCaseFinished(result);
+        }
+    }
+
+    for (auto listener = m_listeners.begin(), end = m_listeners.end(); listener != end; ++listener)
+    {
+        (*listener)->OnRunFinish();
+    }
+
+    log << std::endl << "*** " << failures << " of " << m_results.size() << " test cases did not pass, " << skipped << " skipped" << std::endl;
+
+    // Skipped test cases only fail the run in case they were skipped because the time budget of the run was spent
+    return ((failures == 0) && !globalTimeout) ? ::boost::exit_success : ::boost::exit_test_failure;
+}
+
+STestCaseResult CIsolatedTestRunner::RunTestCase(const ::boost::unit_test::test_case& testCase)
+{
+    unsigned long timeout = m_policy->GetTimeout(testCase);
+
+    return RunTestCase(testCase, (timeout == 0) ? CChildProcess::c_infinite : (timeout * 1000));
+}
+
+STestCaseResult CIsolatedTestRunner::RunTestCase(const ::boost::unit_test::test_case& testCase, unsigned long timeout)
+{
+    STestCaseResult result;
+
+    result.m_id = testCase.p_id;
+    result.m_path = GetTestUnitPath(testCase);
+
+    CChildProcess::TArguments args(m_args);
+    // Select the test case by id rather than by a Boost UTF run filter, which does not support all test unit names
+    args.push_back("--worker-test");
+    args.push_back(std::to_string(testCase.p_id));
+
+    std::string snapshot;
+
+    if (!m_snapshotDirectory.empty())
+    {
+        snapshot = GetTestUnitFilePath(m_snapshotDirectory, result.m_path, c_snapshotExtension);
+
+        args.push_back("--snapshot-file");
+        args.push_back(snapshot);
+    }
+
+    if (m_placement != nullptr)
+    {
+        // The child applies its placement before the test library is loaded
+        CWorkerPlacement::SPlacement placement = m_placement->Next(testCase);
+
+        if (!placement.m_cpus.empty())
+        {
+            result.m_cpus = CWorkerPlacement::FormatCpus(placement.m_cpus);
+
+            args.push_back("--worker-cpus");
+            args.push_back(result.m_cpus);
+        }
+
+        if (placement.m_node >= 0)
+        {
+            result.m_numaNode = placement.m_node;
+
+            args.push_back("--worker-node");
+            args.push_back(std::to_string(placement.m_node));
+        }
+    }
+
+    if (!m_limits.IsEmpty())
+    {
+        // The child turns failures due to allocation failures and processor time exhaustion into distinct exit codes
+        args.push_back("--worker-limits");
+        args.push_back("true");
+    }
+
+    if (m_timeline != nullptr)
+    {
+        args.push_back("--trace-fragment");
+        args.push_back(m_traceFragment);
+    }
+
+    const TClock::time_point start = TClock::now();
+    const std::int64_t traceStart = (m_timeline == nullptr) ? 0 : CTraceTimeline::Now();
+
+    CChildProcess child;
+    child.SetResourceLimits(m_limits, m_controlGroupRoot);
+
+    try
+    {
+        child.Start(m_executable, args);
+    }
+    catch (const std::exception& ex)
+    {
+        result.m_outcome = OutcomeAborted;
+        result.m_message = ex.what();
+
+        return result;
+    }
+
+    if (child.Wait(timeout))
+    {
+        result.m_elapsed = ElapsedMicroseconds(start);
+
+        if (child.HasExitedNormally() && (child.GetExitCode() == ::boost::exit_success))
+        {
+            result.m_outcome = OutcomePassed;
+        }
+        else if (child.HasExitedNormally() && (child.GetExitCode() == ::boost::exit_test_failure))
+        {
+            result.m_outcome = OutcomeFailed;
+        }
+        else
+        {
+            result.m_outcome = OutcomeAborted;
+            result.m_message = child.DescribeExit();
+        }
+
+        const std::string resource = (result.m_outcome == OutcomePassed) ? std::string() :
+            GetExceededResource(m_limits, child.GetResourceUsage(), child.HasExitedNormally(), child.GetExitCode());
+
+        if (!resource.empty())
+        {
+            result.m_outcome = OutcomeResourceLimit;
+            result.m_message = DescribeResourceViolation(resource, m_limits, child.GetResourceUsage());
+        }
+
+        if (!snapshot.empty())
+        {
+            // The snapshot file is only of interest for timed out test cases
+            std::remove(snapshot.c_str());
+        }
+    }
+    else
+    {
+        result.m_elapsed = ElapsedMicroseconds(start);
+        result.m_outcome = OutcomeTimeout;
+
+        if (!snapshot.empty() && child.WriteSnapshot(snapshot))
+        {
+            result.m_message = "stack snapshot written to " + snapshot;
+        }
+
+        child.Terminate();
+    }
+
+    if (m_timeline != nullptr)
+    {
+        // The worker span covers the whole lifetime of the child process; the fragment details the test case
+        m_timeline->Record("worker", result.m_path, traceStart, CTraceTimeline::Now());
+
+        if (m_timeline->MergeFragment(m_traceFragment))
+        {
+            std::remove(m_traceFragment.c_str());
+        }
+    }
+
+    return result;
+}
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
@@ -0,0 +1,158 @@
+#if !defined( _CIsolatedTestRunner_H_ )
+#define _CIsolatedTestRunner_H_
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include "CChildProcess.h"
+#include "CTestCaseCollector.h"
+#include "CTimeoutPolicy.h"
+#include "CTraceTimeline.h"
+#include "CWorkerPlacement.h"
+#include "TestCaseResult.h"
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+/**
+ * @brief Executes test cases one by one, each in a dedicated child process of the test runner, and
+ *        enforces per test case and global timeouts.
+ *
+ * A test case which overruns its time budget has a stack snapshot captured (in case a snapshot
+ * directory is configured), its process terminated and a timeout result recorded. Execution then
+ * proceeds with the remaining test cases.
+ */
+class CIsolatedTestRunner : private ::boost::noncopyable
+{
+public:
+    typedef std::vector<STestCaseResult> TResults;
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] executable file-path to the test runner executable used for child processes
+     * @param[in] args command line arguments passed to every child process (excluding test case selection)
+     * @param[in] policy timeout policy applied to test cases
+     */
+    CIsolatedTestRunner(const std::string& executable, const CChildProcess::TArguments& args, const CTimeoutPolicy& policy);
+
+    /**
+     * @brief Sets the directory where stack snapshots of timed out test cases are written to.
+     *        No snapshots are captured in case the directory is empty (default).
+     */
+    void SetSnapshotDirectory(const std::string& directory)
+    {
+        m_snapshotDirectory = directory;
+    }
+
+    /**
+     * @brief Sets the placement of the child processes on processors and NUMA nodes. Child processes are not
+     *        placed in case no placement is set (default). The placement needs to outlive this runner.
+     */
+    void SetPlacement(CWorkerPlacement* placement)
+    {
+        m_placement = placement;
+    }
+
+    /**
+     * @brief Sets the resource limits of the child processes. A child process which is stopped by one of its limits
+     *        is reported with the OutcomeResourceLimit outcome and its resource usage high-water marks.
+     *
+     * @param[in] limits the limits to apply (none by default)
+     * @param[in] controlGroupRoot cgroup v2 directory under which the groups of the child processes are created (see CChildProcess::SetResourceLimits)
+     */
+    void SetResourceLimits(const SResourceLimits& limits, const std::string& controlGroupRoot = std::string())
+    {
+        m_limits = limits;
+        m_controlGroupRoot = controlGroupRoot;
+    }
+
+    /**
+     * @brief Sets the timeline on which each child process is recorded. Each child process records its own timeline
+     *        into the provided fragment file, which is merged into the timeline once the child process has exited.
+     *        Child processes are not recorded in case no timeline is set (default). The timeline needs to outlive this runner.
+     *
+     * @param[in] timeline the timeline to record to
+     * @param[in] fragment file-path to the timeline fragment written by the child processes
+     */
+    void SetTraceTimeline(CTraceTimeline* timeline, const std::string& fragment)
+    {
+        m_timeline = timeline;
+        m_traceFragment = fragment;
+    }
+
+    /**
+     * @brief Registers a listener which is notified of test case results. The listener needs to outlive this runner.
+     */
+    void AddListener(ITestResultListener& listener)
+    {
+        m_listeners.push_back(&listener);
+    }
+
+    /**
+     * @brief Executes the provided test cases
+     *
+     * @param[in] testCases test cases to execute, in order
+     * @param[in] log stream where progress and a summary are reported to
+     * @return boost::exit_success in case all test cases passed or were skipped (other than for lack of time of the run);
+     *         boost::exit_test_failure otherwise
+     */
+    int Run(const CTestCaseCollector::TTestCases& testCases, std::ostream& log);
+
+    /**
+     * @brief Executes a single test case in a child process, applying the time budget of the timeout policy.
+     *        Listeners are not notified.
+     *
+     * @param[in] testCase the test case to execute
+     * @return the result of the test case
+     */
+    STestCaseResult RunTestCase(const ::boost::unit_test::test_case& testCase);
+
+    /**
+     * @brief Getter for the results of the last run
+     */
+    const TResults& GetResults() const
+    {
+        return m_results;
+    }
+
+private:
+    /**
+     * @brief Executes a single test case in a child process
+     *
+     * @param[in] testCase the test case to execute
+     * @param[in] timeout time budget of the test case in milliseconds (CChildProcess::c_infinite for none)
+     */
+    STestCaseResult RunTestCase(const ::boost::unit_test::test_case& testCase, unsigned long timeout);
+
+    std::string m_executable;
+    CChildProcess::TArguments m_args;
+    const CTimeoutPolicy* m_policy;
+
+    std::string m_snapshotDirectory;
+
+    CWorkerPlacement* m_placement;
+
+    SResourceLimits m_limits;
+    std::string m_controlGroupRoot;
+
+    CTraceTimeline* m_timeline;
+    std::string m_traceFragment;
+
+    std::vector<ITestResultListener*> m_listeners;
+
+    TResults m_results;
+};
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
+
+#endif // _CIsolatedTestRunner_H_
@@ -0,0 +1,226 @@
+#include "CJUnitReportWriter.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+//suppression of warnings related to 3rd party files
+#pragma warning ( disable: 6001 )
+#pragma warning ( disable: 6031 )
+
+#include <boost/test/utils/xml_printer.hpp>
+
+//end suppression of warnings related to 3rd party files
+#pragma warning ( default: 6001 )
+#pragma warning ( default: 6031 )
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+namespace
+{
+
+// Utility function which is used to simply avoid writing '::boost::unit_test::attr_value()'
+::boost::unit_test::attr_value attr_value()
+{
+    return ::boost::unit_test::attr_value();
+};
+
+const char* const c_footer = "    </testsuite>\n</testsuites>\n";
+
+/**
+ * @brief Returns the file name of the provided file-path
+ */
+std::string GetFileName(const std::string& path)
+{
+    std::string::size_type separator = path.find_last_of("/\\");
+    return (separator == std::string::npos) ? path : path.substr(separator + 1);
+}
+
+/**
+ * @brief Returns the JUnit element reporting the provided outcome or nullptr in case the outcome is a pass
+ */
+const char* GetOutcomeElement(ETestOutcome outcome)
+{
+    switch (outcome)
+    {
+    case OutcomePassed:  return nullptr;
+    case OutcomeFailed:  return "failure";
+    case OutcomeAborted: return "error";
+    case OutcomeSkipped: return "skipped";
+    case OutcomeTimeout: return "error";
+    // Maven Surefire extension; ignored by consumers which do not support it
+    case OutcomeFlaky:   return "flakyFailure";
+    case OutcomeResourceLimit: return "error";
+    }
+
+    return "error";
+}
+
+} // namespace anonymous
+
+CJUnitReportWriter::CJUnitReportWriter(const std::string& source, const std::string& file) :
+    m_out(file, (std::ios_base::out | std::ios_base::trunc | std::ios_base::binary)),
+    m_source(GetFileName(source)),
+    m_footer(0),
+    m_tailSize(0),
+    m_deferFailures(false)
+{
+    if (!m_out)
+    {
+        throw std::runtime_error("Fail to create JUnit report: " + file);
+    }
+}
+
+CJUnitReportWriter::~CJUnitReportWriter()
+{
+}
+
+void CJUnitReportWriter::SetDeferFailures(bool defer)
+{
+    m_deferFailures = defer;
+}
+
+void CJUnitReportWriter::OnRunStart()
+{
+    m_deferred.clear();
+    m_deferredIndex.clear();
+
+    std::ostringstream preamble;
+
+    preamble << "<?xml version=\"1.0\" encoding=\"UTF-8\" ?>" << '\n'
+             << "<testsuites name" << attr_value() << m_source << '>' << '\n'
+             << "    <testsuite name" << attr_value() << m_source << '>' << '\n';
+
+    Append(preamble.str());
+}
+
+void CJUnitReportWriter::OnTestCaseFinished(const STestCaseResult& result)
+{
+    // JUnit reports identify test cases by class and method name; map them to the test suite path and the test case name
+    std::string::size_type separator = result.m_path.rfind('/');
+
+    std::string classname = (separator == std::string::npos) ? m_source : result.m_path.substr(0, separator);
+    std::replace(classname.begin(), classname.end(), '/', '.');
+
+    const std::string name = (separator == std::string::npos) ? result.m_path : result.m_path.substr(separator + 1);
+
+    // JUnit expresses times in seconds
+    std::ostringstream time;
+    time << std::fixed << std::setprecision(6) << (result.m_elapsed / 1000000.0);
+
+    std::ostringstream testcase;
+
+    testcase << "        <testcase"
+                " classname" << attr_value() << classname <<
+                " name" << attr_value() << name <<
+                " time" << attr_value() << time.str();
+
+    const char* element = GetOutcomeElement(result.m_outcome);
+
+    if ((element == nullptr) && result.m_output.empty())
+    {
+        testcase << " />" << '\n';
+    }
+    else
+    {
+        testcase << '>' << '\n';
+
+        if (element != nullptr)
+        {
+            testcase << "            <" << element << " type" << attr_value() << GetOutcomeName(result.m_outcome);
+
+            if (!result.m_message.empty())
+            {
+                testcase << " message" << attr_value() << result.m_message;
+            }
+
+            testcase << " />" << '\n';
+        }
+
+        if (!result.m_output.empty())
+        {
+            testcase << "            <system-out>" << ::boost::unit_test::cdata() << result.m_output << "</system-out>" << '\n';
+        }
+
+        testcase << "        </testcase>" << '\n';
+    }
+
+    const auto deferred = m_deferredIndex.find(result.m_path);
+
+    if (deferred != m_deferredIndex.end())
+    {
+        // A later result (e.g. of a rerun) replaces the earlier one
+        m_deferred[deferred->second] = testcase.str();
+        Append(std::string());
+    }
+    else if (m_deferFailures && IsFailedOutcome(result.m_outcome))
+    {
+        m_deferredIndex[result.m_path] = m_deferred.size();
+        m_deferred.push_back(testcase.str());
+        Append(std::string());
+    }
+    else
+    {
+        Append(testcase.str());
+    }
+}
+
+void CJUnitReportWriter::OnRunFinish()
+{
+    std::string content;
+
+    for (auto i = m_deferred.begin(), end = m_deferred.end(); i != end; ++i)
+    {
+        content += *i;
+    }
+
+    m_deferred.clear();
+    m_deferredIndex.clear();
+
+    if (!content.empty())
+    {
+        Append(content);
+    }
+
+    m_out.close();
+}
+
+void CJUnitReportWriter::Append(const std::string& content)
+{
+    // The held back testcase elements precede the closing elements so that they are on disk even if the run is killed
+    std::string tail;
+
+    for (auto i = m_deferred.begin(), end = m_deferred.end(); i != end; ++i)
+    {
+        tail += *i;
+    }
+
+    tail += c_footer;
+
+    // The file is not truncated; whitespace (which may follow the root element) overwrites what remains of a longer tail
+    const std::size_t previous = m_tailSize;
+    m_tailSize = tail.size();
+
+    if ((content.size() + m_tailSize) < previous)
+    {
+        m_tailSize = previous - content.size();
+        tail.resize(m_tailSize, ' ');
+    }
+
+    m_out.seekp(m_footer);
+
+    // Write content and closing elements at once so that the document is not left without closing elements
+    m_out << content << tail << std::flush;
+
+    m_footer += std::streamoff(content.size());
+}
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
@@ -0,0 +1,112 @@
+#if !defined( _CJUnitReportWriter_H_ )
+#define _CJUnitReportWriter_H_
+
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include "TestCaseResult.h"
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+/**
+ * @brief ITestResultListener implementation which streams test case results as a JUnit xml report.
+ *
+ * Sample output:
+ * @code{.xml}
+ * <?xml version="1.0" encoding="UTF-8" ?>
+ * <testsuites name="TestProject.dll">
+ *     <testsuite name="TestProject.dll">
+ *         <testcase classname="ExampleTestSuite" name="NumberTestCaseA" time="0.001024" />
+ *         <testcase classname="ExampleTestSuite" name="NumberTestCaseB" time="0.000512">
+ *             <failure message="check 1 == 2 has failed" />
+ *         </testcase>
+ *     </testsuite>
+ * </testsuites>
+ * @endcode
+ *
+ * Each test case is written as soon as it finishes and nothing is retained in memory. The closing elements
+ * are written after every test case and overwritten by the next one, so that the report on disk is a
+ * well-formed document even if the run is killed.
+ *
+ * Since element counts are not known up front, the testsuite element carries no tests/failures attributes.
+ * Test cases which are reclassified at the end of the run (see CFlakyTestDetector) are reported once with their
+ * final result, provided that the failed test cases are deferred (see SetDeferFailures). Deferred testcase elements
+ * are written along with the closing elements, i.e. rewritten after every test case, so that they are on disk
+ * even if the run is killed.
+ */
+class CJUnitReportWriter :
+    public ITestResultListener,
+    private ::boost::noncopyable
+{
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param[in] source file-path to the exe/dll module which contains a Boost test framework
+     * @param[in] file file-path of the xml report
+     * @throw std::runtime_error in case the file cannot be created
+     */
+    CJUnitReportWriter(const std::string& source, const std::string& file);
+
+    /**
+     * @brief Destructor
+     */
+    virtual ~CJUnitReportWriter();
+
+    /**
+     * @brief Defers the failed test cases to the end of the run, where the results of their reruns replace them
+     *
+     * @param[in] defer true in case failed test cases are rerun at the end of the run, i.e. reported again
+     */
+    void SetDeferFailures(bool defer);
+
+    // test result listener interface
+
+    /**
+     * @brief Writes the xml declaration and preamble
+     */
+    virtual void OnRunStart() override;
+
+    /**
+     * @brief Writes the result as a testcase element. A failed result is held back (i.e. kept at the end of the report)
+     *        in case failures are deferred, as is a later result of a test case which has been held back, which replaces the earlier one.
+     */
+    virtual void OnTestCaseFinished(const STestCaseResult& result) override;
+
+    /**
+     * @brief Writes the held back testcase elements and closes the report
+     */
+    virtual void OnRunFinish() override;
+
+private:
+    /**
+     * @brief Writes the provided content in place of the held back testcase elements and the closing xml elements and writes the latter anew
+     */
+    void Append(const std::string& content);
+
+    std::ofstream m_out;
+
+    std::string m_source;
+
+    std::streampos m_footer;
+    std::size_t m_tailSize;                             ///< size of the held back testcase elements and the closing elements on disk
+
+    bool m_deferFailures;
+    std::vector<std::string> m_deferred;                ///< held back testcase elements in the order of their first result
+    std::map<std::string, std::size_t> m_deferredIndex; ///< test case path to position of the held back testcase element
+};
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
+
+#endif // _CJUnitReportWriter_H_
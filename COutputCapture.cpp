@@ -0,0 +1,443 @@
+#include "COutputCapture.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include <boost/config.hpp>
+
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32) // WIN32 API
+
+#include <io.h>
+
+#else // POSIX API
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#endif
+
+//suppression of warnings related to 3rd party files
+#pragma warning ( disable: 6001 )
+#pragma warning ( disable: 6031 )
+
+#include <boost/test/unit_test_log.hpp>
+
+//end suppression of warnings related to 3rd party files
+#pragma warning ( default: 6001 )
+#pragma warning ( default: 6031 )
+
+#include "CrashHandler.h"
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+namespace
+{
+
+const int c_stdout = 1;
+const int c_stderr = 2;
+
+// Interval at which the watcher thread checks the size of the capture file
+const std::chrono::milliseconds c_watchInterval(50);
+
+// Minimum size of the capture file before it is cut down, so that small limits do not cause constant rotation
+const long long c_minimumRotationSize = 1024 * 1024;
+
+// Boost UTF loggers whose stream is routed to the standard output while output is captured
+const ::boost::unit_test::output_format c_logFormats[] = {
+    ::boost::unit_test::OF_CLF, ::boost::unit_test::OF_XML, ::boost::unit_test::OF_JUNIT, ::boost::unit_test::OF_CUSTOM_LOGGER
+};
+
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32) // WIN32 API
+
+int Dup(int fd)
+{
+    return _dup(fd);
+}
+
+void Dup2(int from, int to)
+{
+    _dup2(from, to);
+}
+
+void Close(int fd)
+{
+    _close(fd);
+}
+
+long long GetSize(int fd)
+{
+    return _lseeki64(fd, 0, SEEK_END);
+}
+
+void Truncate(int fd)
+{
+    _chsize_s(fd, 0);
+    _lseeki64(fd, 0, SEEK_SET);
+}
+
+long long ReadAt(int fd, long long offset, char* buffer, std::size_t size)
+{
+    // The offset is shared with the redirected standard handles, which are not in use while reading
+    _lseeki64(fd, offset, SEEK_SET);
+    return _read(fd, buffer, static_cast<unsigned int>(size));
+}
+
+void WriteAll(int fd, const char* data, std::size_t size)
+{
+    while (size > 0)
+    {
+        int written = _write(fd, data, static_cast<unsigned int>(size));
+
+        if (written <= 0)
+        {
+            return;
+        }
+
+        data += written;
+        size -= static_cast<std::size_t>(written);
+    }
+}
+
+#else // POSIX API
+
+int Dup(int fd)
+{
+    return dup(fd);
+}
+
+void Dup2(int from, int to)
+{
+    while ((dup2(from, to) < 0) && (errno == EINTR))
+    {
+    }
+}
+
+void Close(int fd)
+{
+    close(fd);
+}
+
+long long GetSize(int fd)
+{
+    return lseek(fd, 0, SEEK_END);
+}
+
+void Truncate(int fd)
+{
+    if (ftruncate(fd, 0) == 0)
+    {
+        lseek(fd, 0, SEEK_SET);
+    }
+}
+
+long long ReadAt(int fd, long long offset, char* buffer, std::size_t size)
+{
+    return pread(fd, buffer, size, static_cast<off_t>(offset));
+}
+
+void WriteAll(int fd, const char* data, std::size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t written = write(fd, data, size);
+
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return;
+        }
+
+        data += written;
+        size -= static_cast<std::size_t>(written);
+    }
+}
+
+#endif
+
+/**
+ * @brief Creates an anonymous file which lives as long as its descriptor is open
+ */
+int CreateCaptureFile()
+{
+#if defined(MFD_CLOEXEC)
+    int fd = memfd_create("output-capture", MFD_CLOEXEC);
+
+    if (fd >= 0)
+    {
+        return fd;
+    }
+#endif
+
+    // The temporary file is removed once its last descriptor is closed
+    std::FILE* file = std::tmpfile();
+
+    if (file == nullptr)
+    {
+        return -1;
+    }
+
+    int duplicate = Dup(fileno(file));
+    std::fclose(file);
+
+    return duplicate;
+}
+
+void FlushStreams()
+{
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(stdout);
+    std::fflush(stderr);
+}
+
+std::atomic<COutputCapture*> s_instance(nullptr);
+
+/**
+ * @brief Copies the range [offset, end) of one file to another
+ * @note async-signal-safe on POSIX systems
+ */
+void Copy(int from, long long offset, long long end, int to)
+{
+    char buffer[4096];
+
+    while (offset < end)
+    {
+        long long read = ReadAt(from, offset, buffer, static_cast<std::size_t>(std::min<long long>(sizeof(buffer), end - offset)));
+
+        if (read <= 0)
+        {
+            return;
+        }
+
+        WriteAll(to, buffer, static_cast<std::size_t>(read));
+        offset += read;
+    }
+}
+
+} // namespace anonymous
+
+COutputCapture::COutputCapture(std::size_t limit, std::ostream& log) :
+    m_limit(limit),
+    m_log(&log),
+    m_file(CreateCaptureFile()),
+    m_stdout(-1),
+    m_stderr(-1),
+    m_discarded(0),
+    m_capturing(false),
+    m_stop(false)
+{
+    if (m_file < 0)
+    {
+        throw std::runtime_error("Fail to create output capture file");
+    }
+
+    m_stdout = Dup(c_stdout);
+    m_stderr = Dup(c_stderr);
+
+    m_watcher = std::thread(&COutputCapture::Watch, this);
+}
+
+COutputCapture::~COutputCapture()
+{
+    Stop(false);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+
+    m_wakeup.notify_one();
+    m_watcher.join();
+
+    Close(m_stdout);
+    Close(m_stderr);
+    Close(m_file);
+}
+
+void COutputCapture::Start()
+{
+    if (m_capturing)
+    {
+        return;
+    }
+
+    FlushStreams();
+    Truncate(m_file);
+
+    Dup2(m_file, c_stdout);
+    Dup2(m_file, c_stderr);
+
+    // Loggers writing to the standard streams are captured along with the file descriptors; loggers writing
+    // to files of their own (e.g. --log_sink) keep writing there
+    m_redirected.clear();
+
+    for (std::size_t i = 0; i < (sizeof(c_logFormats) / sizeof(c_logFormats[0])); ++i)
+    {
+        std::ostream* stream = ::boost::unit_test::unit_test_log.get_stream(c_logFormats[i]);
+
+        if ((stream != nullptr) && (stream == m_log) && (stream != &std::cout))
+        {
+            m_redirected.push_back(std::make_pair(c_logFormats[i], stream));
+            ::boost::unit_test::unit_test_log.set_stream(c_logFormats[i], std::cout);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_discarded = 0;
+        m_capturing = true;
+    }
+
+    s_instance = this;
+    AddCrashCallback(&COutputCapture::FlushOnCrash);
+}
+
+std::string COutputCapture::Stop(bool keep)
+{
+    if (!m_capturing)
+    {
+        return std::string();
+    }
+
+    RemoveCrashCallback(&COutputCapture::FlushOnCrash);
+    s_instance = nullptr;
+
+    FlushStreams();
+
+    long long discarded = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        discarded = m_discarded;
+        m_capturing = false;
+    }
+
+    Dup2(m_stdout, c_stdout);
+    Dup2(m_stderr, c_stderr);
+
+    for (auto i = m_redirected.begin(), end = m_redirected.end(); i != end; ++i)
+    {
+        ::boost::unit_test::unit_test_log.set_stream(i->first, *i->second);
+    }
+
+    m_redirected.clear();
+
+    if (!keep)
+    {
+        return std::string();
+    }
+
+    const long long size = GetSize(m_file);
+    const long long offset = (size > static_cast<long long>(m_limit)) ? (size - static_cast<long long>(m_limit)) : 0;
+
+    std::string output;
+
+    if ((offset + discarded) > 0)
+    {
+        std::ostringstream note;
+        note << "[" << (offset + discarded) << " bytes of output discarded]" << std::endl;
+
+        output = note.str();
+    }
+
+    std::size_t length = output.length();
+    output.resize(length + static_cast<std::size_t>(size - offset));
+
+    for (long long position = offset; position < size; )
+    {
+        long long read = ReadAt(m_file, position, &output[length], static_cast<std::size_t>(size - position));
+
+        if (read <= 0)
+        {
+            break;
+        }
+
+        position += read;
+        length += static_cast<std::size_t>(read);
+    }
+
+    output.resize(length);
+
+    WriteAll(c_stdout, output.data(), output.size());
+
+    return output;
+}
+
+void COutputCapture::Watch()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (!m_stop)
+    {
+        m_wakeup.wait_for(lock, c_watchInterval);
+
+        if (m_capturing)
+        {
+            Rotate();
+        }
+    }
+}
+
+void COutputCapture::Rotate()
+{
+    const long long size = GetSize(m_file);
+    const long long limit = static_cast<long long>(m_limit);
+
+    if (size <= std::max(2 * limit, c_minimumRotationSize))
+    {
+        return;
+    }
+
+    std::string tail(m_limit, '\0');
+    long long length = 0;
+
+    while (length < limit)
+    {
+        long long read = ReadAt(m_file, size - limit + length, &tail[static_cast<std::size_t>(length)], static_cast<std::size_t>(limit - length));
+
+        if (read <= 0)
+        {
+            break;
+        }
+
+        length += read;
+    }
+
+    // The file offset is shared with the redirected standard handles; output following the truncation is appended to the retained output
+    Truncate(m_file);
+    WriteAll(m_file, tail.data(), static_cast<std::size_t>(length));
+
+    m_discarded += size - length;
+}
+
+void COutputCapture::FlushOnCrash()
+{
+    COutputCapture* instance = s_instance.exchange(nullptr);
+
+    if (instance != nullptr)
+    {
+        const long long size = GetSize(instance->m_file);
+        const long long limit = static_cast<long long>(instance->m_limit);
+
+        Copy(instance->m_file, (size > limit) ? (size - limit) : 0, size, instance->m_stdout);
+    }
+}
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
@@ -0,0 +1,120 @@
+#if !defined( _COutputCapture_H_ )
+#define _COutputCapture_H_
+
+#include <condition_variable>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+//suppression of warnings related to 3rd party files
+#pragma warning ( disable: 6001 )
+#pragma warning ( disable: 6031 )
+
+#include <boost/test/detail/global_typedef.hpp>
+
+//end suppression of warnings related to 3rd party files
+#pragma warning ( default: 6001 )
+#pragma warning ( default: 6031 )
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+/**
+ * @brief Captures the standard output, the standard error and the Boost UTF log of the process into an
+ *        anonymous in-memory file (a memfd on Linux, a temporary file elsewhere) for the duration of a test case.
+ *
+ * The file descriptors 1 and 2 are redirected so that output written by any means (iostreams, stdio, direct
+ * writes, child processes) is captured, and the Boost UTF loggers writing to the log stream of the test runner
+ * are routed to the standard output meanwhile. Loggers writing elsewhere (e.g. to a file defined by the Boost UTF
+ * --log_sink directive) are left alone. In case the process crashes while output is captured, the captured output
+ * is written to the original standard output.
+ *
+ * The limit applies to the output which is retained once a capture stops (or written in case of a crash). Output
+ * is written to the capture file directly by the writing code; a watcher thread bounds the size of the file by
+ * moving the most recent output to its beginning once it exceeds twice the limit. Output written in the very
+ * moment the file is cut down may be lost.
+ *
+ * Only a single instance may be alive at any time.
+ */
+class COutputCapture : private ::boost::noncopyable
+{
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param[in] limit maximum amount of bytes of captured output which is retained; the beginning of larger output is discarded
+     * @param[in] log the log stream of the test runner (e.g. the asynchronous log); Boost UTF loggers writing to it are captured
+     * @throw std::runtime_error in case the capture file cannot be created
+     */
+    COutputCapture(std::size_t limit, std::ostream& log);
+
+    /**
+     * @brief Destructor. Stops any running capture.
+     */
+    ~COutputCapture();
+
+    /**
+     * @brief Starts capturing output. Any output captured previously is discarded.
+     */
+    void Start();
+
+    /**
+     * @brief Stops capturing output
+     *
+     * @param[in] keep true to retain the captured output (e.g. the test case failed); false to discard it
+     * @return the retained output (at most limit bytes, preceded by a note in case output has been discarded);
+     *         an empty string in case the output is discarded. Retained output is also written to the standard output.
+     */
+    std::string Stop(bool keep);
+
+private:
+    /**
+     * @brief Writes the captured output to the original standard output from within a crash handler
+     * @note async-signal-safe
+     */
+    static void FlushOnCrash();
+
+    /**
+     * @brief Watcher thread procedure which bounds the size of the capture file while output is captured
+     */
+    void Watch();
+
+    /**
+     * @brief Moves the most recent output (at most limit bytes) to the beginning of the capture file in case the file exceeds twice the limit
+     * @note to be called with m_mutex held while output is captured
+     */
+    void Rotate();
+
+    typedef std::vector<std::pair<::boost::unit_test::output_format, std::ostream*> > TLogStreams;
+
+    std::size_t m_limit;
+    std::ostream* m_log;
+
+    int m_file;
+    int m_stdout;
+    int m_stderr;
+
+    TLogStreams m_redirected;               ///< Boost UTF loggers routed to the standard output and their original stream
+    long long m_discarded;                  ///< amount of output discarded by rotation during the running capture
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    bool m_capturing;
+    bool m_stop;
+    std::thread m_watcher;
+};
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
+
+#endif // _COutputCapture_H_
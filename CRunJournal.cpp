@@ -0,0 +1,459 @@
+#include "CRunJournal.h"
+
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+#include <boost/config.hpp>
+
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+//suppression of warnings related to 3rd party files
+#pragma warning ( disable: 6001 )
+#pragma warning ( disable: 6031 )
+
+#include <boost/lexical_cast.hpp>
+#include <boost/test/framework.hpp>
+#include <boost/test/tree/traverse.hpp>
+
+//end suppression of warnings related to 3rd party files
+#pragma warning ( default: 6001 )
+#pragma warning ( default: 6031 )
+
+#include "CTestUnitInspector.h"
+#include "TestUnitPath.h"
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+namespace
+{
+
+// Journal layout (one record per line, tab separated fields):
+//  #journal <version> <fingerprint>
+//  S <id> <path>
+//  F <outcome> <elapsed> <id> <path> <message>
+const char* const c_header = "#journal";
+const int c_version = 1;
+
+const char c_started = 'S';
+const char c_finished = 'F';
+
+std::string Escape(const std::string& value)
+{
+    std::string escaped;
+    escaped.reserve(value.length());
+
+    for (std::string::const_iterator i = value.begin(), end = value.end(); i != end; ++i)
+    {
+        switch (*i)
+        {
+        case '\\': escaped += "\\\\"; break;
+        case '\t': escaped += "\\t"; break;
+        case '\n': escaped += "\\n"; break;
+        case '\r': escaped += "\\r"; break;
+        default: escaped += *i; break;
+        }
+    }
+
+    return escaped;
+}
+
+std::string Unescape(const std::string& value)
+{
+    std::string unescaped;
+    unescaped.reserve(value.length());
+
+    for (std::string::const_iterator i = value.begin(), end = value.end(); i != end; ++i)
+    {
+        if ((*i == '\\') && ((i + 1) != end))
+        {
+            ++i;
+
+            switch (*i)
+            {
+            case 't': unescaped += '\t'; break;
+            case 'n': unescaped += '\n'; break;
+            case 'r': unescaped += '\r'; break;
+            default: unescaped += *i; break;
+            }
+        }
+        else
+        {
+            unescaped += *i;
+        }
+    }
+
+    return unescaped;
+}
+
+std::vector<std::string> Split(const std::string& line)
+{
+    std::vector<std::string> fields;
+
+    for (std::string::size_type begin = 0, end = 0; end != std::string::npos; begin = end + 1)
+    {
+        end = line.find('\t', begin);
+        fields.push_back(line.substr(begin, (end == std::string::npos) ? std::string::npos : (end - begin)));
+    }
+
+    return fields;
+}
+
+/**
+ * @brief Collects the test cases of a test tree along with the dependencies of all test units
+ */
+struct SDependencyScanner : public ::boost::unit_test::test_tree_visitor
+{
+    typedef std::map<::boost::unit_test::test_unit_id, std::vector<::boost::unit_test::test_unit_id> > TUnitMap;
+
+    virtual void visit(const ::boost::unit_test::test_case& testCase) override
+    {
+        m_testCases.push_back(&testCase);
+
+        for (auto i = m_suites.begin(), end = m_suites.end(); i != end; ++i)
+        {
+            m_testCaseIds[*i].push_back(testCase.p_id);
+        }
+
+        m_testCaseIds[testCase.p_id].push_back(testCase.p_id);
+        m_dependencies[testCase.p_id] = m_inspector.Inspect(testCase).m_dependencies;
+    }
+
+    virtual bool test_suite_start(const ::boost::unit_test::test_suite& testSuite) override
+    {
+        m_suites.push_back(testSuite.p_id);
+        m_dependencies[testSuite.p_id] = m_inspector.Inspect(testSuite).m_dependencies;
+
+        return true;
+    }
+
+    virtual void test_suite_finish(const ::boost::unit_test::test_suite&) override
+    {
+        m_suites.pop_back();
+    }
+
+    CTestCaseCollector::TTestCases m_testCases;         ///< test cases in test tree order
+    TUnitMap m_testCaseIds;                             ///< test cases of each test unit
+    TUnitMap m_dependencies;                            ///< test units each test unit depends on
+
+    std::vector<::boost::unit_test::test_unit_id> m_suites;    ///< currently visited test suites
+
+    CTestUnitInspector m_inspector;
+};
+
+} // namespace anonymous
+
+CRunJournal::CRunJournal(const std::string& file, const std::string& fingerprint) :
+    m_file(file),
+    m_fingerprint(fingerprint),
+    m_out(nullptr),
+    m_complete(0)
+{
+}
+
+CRunJournal::~CRunJournal()
+{
+    if (m_out != nullptr)
+    {
+        std::fclose(m_out);
+    }
+}
+
+bool CRunJournal::Open(bool resume)
+{
+    bool resumed = resume && Load();
+
+    if (!resumed)
+    {
+        m_journalled.clear();
+        m_journalledPaths.clear();
+    }
+
+    m_out = std::fopen(m_file.c_str(), resumed ? "ab" : "wb");
+
+    if (m_out == nullptr)
+    {
+        throw std::runtime_error("Fail to open journal: " + m_file);
+    }
+
+    if (resumed)
+    {
+        // Discard a partially written last record so that it is not joined with the first record appended
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32)
+        _chsize_s(_fileno(m_out), m_complete);
+#else
+        ftruncate(fileno(m_out), static_cast<off_t>(m_complete));
+#endif
+    }
+
+    if (!resumed)
+    {
+        std::ostringstream header;
+        header << c_header << '\t' << c_version << '\t' << m_fingerprint;
+
+        Append(header.str());
+    }
+
+    return resumed;
+}
+
+bool CRunJournal::Load()
+{
+    m_complete = 0;
+
+    std::ifstream in(m_file, std::ios_base::in | std::ios_base::binary);
+
+    std::string line;
+
+    if (!in || !std::getline(in, line) || in.eof())
+    {
+        return false;
+    }
+
+    m_complete = static_cast<long long>(in.tellg());
+
+    std::vector<std::string> header = Split(line);
+
+    if ((header.size() != 3) || (header[0] != c_header) || (header[1] != ::boost::lexical_cast<std::string>(c_version)) || (header[2] != m_fingerprint))
+    {
+        // The journal belongs to a different test library build
+        return false;
+    }
+
+    // path -> id of test cases which were started but never finished
+    std::map<std::string, ::boost::unit_test::test_unit_id> started;
+
+    // path -> index within m_journalled of finished test cases
+    std::map<std::string, std::size_t> finished;
+
+    while (std::getline(in, line))
+    {
+        if (in.eof())
+        {
+            // The last line lacks its line break, i.e. is a partially written record of an interrupted run
+            break;
+        }
+
+        m_complete = static_cast<long long>(in.tellg());
+
+        std::vector<std::string> fields = Split(line);
+
+        try
+        {
+            if ((fields.size() == 3) && (fields[0].size() == 1) && (fields[0][0] == c_started))
+            {
+                started[Unescape(fields[2])] = ::boost::lexical_cast<::boost::unit_test::test_unit_id>(fields[1]);
+            }
+            else if ((fields.size() == 6) && (fields[0].size() == 1) && (fields[0][0] == c_finished))
+            {
+                STestCaseResult result;
+
+                if (!ParseOutcomeName(fields[1], result.m_outcome))
+                {
+                    continue;
+                }
+
+                result.m_elapsed = ::boost::lexical_cast<unsigned long>(fields[2]);
+                result.m_id = ::boost::lexical_cast<::boost::unit_test::test_unit_id>(fields[3]);
+                result.m_path = Unescape(fields[4]);
+                result.m_message = Unescape(fields[5]);
+
+                started.erase(result.m_path);
+
+                if (result.m_outcome == OutcomeSkipped)
+                {
+                    // The test case has not been executed (e.g. the global timeout had been exceeded), hence is executed on resumption
+                    continue;
+                }
+
+                // A later record of the same test case (e.g. the classification of a rerun) supersedes an earlier one
+                std::map<std::string, std::size_t>::const_iterator index = finished.find(result.m_path);
+
+                if (index != finished.end())
+                {
+                    m_journalled[index->second] = result;
+                }
+                else
+                {
+                    finished[result.m_path] = m_journalled.size();
+                    m_journalled.push_back(result);
+                    m_journalledPaths.insert(result.m_path);
+                }
+            }
+
+            // Anything else is most probably a partially written record of an interrupted run; ignore it
+        }
+        catch (const ::boost::bad_lexical_cast&)
+        {
+        }
+    }
+
+    // Test cases which were started but never finished brought the test run down
+    for (auto i = started.begin(), end = started.end(); i != end; ++i)
+    {
+        STestCaseResult result;
+        result.m_id = i->second;
+        result.m_path = i->first;
+        result.m_outcome = OutcomeAborted;
+        result.m_message = "test run interrupted during test case execution";
+
+        // The start record remains unmatched, hence the test case is reported likewise on subsequent resumptions
+        m_journalled.push_back(result);
+        m_journalledPaths.insert(result.m_path);
+    }
+
+    return true;
+}
+
+CTestCaseCollector::TTestCases CRunJournal::GetSkippedTestCases(const ::boost::unit_test::test_suite& master) const
+{
+    SDependencyScanner scanner;
+    ::boost::unit_test::traverse_test_tree(master, scanner, true);
+
+    std::set<::boost::unit_test::test_unit_id> skipped;
+    std::set<::boost::unit_test::test_unit_id> visited;
+    std::vector<::boost::unit_test::test_unit_id> pending;
+
+    for (auto i = scanner.m_testCases.begin(), end = scanner.m_testCases.end(); i != end; ++i)
+    {
+        if (IsJournalled(GetTestUnitPath(**i)))
+        {
+            skipped.insert((*i)->p_id);
+        }
+        else if ((*i)->p_default_status != ::boost::unit_test::test_unit::RS_DISABLED)
+        {
+            pending.push_back((*i)->p_id);
+        }
+    }
+
+    // Test units which are to run require their dependencies and the dependencies of their test suites to run as well
+    while (!pending.empty())
+    {
+        ::boost::unit_test::test_unit_id id = pending.back();
+        pending.pop_back();
+
+        for (; (id != ::boost::unit_test::INV_TEST_UNIT_ID) && visited.insert(id).second; id = ::boost::unit_test::framework::get(id, ::boost::unit_test::TUT_ANY).p_parent_id)
+        {
+            const auto dependencies = scanner.m_dependencies.find(id);
+
+            if (dependencies == scanner.m_dependencies.end())
+            {
+                continue;
+            }
+
+            for (auto dependency = dependencies->second.begin(), last = dependencies->second.end(); dependency != last; ++dependency)
+            {
+                const auto testCases = scanner.m_testCaseIds.find(*dependency);
+
+                if (testCases == scanner.m_testCaseIds.end())
+                {
+                    continue;
+                }
+
+                for (auto i = testCases->second.begin(), end = testCases->second.end(); i != end; ++i)
+                {
+                    if (skipped.erase(*i) > 0)
+                    {
+                        pending.push_back(*i);
+                    }
+                }
+            }
+        }
+    }
+
+    CTestCaseCollector::TTestCases testCases;
+
+    for (auto i = scanner.m_testCases.begin(), end = scanner.m_testCases.end(); i != end; ++i)
+    {
+        if (skipped.find((*i)->p_id) != skipped.end())
+        {
+            testCases.push_back(*i);
+        }
+    }
+
+    return testCases;
+}
+
+void CRunJournal::OnTestCaseStarted(::boost::unit_test::test_unit_id id, const std::string& path)
+{
+    std::ostringstream line;
+    line << c_started << '\t' << id << '\t' << Escape(path);
+
+    Append(line.str());
+}
+
+void CRunJournal::OnTestCaseFinished(const STestCaseResult& result)
+{
+    std::ostringstream line;
+    line << c_finished << '\t' << GetOutcomeName(result.m_outcome) << '\t' << result.m_elapsed << '\t' << result.m_id << '\t'
+         << Escape(result.m_path) << '\t' << Escape(result.m_message);
+
+    Append(line.str());
+}
+
+void CRunJournal::Append(const std::string& line)
+{
+    if (m_out == nullptr)
+    {
+        return;
+    }
+
+    std::fwrite(line.data(), 1, line.length(), m_out);
+    std::fputc('\n', m_out);
+    std::fflush(m_out);
+
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32)
+    _commit(_fileno(m_out));
+#else
+    fsync(fileno(m_out));
+#endif
+}
+
+std::string CRunJournal::GetFingerprint(const std::string& file)
+{
+    std::ifstream in(file, std::ios_base::in | std::ios_base::binary);
+
+    if (!in)
+    {
+        return std::string();
+    }
+
+    // 64-bit FNV-1a over the file content
+    unsigned long long hash = 14695981039346656037ULL;
+    unsigned long long size = 0;
+
+    char buffer[64 * 1024];
+
+    while (in.read(buffer, sizeof(buffer)) || (in.gcount() > 0))
+    {
+        const std::streamsize count = in.gcount();
+
+        for (std::streamsize i = 0; i < count; ++i)
+        {
+            hash ^= static_cast<unsigned char>(buffer[i]);
+            hash *= 1099511628211ULL;
+        }
+
+        size += static_cast<unsigned long long>(count);
+    }
+
+    std::ostringstream fingerprint;
+    fingerprint << std::hex << std::setw(16) << std::setfill('0') << hash << '-' << std::dec << size;
+
+    return fingerprint.str();
+}
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
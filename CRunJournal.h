@@ -0,0 +1,133 @@
+#if !defined( _CRunJournal_H_ )
+#define _CRunJournal_H_
+
+#include <cstdio>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include "CTestCaseCollector.h"
+#include "TestCaseResult.h"
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+/**
+ * @brief ITestResultListener implementation which durably appends test case results to a journal file
+ *        as they are reported, so that an interrupted test run can be resumed.
+ *
+ * The journal records the fingerprint of the test library it belongs to. The start of each test case is
+ * journalled as well, such that a test case which brought down the test runner is reported as aborted
+ * (rather than executed again) when the run is resumed.
+ */
+class CRunJournal :
+    public ITestResultListener,
+    private ::boost::noncopyable
+{
+public:
+    typedef std::vector<STestCaseResult> TResults;
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] file file-path of the journal
+     * @param[in] fingerprint fingerprint of the test library build (see GetFingerprint)
+     */
+    CRunJournal(const std::string& file, const std::string& fingerprint);
+
+    /**
+     * @brief Destructor
+     */
+    virtual ~CRunJournal();
+
+    /**
+     * @brief Opens the journal for appending
+     *
+     * @param[in] resume true to load the results of a previous run from the journal (if it belongs to the
+     *                   same test library build); false to start a new journal
+     * @return true if results of a previous run have been loaded
+     * @throw std::runtime_error in case the journal cannot be opened
+     */
+    bool Open(bool resume);
+
+    /**
+     * @brief Getter for the results loaded from the journal
+     */
+    const TResults& GetJournalledResults() const
+    {
+        return m_journalled;
+    }
+
+    /**
+     * @brief States whether a result for the test case identified by path has been loaded from the journal
+     */
+    bool IsJournalled(const std::string& path) const
+    {
+        return m_journalledPaths.find(path) != m_journalledPaths.end();
+    }
+
+    /**
+     * @brief Determines the test cases of the test tree which are skipped when the run is resumed, i.e. the journalled
+     *        test cases which no test unit yet to run depends on (directly or indirectly). Journalled test cases which a
+     *        test unit yet to run depends on are executed again, since the Boost UTF skips the test units whose dependencies
+     *        are disabled. Needs to be called before the Boost UTF finalizes the setup phase.
+     *
+     * @param[in] master the root of the test tree
+     * @return the test cases to skip
+     */
+    CTestCaseCollector::TTestCases GetSkippedTestCases(const ::boost::unit_test::test_suite& master) const;
+
+    // test result listener interface
+
+    /**
+     * @brief Journals the start of a test case
+     */
+    virtual void OnTestCaseStarted(::boost::unit_test::test_unit_id id, const std::string& path) override;
+
+    /**
+     * @brief Journals the result of a test case
+     */
+    virtual void OnTestCaseFinished(const STestCaseResult& result) override;
+
+    /**
+     * @brief Computes a fingerprint of the provided file which identifies its build
+     *
+     * @param[in] file the file to fingerprint
+     * @return the fingerprint; an empty string in case the file cannot be read
+     */
+    static std::string GetFingerprint(const std::string& file);
+
+private:
+    /**
+     * @brief Loads the entries of the journal
+     *
+     * @return true if the journal exists and belongs to the configured fingerprint
+     */
+    bool Load();
+
+    /**
+     * @brief Appends a line to the journal and commits it to disk
+     */
+    void Append(const std::string& line);
+
+    std::string m_file;
+    std::string m_fingerprint;
+
+    std::FILE* m_out;
+    long long m_complete;               ///< size of the complete records of the loaded journal, i.e. without a partially written last record
+
+    TResults m_journalled;
+    std::set<std::string> m_journalledPaths;
+};
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
+
+#endif // _CRunJournal_H_
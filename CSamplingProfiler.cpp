@@ -0,0 +1,562 @@
+#include "CSamplingProfiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include <boost/config.hpp>
+
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32) // WIN32 API
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#define _NO_CVCONST_H
+#include <DbgHelp.h>
+
+#else // POSIX API
+
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <stdexcept>
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <link.h>
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "ElfSymbolTable.h"
+
+#endif
+
+//suppression of warnings related to 3rd party files
+#pragma warning ( disable: 6001 )
+#pragma warning ( disable: 6031 )
+
+#include <boost/test/tree/test_unit.hpp>
+
+//end suppression of warnings related to 3rd party files
+#pragma warning ( default: 6001 )
+#pragma warning ( default: 6031 )
+
+#include "TestUnitPath.h"
+
+namespace
+{
+
+const std::size_t c_maxFrames = 48;
+const std::size_t c_maxSamples = 16384;
+
+struct SSample
+{
+    std::size_t m_depth;
+    void* m_frames[c_maxFrames];
+};
+
+// Samples are recorded into a buffer preallocated by the profiler since the sampler must neither allocate nor lock
+std::vector<SSample> s_samples;
+std::atomic<std::size_t> s_sampleCount(0);
+
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32) // WIN32 API
+
+// Frames to skip at the top of each sample
+const std::size_t c_skippedFrames = 0;
+
+HANDLE s_target = NULL;
+HANDLE s_sampler = NULL;
+DWORD s_interval = 1;
+
+std::atomic<bool> s_armed(false);
+std::atomic<bool> s_stop(false);
+
+void RecordSample()
+{
+    if (SuspendThread(s_target) == static_cast<DWORD>(-1))
+    {
+        return;
+    }
+
+    CONTEXT context = {};
+    context.ContextFlags = CONTEXT_FULL;
+
+    std::size_t index = s_sampleCount.load();
+
+    if ((index < c_maxSamples) && GetThreadContext(s_target, &context))
+    {
+        STACKFRAME64 frame = {};
+
+#if defined(_M_X64)
+        const DWORD machine = IMAGE_FILE_MACHINE_AMD64;
+        frame.AddrPC.Offset = context.Rip;
+        frame.AddrFrame.Offset = context.Rbp;
+        frame.AddrStack.Offset = context.Rsp;
+#else
+        const DWORD machine = IMAGE_FILE_MACHINE_I386;
+        frame.AddrPC.Offset = context.Eip;
+        frame.AddrFrame.Offset = context.Ebp;
+        frame.AddrStack.Offset = context.Esp;
+#endif
+        frame.AddrPC.Mode = AddrModeFlat;
+        frame.AddrFrame.Mode = AddrModeFlat;
+        frame.AddrStack.Mode = AddrModeFlat;
+
+        SSample& sample = s_samples[index];
+        sample.m_depth = 0;
+
+        while ((sample.m_depth < c_maxFrames) &&
+               StackWalk64(machine, GetCurrentProcess(), s_target, &frame, &context, NULL, SymFunctionTableAccess64, SymGetModuleBase64, NULL) &&
+               (frame.AddrPC.Offset != 0))
+        {
+            sample.m_frames[sample.m_depth++] = reinterpret_cast<void*>(frame.AddrPC.Offset);
+        }
+
+        s_sampleCount.store(index + 1);
+    }
+
+    ResumeThread(s_target);
+}
+
+DWORD WINAPI SamplerThread(LPVOID)
+{
+    while (!s_stop)
+    {
+        Sleep(s_interval);
+
+        if (s_armed)
+        {
+            RecordSample();
+        }
+    }
+
+    return 0;
+}
+
+#else // POSIX API
+
+// Frames to skip at the top of each sample, i.e. the signal handler and the signal trampoline
+const std::size_t c_skippedFrames = 2;
+
+extern "C" void ProfileSignalHandler(int)
+{
+    std::size_t index = s_sampleCount.fetch_add(1);
+
+    if (index < c_maxSamples)
+    {
+        SSample& sample = s_samples[index];
+        sample.m_depth = static_cast<std::size_t>(backtrace(sample.m_frames, static_cast<int>(c_maxFrames)));
+    }
+}
+
+#if defined(SIGEV_THREAD_ID)
+
+// Older C libraries lack the name of the member holding the target thread
+#if !defined(sigev_notify_thread_id)
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+// CPU time clock of the thread executing the test cases; SIGPROF is directed to that thread only
+timer_t s_timer;
+bool s_timerCreated = false;
+
+void CreateTimer()
+{
+    struct sigevent event;
+    std::memset(&event, 0, sizeof(event));
+    event.sigev_notify = SIGEV_THREAD_ID;
+    event.sigev_signo = SIGPROF;
+    event.sigev_notify_thread_id = static_cast<pid_t>(syscall(SYS_gettid));
+
+    s_timerCreated = (timer_create(CLOCK_THREAD_CPUTIME_ID, &event, &s_timer) == 0);
+}
+
+void DeleteTimer()
+{
+    if (s_timerCreated)
+    {
+        timer_delete(s_timer);
+        s_timerCreated = false;
+    }
+}
+
+void SetTimer(unsigned long interval)
+{
+    struct itimerspec timer;
+    timer.it_interval.tv_sec = static_cast<time_t>(interval / 1000000);
+    timer.it_interval.tv_nsec = static_cast<long>(interval % 1000000) * 1000;
+    timer.it_value = timer.it_interval;
+
+    if (s_timerCreated)
+    {
+        timer_settime(s_timer, 0, &timer, nullptr);
+    }
+}
+
+#else
+
+// The process wide interval timer is the only option; SIGPROF may be handled by any thread which does not block it
+void CreateTimer()
+{
+}
+
+void DeleteTimer()
+{
+}
+
+void SetTimer(unsigned long interval)
+{
+    struct itimerval timer;
+    timer.it_interval.tv_sec = static_cast<time_t>(interval / 1000000);
+    timer.it_interval.tv_usec = static_cast<suseconds_t>(interval % 1000000);
+    timer.it_value = timer.it_interval;
+
+    setitimer(ITIMER_PROF, &timer, nullptr);
+}
+
+#endif
+
+typedef std::vector<::etas::boost::unit_test::SElfSymbol> TModuleSymbols;
+
+// Function symbols per module file-path, ordered by address
+std::map<std::string, TModuleSymbols> s_moduleSymbols;
+
+bool CompareAddress(const ::etas::boost::unit_test::SElfSymbol& lhs, const ::etas::boost::unit_test::SElfSymbol& rhs)
+{
+    return lhs.m_address < rhs.m_address;
+}
+
+const TModuleSymbols& GetModuleSymbols(const std::string& module)
+{
+    auto cached = s_moduleSymbols.find(module);
+
+    if (cached != s_moduleSymbols.end())
+    {
+        return cached->second;
+    }
+
+    TModuleSymbols& symbols = s_moduleSymbols[module];
+
+    try
+    {
+        symbols = ::etas::boost::unit_test::ReadElfFunctionSymbols(module);
+    }
+    catch (const std::runtime_error&)
+    {
+        // Modules without a file (e.g. the vDSO) are symbolized via the dynamic linker
+    }
+
+    std::sort(symbols.begin(), symbols.end(), CompareAddress);
+
+    return symbols;
+}
+
+/**
+ * @brief Looks up the function symbol containing the provided link-time address
+ *
+ * @return the function symbol; nullptr in case no symbol of known size contains the address
+ */
+const ::etas::boost::unit_test::SElfSymbol* FindSymbol(const TModuleSymbols& symbols, std::uint64_t address)
+{
+    ::etas::boost::unit_test::SElfSymbol key;
+    key.m_address = address;
+
+    auto symbol = std::upper_bound(symbols.begin(), symbols.end(), key, CompareAddress);
+
+    // Aliases share their address; any of them of known size may contain the address
+    while (symbol != symbols.begin())
+    {
+        --symbol;
+
+        if ((address - symbol->m_address) < symbol->m_size)
+        {
+            return &*symbol;
+        }
+
+        if ((symbol != symbols.begin()) && ((symbol - 1)->m_address != symbol->m_address))
+        {
+            break;
+        }
+    }
+
+    return nullptr;
+}
+
+#endif
+
+std::string SanitizeFrame(std::string name)
+{
+    // ';' separates frames and the last ' ' separates the sample count in the folded stack format
+    for (std::string::iterator i = name.begin(), end = name.end(); i != end; ++i)
+    {
+        if (*i == ';')
+        {
+            *i = ':';
+        }
+    }
+
+    return name;
+}
+
+} // namespace anonymous
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+CSamplingProfiler::CSamplingProfiler(const std::string& directory, unsigned long interval, unsigned long threshold) :
+    m_directory(directory),
+    m_interval((interval == 0) ? 1000 : interval),
+    m_threshold(threshold)
+{
+    s_samples.resize(c_maxSamples);
+
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32)
+    SymSetOptions(SymGetOptions() | SYMOPT_DEFERRED_LOADS | SYMOPT_UNDNAME);
+    SymInitialize(GetCurrentProcess(), NULL, TRUE);
+
+    // The sampler thread needs a real handle to the thread executing the test cases
+    DuplicateHandle(GetCurrentProcess(), GetCurrentThread(), GetCurrentProcess(), &s_target, 0, FALSE, DUPLICATE_SAME_ACCESS);
+
+    s_interval = (m_interval < 1000) ? 1 : static_cast<DWORD>(m_interval / 1000);
+    s_stop = false;
+    s_sampler = CreateThread(NULL, 0, SamplerThread, NULL, 0, NULL);
+#else
+    // Prime backtrace so that it does not need to load libgcc within the signal handler
+    void* frame = nullptr;
+    backtrace(&frame, 1);
+
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = ProfileSignalHandler;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+
+    sigaction(SIGPROF, &action, nullptr);
+
+    // The profiler is constructed by the thread executing the test cases
+    CreateTimer();
+#endif
+}
+
+CSamplingProfiler::~CSamplingProfiler()
+{
+    Disarm();
+
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32)
+    s_stop = true;
+
+    if (s_sampler != NULL)
+    {
+        WaitForSingleObject(s_sampler, INFINITE);
+        CloseHandle(s_sampler);
+        s_sampler = NULL;
+    }
+
+    if (s_target != NULL)
+    {
+        CloseHandle(s_target);
+        s_target = NULL;
+    }
+
+    SymCleanup(GetCurrentProcess());
+#else
+    DeleteTimer();
+    signal(SIGPROF, SIG_IGN);
+
+    s_moduleSymbols.clear();
+#endif
+
+    std::vector<SSample>().swap(s_samples);
+}
+
+void CSamplingProfiler::test_unit_start(const ::boost::unit_test::test_unit& testUnit)
+{
+    if (testUnit.p_type == ::boost::unit_test::TUT_CASE)
+    {
+        Arm();
+    }
+}
+
+void CSamplingProfiler::test_unit_finish(const ::boost::unit_test::test_unit& testUnit, unsigned long elapsed)
+{
+    if (testUnit.p_type != ::boost::unit_test::TUT_CASE)
+    {
+        return;
+    }
+
+    Disarm();
+
+    // elapsed is expressed in microseconds
+    if ((elapsed / 1000) >= m_threshold)
+    {
+        WriteFoldedStacks(GetTestUnitFilePath(m_directory, GetTestUnitPath(testUnit), ".folded"));
+    }
+}
+
+void CSamplingProfiler::Arm()
+{
+    s_sampleCount = 0;
+
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32)
+    // Pick up modules loaded since the last test case (e.g. the test library itself)
+    SymRefreshModuleList(GetCurrentProcess());
+    s_armed = true;
+#else
+    SetTimer(m_interval);
+#endif
+}
+
+void CSamplingProfiler::Disarm()
+{
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32)
+    s_armed = false;
+#else
+    SetTimer(0);
+#endif
+}
+
+void CSamplingProfiler::WriteFoldedStacks(const std::string& file)
+{
+    const std::size_t count = std::min(s_sampleCount.load(), c_maxSamples);
+
+    // folded stack -> number of samples
+    std::map<std::string, unsigned long> stacks;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const SSample& sample = s_samples[i];
+
+        if (sample.m_depth <= c_skippedFrames)
+        {
+            continue;
+        }
+
+        std::string stack;
+
+        // Folded stacks list the outermost frame first
+        for (std::size_t frame = sample.m_depth; frame > c_skippedFrames; --frame)
+        {
+            if (!stack.empty())
+            {
+                stack += ';';
+            }
+
+            stack += Symbolize(sample.m_frames[frame - 1]);
+        }
+
+        ++stacks[stack];
+    }
+
+    std::ofstream out(file, std::ios_base::out | std::ios_base::trunc);
+
+    for (auto i = stacks.begin(), end = stacks.end(); i != end; ++i)
+    {
+        out << i->first << ' ' << i->second << '\n';
+    }
+}
+
+const std::string& CSamplingProfiler::Symbolize(void* address)
+{
+    TSymbolCache::iterator cached = m_symbols.find(address);
+
+    if (cached != m_symbols.end())
+    {
+        return cached->second;
+    }
+
+    std::ostringstream name;
+
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32)
+    char buffer[sizeof(SYMBOL_INFO) + MAX_SYM_NAME];
+
+    SYMBOL_INFO* symbol = reinterpret_cast<SYMBOL_INFO*>(buffer);
+    symbol->SizeOfStruct = sizeof(SYMBOL_INFO);
+    symbol->MaxNameLen = MAX_SYM_NAME;
+
+    DWORD64 displacement = 0;
+
+    if (SymFromAddr(GetCurrentProcess(), reinterpret_cast<DWORD64>(address), &displacement, symbol))
+    {
+        name << symbol->Name;
+    }
+    else
+    {
+        name << address;
+    }
+#else
+    // Return addresses point past the call instruction; look up the call instruction itself
+    const char* const call = static_cast<char*>(address) - 1;
+
+    Dl_info info;
+    struct link_map* map = nullptr;
+
+    const char* symbolName = nullptr;
+
+    if (dladdr1(call, &info, reinterpret_cast<void**>(&map), RTLD_DL_LINKMAP) != 0)
+    {
+        // dladdr only considers exported symbols and misattributes addresses within static, anonymous namespace and
+        // hidden functions to the preceding exported symbol. The full symbol table of the module is consulted first.
+        // The file-path of the executable is not provided by the dynamic linker.
+        const std::string file = ((map != nullptr) && (map->l_name != nullptr) && (map->l_name[0] != '\0')) ? map->l_name : "/proc/self/exe";
+        const std::uint64_t bias = (map != nullptr) ? static_cast<std::uint64_t>(map->l_addr) : 0;
+
+        const ::etas::boost::unit_test::SElfSymbol* symbol = FindSymbol(GetModuleSymbols(file), reinterpret_cast<std::uintptr_t>(call) - bias);
+
+        if (symbol != nullptr)
+        {
+            symbolName = symbol->m_name.c_str();
+        }
+        else
+        {
+            ElfW(Sym)* entry = nullptr;
+
+            // Accept the symbol provided by the dynamic linker only in case the address lies within the function
+            if ((dladdr1(call, &info, reinterpret_cast<void**>(&entry), RTLD_DL_SYMENT) != 0) && (info.dli_sname != nullptr) && (entry != nullptr) &&
+                (static_cast<std::size_t>(call - static_cast<const char*>(info.dli_saddr)) < entry->st_size))
+            {
+                symbolName = info.dli_sname;
+            }
+        }
+    }
+    else
+    {
+        info.dli_fname = nullptr;
+    }
+
+    if (symbolName != nullptr)
+    {
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(symbolName, nullptr, nullptr, &status);
+
+        name << (((status == 0) && (demangled != nullptr)) ? demangled : symbolName);
+
+        std::free(demangled);
+    }
+    else if (info.dli_fname != nullptr)
+    {
+        const char* module = std::strrchr(info.dli_fname, '/');
+        name << ((module != nullptr) ? (module + 1) : info.dli_fname) << "+0x" << std::hex
+             << (static_cast<char*>(address) - static_cast<char*>(info.dli_fbase));
+    }
+    else
+    {
+        name << address;
+    }
+#endif
+
+    return m_symbols[address] = SanitizeFrame(name.str());
+}
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
@@ -0,0 +1,95 @@
+#if !defined( _CSamplingProfiler_H_ )
+#define _CSamplingProfiler_H_
+
+#include <map>
+#include <string>
+
+#include <boost/noncopyable.hpp>
+#include <boost/test/tree/observer.hpp>
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+/**
+ * @brief Boost test_observer implementation which samples the call stacks of each test case and writes
+ *        them in folded stack format (one file per test case), ready to be rendered as a flame graph.
+ *
+ * On POSIX systems the thread executing the test cases (i.e. the thread constructing the profiler) is sampled via
+ * SIGPROF, raised by a timer of its consumed CPU time and directed at that thread (where supported, i.e. on Linux).
+ * On Windows the thread executing the test cases is periodically suspended and its stack walked by a
+ * sampler thread (i.e. in terms of wall clock time). Frames are symbolized against the loaded modules,
+ * the test library included; on POSIX systems against the full symbol table of their files.
+ */
+class CSamplingProfiler :
+    public ::boost::unit_test::test_observer,
+    private ::boost::noncopyable
+{
+public:
+    typedef ::boost::unit_test::test_observer TBase;
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] directory directory where the folded stack files are written to
+     * @param[in] interval sampling interval in microseconds
+     * @param[in] threshold minimum test case duration in milliseconds for its profile to be written
+     */
+    CSamplingProfiler(const std::string& directory, unsigned long interval, unsigned long threshold);
+
+    /**
+     * @brief Destructor
+     */
+    virtual ~CSamplingProfiler();
+
+    // test observer interface
+
+    /**
+     * @brief Observer method for the start of a test unit. Arms the sampler for test cases.
+     */
+    virtual void test_unit_start(const ::boost::unit_test::test_unit& testUnit) override;
+
+    /**
+     * @brief Observer method for the end of a test unit. Disarms the sampler and writes the profile of test cases.
+     */
+    virtual void test_unit_finish(const ::boost::unit_test::test_unit& testUnit, unsigned long elapsed) override;
+
+private:
+    /**
+     * @brief Starts sampling
+     */
+    void Arm();
+
+    /**
+     * @brief Stops sampling
+     */
+    void Disarm();
+
+    /**
+     * @brief Aggregates the collected samples and writes them in folded stack format
+     *
+     * @param[in] file file-path to write to
+     */
+    void WriteFoldedStacks(const std::string& file);
+
+    /**
+     * @brief Resolves the name of the function containing the provided (return) address
+     */
+    const std::string& Symbolize(void* address);
+
+    std::string m_directory;
+    unsigned long m_interval;
+    unsigned long m_threshold;
+
+    typedef std::map<void*, std::string> TSymbolCache;
+    TSymbolCache m_symbols;
+};
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
+
+#endif // _CSamplingProfiler_H_
@@ -0,0 +1,375 @@
+#include "CStaticTestDiscovery.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+
+#include <boost/config.hpp>
+
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#define _NO_CVCONST_H
+#include <DbgHelp.h>
+#else
+#include <cxxabi.h>
+#endif
+
+//suppression of warnings related to 3rd party files
+#pragma warning ( disable: 6001 )
+#pragma warning ( disable: 6031 )
+
+#include <boost/test/utils/xml_printer.hpp>
+
+//end suppression of warnings related to 3rd party files
+#pragma warning ( default: 6001 )
+#pragma warning ( default: 6031 )
+
+#include "ElfSymbolTable.h"
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+namespace
+{
+
+// Utility function which is used to simply avoid writing '::boost::unit_test::attr_value()'
+::boost::unit_test::attr_value attr_value()
+{
+    return ::boost::unit_test::attr_value();
+};
+
+// Name of the member function implementing auto-registered test cases
+const std::string c_testMethod("::test_method");
+
+/**
+ * @brief Test method symbol as read from the module
+ */
+struct SSymbol
+{
+    std::uint64_t m_address;
+    std::string m_name;                     ///< qualified name of the test case, i.e. without the trailing "::test_method"
+    std::string m_file;
+    unsigned long m_line;
+};
+
+bool CompareAddress(const SSymbol& lhs, const SSymbol& rhs)
+{
+    return lhs.m_address < rhs.m_address;
+}
+
+/**
+ * @brief Splits a qualified name into its scopes, ignoring '::' within template arguments and parentheses
+ */
+std::vector<std::string> SplitScopes(const std::string& name)
+{
+    std::vector<std::string> scopes;
+
+    int depth = 0;
+    std::string::size_type begin = 0;
+
+    for (std::string::size_type i = 0; i < name.length(); ++i)
+    {
+        switch (name[i])
+        {
+        case '<':
+        case '(':
+            ++depth;
+            break;
+
+        case '>':
+        case ')':
+            --depth;
+            break;
+
+        case ':':
+            if ((depth == 0) && ((i + 1) < name.length()) && (name[i + 1] == ':'))
+            {
+                scopes.push_back(name.substr(begin, i - begin));
+                begin = i + 2;
+                ++i;
+            }
+            break;
+        }
+    }
+
+    scopes.push_back(name.substr(begin));
+
+    // Anonymous namespaces do not contribute to the test tree
+    scopes.erase(std::remove_if(scopes.begin(), scopes.end(), [](const std::string& scope) {
+        return scope.empty() || (scope == "(anonymous namespace)") || (scope == "`anonymous namespace'");
+    }), scopes.end());
+
+    return scopes;
+}
+
+/**
+ * @brief States whether a qualified test case name belongs to a library rather than to the test module
+ */
+bool IsLibraryName(const std::string& name)
+{
+    return (name.compare(0, 7, "boost::") == 0) || (name.compare(0, 5, "std::") == 0);
+}
+
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32)
+
+BOOL CALLBACK EnumSymbolsCallback(PSYMBOL_INFO symInfo, ULONG symbolSize, PVOID userContext)
+{
+    if ((symInfo != NULL) && (symInfo->NameLen > c_testMethod.length()))
+    {
+        const std::string name(symInfo->Name, symInfo->NameLen);
+
+        if (name.compare(name.length() - c_testMethod.length(), c_testMethod.length(), c_testMethod) == 0)
+        {
+            SSymbol symbol;
+            symbol.m_address = symInfo->Address;
+            symbol.m_name = name.substr(0, name.length() - c_testMethod.length());
+            symbol.m_line = 0;
+
+            IMAGEHLP_LINE64 line;
+            line.SizeOfStruct = sizeof(line);
+            DWORD displacement;
+
+            if (SymGetLineFromAddr64(reinterpret_cast<HANDLE>(symInfo->ModBase), symInfo->Address, &displacement, &line))
+            {
+                symbol.m_file = line.FileName;
+                symbol.m_line = line.LineNumber;
+            }
+
+            static_cast<std::vector<SSymbol>*>(userContext)->push_back(symbol);
+        }
+    }
+
+    return TRUE;
+}
+
+std::vector<SSymbol> ReadTestMethods(const std::string& source)
+{
+    // DbgHelp only maps the image and its program database; any value identifies the symbol handler session
+    // given that no process is attached. The module base serves as handle so that the callback can query lines.
+    const DWORD64 base = 0x10000000;
+    const HANDLE handle = reinterpret_cast<HANDLE>(base);
+
+    if (!SymInitialize(handle, NULL, FALSE))
+    {
+        throw std::runtime_error("Fail to initialize the symbol handler");
+    }
+
+    SymSetOptions(SYMOPT_LOAD_LINES | SYMOPT_UNDNAME);
+
+    std::vector<SSymbol> symbols;
+
+    if (SymLoadModuleEx(handle, NULL, source.c_str(), NULL, base, 0, NULL, 0) == 0)
+    {
+        SymCleanup(handle);
+        throw std::runtime_error("Fail to read the symbols of " + source);
+    }
+
+    SymEnumSymbols(handle, base, "*::test_method", EnumSymbolsCallback, &symbols);
+
+    SymUnloadModule64(handle, base);
+    SymCleanup(handle);
+
+    return symbols;
+}
+
+#else
+
+std::vector<SSymbol> ReadTestMethods(const std::string& source)
+{
+    // Mangled name suffix of the test methods, i.e. '::test_method()'
+    static const std::string c_mangledTestMethod("11test_methodEv");
+
+    const std::vector<SElfSymbol> functions = ReadElfFunctionSymbols(source);
+
+    std::vector<SSymbol> symbols;
+
+    for (auto i = functions.begin(), iend = functions.end(); i != iend; ++i)
+    {
+        const std::string& name = i->m_name;
+
+        if ((name.length() <= c_mangledTestMethod.length()) || (name.compare(0, 2, "_Z") != 0) ||
+            (name.compare(name.length() - c_mangledTestMethod.length(), std::string::npos, c_mangledTestMethod) != 0))
+        {
+            continue;
+        }
+
+        int status = 0;
+        char* const demangled = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+
+        if (demangled == nullptr)
+        {
+            continue;
+        }
+
+        std::string qualified(demangled);
+        std::free(demangled);
+
+        // Strip the trailing '::test_method()'
+        const std::string::size_type end = qualified.rfind(c_testMethod);
+
+        if ((end != std::string::npos) && (end > 0))
+        {
+            SSymbol symbol;
+            symbol.m_address = i->m_address;
+            symbol.m_name = qualified.substr(0, end);
+            symbol.m_line = 0;
+
+            symbols.push_back(symbol);
+        }
+    }
+
+    return symbols;
+}
+
+#endif
+
+} // namespace anonymous
+
+CStaticTestDiscovery::CStaticTestDiscovery(const std::string& source) :
+    m_source(source),
+    m_prettyPrint(true),
+    m_testCaseCount(0)
+{
+    SUnit master;
+    master.m_name = "Master Test Suite";
+    master.m_testCase = false;
+    master.m_line = 0;
+
+    m_units.push_back(master);
+}
+
+CStaticTestDiscovery::~CStaticTestDiscovery()
+{
+}
+
+std::size_t CStaticTestDiscovery::Discover()
+{
+    std::vector<SSymbol> symbols = ReadTestMethods(m_source);
+
+    // Within a translation unit, functions are laid out (and test cases registered) in order of definition
+    std::stable_sort(symbols.begin(), symbols.end(), CompareAddress);
+
+    for (auto i = symbols.begin(), end = symbols.end(); i != end; ++i)
+    {
+        if (!IsLibraryName(i->m_name))
+        {
+            Add(SplitScopes(i->m_name), i->m_file, i->m_line);
+        }
+    }
+
+    return m_testCaseCount;
+}
+
+void CStaticTestDiscovery::Add(const std::vector<std::string>& scopes, const std::string& file, unsigned long line)
+{
+    if (scopes.empty())
+    {
+        return;
+    }
+
+    std::size_t parent = 0;
+
+    for (std::size_t i = 0; i < scopes.size(); ++i)
+    {
+        const bool testCase = ((i + 1) == scopes.size());
+
+        auto child = std::find_if(m_units[parent].m_children.begin(), m_units[parent].m_children.end(), [&](std::size_t unit) {
+            return (m_units[unit].m_name == scopes[i]) && (m_units[unit].m_testCase == testCase);
+        });
+
+        if (child != m_units[parent].m_children.end())
+        {
+            // Symbols of inline test methods may be listed more than once
+            parent = *child;
+            continue;
+        }
+
+        SUnit unit;
+        unit.m_name = scopes[i];
+        unit.m_testCase = testCase;
+        unit.m_file = testCase ? file : std::string();
+        unit.m_line = testCase ? line : 0;
+
+        m_units.push_back(unit);
+        m_units[parent].m_children.push_back(m_units.size() - 1);
+
+        m_testCaseCount += testCase ? 1 : 0;
+        parent = m_units.size() - 1;
+    }
+}
+
+void CStaticTestDiscovery::Write(std::ostream& out) const
+{
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\" ?>";
+
+    if (m_prettyPrint)
+    {
+        out << std::endl;
+    }
+
+    out << "<BoostTestFramework source" << attr_value() << m_source << " static" << attr_value() << "true" << '>';
+
+    if (m_prettyPrint)
+    {
+        out << std::endl;
+    }
+
+    Write(out, 0, 1);
+
+    out << "</BoostTestFramework>";
+
+    if (m_prettyPrint)
+    {
+        out << std::endl;
+    }
+}
+
+void CStaticTestDiscovery::Write(std::ostream& out, std::size_t unit, std::size_t level) const
+{
+    const SUnit& current = m_units[unit];
+
+    const std::string tab = m_prettyPrint ? std::string(level * 4, ' ') : std::string();
+
+    out << tab << (current.m_testCase ? "<TestCase" : "<TestSuite") << " name" << attr_value() << current.m_name;
+
+    if (!current.m_file.empty())
+    {
+        out << " file" << attr_value() << current.m_file <<
+               " line" << attr_value() << current.m_line;
+    }
+
+    out << (current.m_testCase ? " />" : ">");
+
+    if (m_prettyPrint)
+    {
+        out << std::endl;
+    }
+
+    if (current.m_testCase)
+    {
+        return;
+    }
+
+    for (auto i = current.m_children.begin(), end = current.m_children.end(); i != end; ++i)
+    {
+        Write(out, *i, level + 1);
+    }
+
+    out << tab << "</TestSuite>";
+
+    if (m_prettyPrint)
+    {
+        out << std::endl;
+    }
+}
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
@@ -0,0 +1,137 @@
+#if !defined( _CStaticTestDiscovery_H_ )
+#define _CStaticTestDiscovery_H_
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+/**
+ * @brief Rebuilds the test tree of a module from its symbol table, without loading the module.
+ *
+ * Auto-registered test cases (BOOST_AUTO_TEST_CASE, BOOST_FIXTURE_TEST_CASE and their template variants) are
+ * implemented as <c>&lt;suite&gt;::...::&lt;test&gt;::test_method</c> member functions, BOOST_AUTO_TEST_SUITE
+ * being a namespace. The test tree is derived from these symbols: the ELF symbol table (or dynamic symbol table
+ * in case the module is stripped) on POSIX platforms, the module exports and program database via DbgHelp on
+ * Windows. No code of the module is executed, hence static initialization and the initialization function of
+ * the module do not run.
+ *
+ * The result is an approximation of the test tree which the module registers at runtime: test units which are
+ * registered manually or generated at runtime (e.g. data-driven test cases) are not discovered, test unit ids
+ * are not known, the master test suite name is not known and the order of test units is the order of their
+ * symbols rather than the order of registration.
+ */
+class CStaticTestDiscovery :
+    private ::boost::noncopyable
+{
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param[in] source file-path to the exe/dll module which contains a Boost test framework
+     */
+    explicit CStaticTestDiscovery(const std::string& source);
+
+    /**
+     * @brief Destructor
+     */
+    ~CStaticTestDiscovery();
+
+    /**
+     * @brief Getter for the source module file path
+     */
+    const std::string& GetSource() const
+    {
+        return m_source;
+    }
+
+    /**
+     * @brief States whether or not xml pretty printing is enabled
+     */
+    bool GetPrettyPrint() const
+    {
+        return m_prettyPrint;
+    }
+
+    /**
+     * @brief Sets whether or not xml pretty printing is enabled
+     *
+     * @param[in] prettyPrint true to enable pretty print; false to disable pretty printing
+     */
+    void SetPrettyPrint(bool prettyPrint)
+    {
+        m_prettyPrint = prettyPrint;
+    }
+
+    /**
+     * @brief Reads the symbol table of the module and rebuilds the test tree
+     *
+     * @return the number of discovered test cases
+     * @throw std::runtime_error in case the module cannot be read or is not of a supported format
+     */
+    std::size_t Discover();
+
+    /**
+     * @brief Getter for the number of discovered test cases
+     */
+    std::size_t GetTestCaseCount() const
+    {
+        return m_testCaseCount;
+    }
+
+    /**
+     * @brief Writes the discovered test tree in the format of CBoostTestTreeDebugLister (without test unit ids).
+     *        The root element carries a <c>static="true"</c> attribute.
+     *
+     * @param[out] out the stream to write to
+     */
+    void Write(std::ostream& out) const;
+
+private:
+    /**
+     * @brief Node of the discovered test tree
+     */
+    struct SUnit
+    {
+        std::string m_name;
+        bool m_testCase;
+        std::string m_file;
+        unsigned long m_line;
+        std::vector<std::size_t> m_children;    ///< indices of the child test units in m_units
+    };
+
+    /**
+     * @brief Adds an auto-registered test case to the test tree
+     *
+     * @param[in] scopes the qualified name of the test case, split into its scopes (i.e. test suite names followed by the test case name)
+     * @param[in] file the source file of the test case; empty in case it is unknown
+     * @param[in] line the source line of the test case
+     */
+    void Add(const std::vector<std::string>& scopes, const std::string& file, unsigned long line);
+
+    /**
+     * @brief Writes a test unit and its children
+     */
+    void Write(std::ostream& out, std::size_t unit, std::size_t level) const;
+
+    std::string m_source;
+    bool m_prettyPrint;
+
+    std::vector<SUnit> m_units;                 ///< test tree; the master test suite being the first element
+    std::size_t m_testCaseCount;
+};
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
+
+#endif // _CStaticTestDiscovery_H_
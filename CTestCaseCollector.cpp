@@ -0,0 +1,61 @@
+#include "CTestCaseCollector.h"
+
+//suppression of warnings related to 3rd party files
+#pragma warning ( disable: 6001 )
+#pragma warning ( disable: 6031 )
+
+#include <boost/test/framework.hpp>
+#include <boost/test/tree/test_unit.hpp>
+
+//end suppression of warnings related to 3rd party files
+#pragma warning ( default: 6001 )
+#pragma warning ( default: 6031 )
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+CTestCaseCollector::CTestCaseCollector(bool enabledOnly) :
+    m_enabledOnly(enabledOnly)
+{
+}
+
+CTestCaseCollector::~CTestCaseCollector()
+{
+}
+
+void CTestCaseCollector::visit(const ::boost::unit_test::test_case& testCase)
+{
+    if (!m_enabledOnly || testCase.is_enabled())
+    {
+        m_testCases.push_back(&testCase);
+    }
+}
+
+bool CTestCaseCollector::test_suite_start(const ::boost::unit_test::test_suite& testSuite)
+{
+    return !m_enabledOnly || testSuite.is_enabled();
+}
+
+void CTestCaseCollector::Remove(const TTestCases& testCases)
+{
+    for (auto i = testCases.begin(), end = testCases.end(); i != end; ++i)
+    {
+        ::boost::unit_test::framework::get<::boost::unit_test::test_suite>((*i)->p_parent_id).remove((*i)->p_id);
+    }
+}
+
+void CTestCaseCollector::Disable(const TTestCases& testCases)
+{
+    for (auto i = testCases.begin(), end = testCases.end(); i != end; ++i)
+    {
+        const_cast<::boost::unit_test::test_case*>(*i)->p_default_status.set(::boost::unit_test::test_unit::RS_DISABLED);
+    }
+}
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
@@ -0,0 +1,84 @@
+#if !defined( _CTestCaseCollector_H_ )
+#define _CTestCaseCollector_H_
+
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+#include <boost/test/tree/visitor.hpp>
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+/**
+ * @brief Boost test_tree_visitor implementation which collects the enabled test cases of the test tree
+ *        in traversal (i.e. execution) order
+ */
+class CTestCaseCollector :
+    public ::boost::unit_test::test_tree_visitor,
+    private ::boost::noncopyable
+{
+public:
+    typedef ::boost::unit_test::test_tree_visitor TBase;
+
+    typedef const ::boost::unit_test::test_case* TConstTestCasePtr;
+    typedef std::vector<TConstTestCasePtr> TTestCases;
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] enabledOnly true to only collect enabled test cases; false to collect all traversed test cases
+     */
+    explicit CTestCaseCollector(bool enabledOnly = true);
+
+    /**
+     * @brief Destructor
+     */
+    virtual ~CTestCaseCollector();
+
+    // test tree visitor interface
+
+    /**
+     * @brief Visitor method for a Boost test case. Collects the test case (in case it is enabled).
+     */
+    virtual void visit(const ::boost::unit_test::test_case& testCase) override;
+
+    /**
+     * @brief Visitor method for the start of a Boost test suite. Only enabled test suites are traversed (in case
+     *        only enabled test cases are collected).
+     */
+    virtual bool test_suite_start(const ::boost::unit_test::test_suite& testSuite) override;
+
+    /**
+     * @brief Getter for the collected test cases
+     */
+    const TTestCases& GetTestCases() const
+    {
+        return m_testCases;
+    }
+
+    /**
+     * @brief Removes the provided test cases from the test tree, i.e. from their parent test suites
+     */
+    static void Remove(const TTestCases& testCases);
+
+    /**
+     * @brief Disables the provided test cases by default, i.e. keeps them in the test tree (so that dependencies on them
+     *        can still be resolved) but excludes them from execution. Needs to be called before the Boost UTF finalizes the setup phase.
+     */
+    static void Disable(const TTestCases& testCases);
+
+private:
+    bool m_enabledOnly;
+
+    TTestCases m_testCases;
+};
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
+
+#endif // _CTestCaseCollector_H_
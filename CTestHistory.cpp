@@ -0,0 +1,723 @@
+#include "CTestHistory.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <stdexcept>
+
+#include <boost/config.hpp>
+
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32)
+#include <io.h>
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+//suppression of warnings related to 3rd party files
+#pragma warning ( disable: 6001 )
+#pragma warning ( disable: 6031 )
+
+#include <boost/test/utils/xml_printer.hpp>
+
+//end suppression of warnings related to 3rd party files
+#pragma warning ( default: 6001 )
+#pragma warning ( default: 6031 )
+
+#include "FileReplacement.h"
+#include "TestUnitPath.h"
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+namespace
+{
+
+// Utility function which is used to simply avoid writing '::boost::unit_test::attr_value()'
+::boost::unit_test::attr_value attr_value()
+{
+    return ::boost::unit_test::attr_value();
+};
+
+// Characters denoting the outcomes of the recent runs within reports, indexed by ETestOutcome
+const char c_outcomeSymbols[c_testOutcomeCount] = { '.', 'F', 'A', 'S', 'T', '~', 'R' };
+
+template <typename T>
+void AppendRecord(std::string& out, const T& record)
+{
+    out.append(reinterpret_cast<const char*>(&record), sizeof(record));
+}
+
+template <typename T>
+T ReadRecord(const char* data)
+{
+    // Records are not necessarily aligned within the file
+    T record;
+    std::memcpy(&record, data, sizeof(record));
+    return record;
+}
+
+void AppendBlock(std::string& out, ETestHistoryBlockType type, std::size_t count, std::uint64_t time, const std::string& records)
+{
+    STestHistoryBlock block;
+    block.m_type = type;
+    block.m_count = static_cast<std::uint32_t>(count);
+    block.m_size = static_cast<std::uint32_t>(records.size());
+    block.m_reserved = 0;
+    block.m_time = time;
+
+    AppendRecord(out, block);
+    out += records;
+}
+
+std::string GetPathRecords(const std::vector<std::string>& paths)
+{
+    std::string records;
+
+    for (auto i = paths.begin(), end = paths.end(); i != end; ++i)
+    {
+        STestHistoryPath path;
+        path.m_pathHash = HashTestUnitPath(*i);
+        path.m_length = static_cast<std::uint32_t>(i->length());
+        path.m_reserved = 0;
+
+        AppendRecord(records, path);
+        records += *i;
+    }
+
+    return records;
+}
+
+std::string GetHeader()
+{
+    STestHistoryHeader header;
+    std::memcpy(header.m_magic, c_testHistoryMagic, sizeof(header.m_magic));
+    header.m_version = c_testHistoryVersion;
+
+    std::string out;
+    AppendRecord(out, header);
+
+    return out;
+}
+
+void Truncate(std::FILE* file, std::uint64_t size)
+{
+    std::fflush(file);
+
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32)
+    _chsize_s(_fileno(file), static_cast<__int64>(size));
+#else
+    if (ftruncate(fileno(file), static_cast<off_t>(size)) != 0)
+    {
+        // The incomplete block is overwritten (in part) and remains to be ignored
+    }
+#endif
+}
+
+void Commit(std::FILE* file)
+{
+    std::fflush(file);
+
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32)
+    _commit(_fileno(file));
+#else
+    fsync(fileno(file));
+#endif
+}
+
+/**
+ * @brief Replaces a file by another one in a single step, i.e. the target file is never missing
+ * @return true on success
+ */
+/**
+ * @brief Exclusive lock serializing the access of test runner processes to a test history file.
+ *
+ * The lock is held on a separate lock file (the history file path with ".lock" appended) since compaction replaces
+ * the history file as a whole, which would leave a lock held on the replaced file ineffective.
+ */
+class CFileLock :
+    private ::boost::noncopyable
+{
+public:
+    explicit CFileLock(const std::string& file)
+    {
+        const std::string lockFile = file + ".lock";
+
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32)
+        m_handle = ::CreateFileA(lockFile.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+            nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        OVERLAPPED overlapped = OVERLAPPED();
+
+        if ((m_handle != INVALID_HANDLE_VALUE) && !::LockFileEx(m_handle, LOCKFILE_EXCLUSIVE_LOCK, 0, MAXDWORD, MAXDWORD, &overlapped))
+        {
+            ::CloseHandle(m_handle);
+            m_handle = INVALID_HANDLE_VALUE;
+        }
+#else
+        m_fd = open(lockFile.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+
+        int result = -1;
+
+        while ((m_fd >= 0) && ((result = flock(m_fd, LOCK_EX)) != 0) && (errno == EINTR))
+        {
+        }
+
+        if ((m_fd >= 0) && (result != 0))
+        {
+            close(m_fd);
+            m_fd = -1;
+        }
+#endif
+        // Failing to lock (e.g. within a read-only directory) does not prevent accessing the history; the access is merely not serialized
+    }
+
+    ~CFileLock()
+    {
+        // Closing the lock file releases the lock
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32)
+        if (m_handle != INVALID_HANDLE_VALUE)
+        {
+            ::CloseHandle(m_handle);
+        }
+#else
+        if (m_fd >= 0)
+        {
+            close(m_fd);
+        }
+#endif
+    }
+
+private:
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32)
+    HANDLE m_handle;
+#else
+    int m_fd;
+#endif
+};
+
+/**
+ * @brief Determines the size of a test history file up to the end of its last complete block by scanning the block headers
+ *
+ * @param[in] file the history file, opened for reading
+ * @param[out] validSize the size up to the end of the last complete block; 0 in case the file is empty
+ * @return false in case the file is not a test history
+ */
+bool GetValidSize(std::FILE* file, std::uint64_t& validSize)
+{
+    validSize = 0;
+
+    std::fseek(file, 0, SEEK_END);
+    const long size = std::ftell(file);
+
+    if (size <= 0)
+    {
+        return (size == 0);
+    }
+
+    char data[sizeof(STestHistoryBlock)];
+    std::fseek(file, 0, SEEK_SET);
+
+    if ((static_cast<std::size_t>(size) < sizeof(STestHistoryHeader)) || (std::fread(data, sizeof(STestHistoryHeader), 1, file) != 1) ||
+        (std::memcmp(ReadRecord<STestHistoryHeader>(data).m_magic, c_testHistoryMagic, sizeof(c_testHistoryMagic)) != 0))
+    {
+        return false;
+    }
+
+    std::uint64_t offset = sizeof(STestHistoryHeader);
+
+    while (((static_cast<std::uint64_t>(size) - offset) >= sizeof(STestHistoryBlock)) && (std::fread(data, sizeof(data), 1, file) == 1))
+    {
+        const STestHistoryBlock block = ReadRecord<STestHistoryBlock>(data);
+
+        if ((static_cast<std::uint64_t>(size) - offset - sizeof(STestHistoryBlock)) < block.m_size)
+        {
+            // Incomplete trailing block
+            break;
+        }
+
+        offset += sizeof(STestHistoryBlock) + block.m_size;
+        std::fseek(file, static_cast<long>(offset), SEEK_SET);
+    }
+
+    validSize = offset;
+    return true;
+}
+
+} // namespace anonymous
+
+CTestHistory::CTestHistory(const std::string& file, std::size_t keep) :
+    m_file(file),
+    m_keep(keep),
+    m_validSize(0),
+    m_runTime(0)
+{
+}
+
+CTestHistory::~CTestHistory()
+{
+}
+
+void CTestHistory::Load()
+{
+    CFileLock lock(m_file);
+    Read();
+}
+
+void CTestHistory::Read()
+{
+    m_index.clear();
+    m_paths.clear();
+    m_runTimes.clear();
+    m_validSize = 0;
+
+    std::ifstream in(m_file, std::ios_base::in | std::ios_base::binary);
+
+    if (!in)
+    {
+        return;
+    }
+
+    // Read the file at once; parsing in memory is considerably faster than reading record by record
+    in.seekg(0, std::ios_base::end);
+    const std::size_t size = static_cast<std::size_t>(in.tellg());
+    in.seekg(0, std::ios_base::beg);
+
+    std::vector<char> data(size);
+
+    if ((size > 0) && !in.read(&data[0], size))
+    {
+        throw std::runtime_error("Fail to read test history: " + m_file);
+    }
+
+    if (size == 0)
+    {
+        return;
+    }
+
+    const STestHistoryHeader header = (size >= sizeof(STestHistoryHeader)) ? ReadRecord<STestHistoryHeader>(&data[0]) : STestHistoryHeader();
+
+    if ((size < sizeof(STestHistoryHeader)) || (std::memcmp(header.m_magic, c_testHistoryMagic, sizeof(header.m_magic)) != 0))
+    {
+        throw std::runtime_error("Not a test history: " + m_file);
+    }
+
+    if ((header.m_version == 0) || (header.m_version > c_testHistoryVersion))
+    {
+        throw std::runtime_error("Unsupported test history version: " + m_file);
+    }
+
+    std::vector<STestHistoryResult> results;
+    std::size_t offset = sizeof(STestHistoryHeader);
+
+    while ((size - offset) >= sizeof(STestHistoryBlock))
+    {
+        const STestHistoryBlock block = ReadRecord<STestHistoryBlock>(&data[offset]);
+
+        if ((size - offset - sizeof(STestHistoryBlock)) < block.m_size)
+        {
+            // Incomplete trailing block
+            break;
+        }
+
+        const char* records = &data[offset + sizeof(STestHistoryBlock)];
+        const char* const recordsEnd = records + block.m_size;
+
+        switch (block.m_type)
+        {
+        case TestHistoryPaths:
+            for (std::uint32_t i = 0; i < block.m_count; ++i)
+            {
+                if (static_cast<std::size_t>(recordsEnd - records) < sizeof(STestHistoryPath))
+                {
+                    throw std::runtime_error("Malformed test history: " + m_file);
+                }
+
+                const STestHistoryPath path = ReadRecord<STestHistoryPath>(records);
+                records += sizeof(STestHistoryPath);
+
+                if (static_cast<std::size_t>(recordsEnd - records) < path.m_length)
+                {
+                    throw std::runtime_error("Malformed test history: " + m_file);
+                }
+
+                m_paths[path.m_pathHash].assign(records, path.m_length);
+                records += path.m_length;
+            }
+            break;
+
+        case TestHistoryRun:
+            if (block.m_size != (block.m_count * sizeof(STestHistoryResult)))
+            {
+                throw std::runtime_error("Malformed test history: " + m_file);
+            }
+
+            results.resize(block.m_count);
+
+            if (block.m_count > 0)
+            {
+                std::memcpy(&results[0], records, block.m_size);
+            }
+
+            AddRun(block.m_time, results.empty() ? nullptr : &results[0], results.size());
+            break;
+
+        case TestHistorySummary:
+        {
+            // Version 1 summaries lack the outcomes introduced since
+            const std::size_t summarySize = (header.m_version == 1) ? c_testHistorySummarySizeV1 : sizeof(STestHistorySummary);
+            const std::size_t outcomeCount = (header.m_version == 1) ? c_testOutcomeCountV1 : c_testOutcomeCount;
+
+            if (block.m_size != (block.m_count * summarySize))
+            {
+                throw std::runtime_error("Malformed test history: " + m_file);
+            }
+
+            m_index.reserve(m_index.size() + block.m_count);
+
+            for (std::uint32_t i = 0; i < block.m_count; ++i)
+            {
+                STestHistorySummary summary = STestHistorySummary();
+                std::memcpy(&summary, records + (i * summarySize), summarySize);
+
+                SEntry& entry = m_index[summary.m_pathHash];
+
+                for (std::size_t j = 0; j < outcomeCount; ++j)
+                {
+                    entry.m_outcomes[j] += summary.m_outcomes[j];
+                }
+
+                entry.m_elapsed += summary.m_elapsed;
+            }
+            break;
+        }
+
+        default:
+            // Blocks of unknown type are skipped
+            break;
+        }
+
+        offset += sizeof(STestHistoryBlock) + block.m_size;
+    }
+
+    m_validSize = offset;
+}
+
+void CTestHistory::Compact()
+{
+    CFileLock lock(m_file);
+
+    // Other test runner processes may have appended to the history since it was loaded
+    Read();
+
+    const std::size_t compacted = (m_runTimes.size() > m_keep) ? (m_runTimes.size() - m_keep) : 0;
+
+    // Fold the results of the compacted runs into summaries
+    std::string summaries;
+    std::size_t summaryCount = 0;
+
+    std::vector<std::string> paths;
+    paths.reserve(m_paths.size());
+
+    std::vector<std::vector<STestHistoryResult> > runs(m_runTimes.size() - compacted);
+
+    for (auto i = m_index.begin(), end = m_index.end(); i != end; ++i)
+    {
+        STestHistorySummary summary;
+        summary.m_pathHash = i->first;
+        summary.m_elapsed = i->second.m_elapsed;
+        summary.m_reserved = 0;
+        std::copy(i->second.m_outcomes, i->second.m_outcomes + c_testOutcomeCount, summary.m_outcomes);
+
+        std::vector<SRunResult> recent;
+
+        for (auto j = i->second.m_recent.begin(), jend = i->second.m_recent.end(); j != jend; ++j)
+        {
+            if (j->m_run < compacted)
+            {
+                continue;
+            }
+
+            // Results of the kept runs are written as runs rather than as part of the summary
+            --summary.m_outcomes[j->m_outcome];
+            summary.m_elapsed -= j->m_elapsed;
+
+            STestHistoryResult result;
+            result.m_pathHash = i->first;
+            result.m_elapsed = j->m_elapsed;
+            result.m_outcome = j->m_outcome;
+
+            runs[j->m_run - compacted].push_back(result);
+
+            SRunResult kept = *j;
+            kept.m_run = static_cast<std::uint32_t>(j->m_run - compacted);
+            recent.push_back(kept);
+        }
+
+        i->second.m_recent.swap(recent);
+
+        if (std::find_if(summary.m_outcomes, summary.m_outcomes + c_testOutcomeCount, [](std::uint32_t count) { return count > 0; }) != (summary.m_outcomes + c_testOutcomeCount))
+        {
+            AppendRecord(summaries, summary);
+            ++summaryCount;
+        }
+    }
+
+    for (auto i = m_paths.begin(), end = m_paths.end(); i != end; ++i)
+    {
+        paths.push_back(i->second);
+    }
+
+    std::string content = GetHeader();
+
+    AppendBlock(content, TestHistoryPaths, paths.size(), 0, GetPathRecords(paths));
+    AppendBlock(content, TestHistorySummary, summaryCount, 0, summaries);
+
+    for (std::size_t i = 0; i < runs.size(); ++i)
+    {
+        std::string records;
+
+        for (auto j = runs[i].begin(), end = runs[i].end(); j != end; ++j)
+        {
+            AppendRecord(records, *j);
+        }
+
+        AppendBlock(content, TestHistoryRun, runs[i].size(), m_runTimes[compacted + i], records);
+    }
+
+    m_runTimes.erase(m_runTimes.begin(), m_runTimes.begin() + compacted);
+
+    // Replace the file as a whole so that it is never left partially written
+    const std::string temporary = m_file + ".tmp";
+
+    {
+        std::FILE* file = std::fopen(temporary.c_str(), "wb");
+
+        if (file == nullptr)
+        {
+            throw std::runtime_error("Fail to write test history: " + temporary);
+        }
+
+        const bool written = (std::fwrite(content.data(), 1, content.size(), file) == content.size());
+
+        // The content must reach the disk before the file is replaced, lest a crash leaves an empty history behind
+        Commit(file);
+
+        if ((std::fclose(file) != 0) || !written)
+        {
+            throw std::runtime_error("Fail to write test history: " + temporary);
+        }
+    }
+
+    if (!ReplaceFileWith(m_file, temporary))
+    {
+        throw std::runtime_error("Fail to write test history: " + m_file);
+    }
+
+    m_validSize = content.size();
+}
+
+const CTestHistory::SEntry* CTestHistory::Find(const std::string& path) const
+{
+    TIndex::const_iterator entry = m_index.find(HashTestUnitPath(path));
+    return (entry != m_index.end()) ? &entry->second : nullptr;
+}
+
+std::string CTestHistory::GetPath(std::uint64_t pathHash) const
+{
+    auto path = m_paths.find(pathHash);
+    return (path != m_paths.end()) ? path->second : std::string();
+}
+
+void CTestHistory::WriteReport(std::ostream& out, const std::string& filter) const
+{
+    // Order the test cases by path
+    std::map<std::string, const SEntry*> entries;
+
+    for (auto i = m_index.begin(), end = m_index.end(); i != end; ++i)
+    {
+        std::string path = GetPath(i->first);
+
+        if (filter.empty() || (path == filter) || ((path.compare(0, filter.length(), filter) == 0) && (path[filter.length()] == '/')))
+        {
+            entries[path] = &i->second;
+        }
+    }
+
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\" ?>" << std::endl
+        << "<TestHistory source" << attr_value() << m_file << " runs" << attr_value() << m_runTimes.size() << '>' << std::endl;
+
+    for (auto i = entries.begin(), end = entries.end(); i != end; ++i)
+    {
+        const SEntry& entry = *i->second;
+
+        std::string recent(m_runTimes.size(), ' ');
+
+        for (auto j = entry.m_recent.begin(), jend = entry.m_recent.end(); j != jend; ++j)
+        {
+            recent[j->m_run] = c_outcomeSymbols[j->m_outcome];
+        }
+
+        const std::uint32_t executions = entry.GetExecutions();
+
+        out << "    <TestCase path" << attr_value() << i->first;
+
+        for (std::size_t j = 0; j < c_testOutcomeCount; ++j)
+        {
+            out << ' ' << GetOutcomeName(static_cast<ETestOutcome>(j)) << attr_value() << entry.m_outcomes[j];
+        }
+
+        out << " meanElapsed" << attr_value() << ((executions > 0) ? (entry.m_elapsed / executions) : 0) <<
+               " recent" << attr_value() << recent << " />" << std::endl;
+    }
+
+    out << "</TestHistory>" << std::endl;
+}
+
+void CTestHistory::OnRunStart()
+{
+    m_runTime = static_cast<std::uint64_t>(std::time(nullptr));
+    m_pending.clear();
+    m_newPaths.clear();
+}
+
+void CTestHistory::OnTestCaseFinished(const STestCaseResult& result)
+{
+    STestHistoryResult record;
+    record.m_pathHash = HashTestUnitPath(result.m_path);
+    record.m_elapsed = static_cast<std::uint32_t>(std::min<unsigned long>(result.m_elapsed, std::numeric_limits<std::uint32_t>::max()));
+    record.m_outcome = result.m_outcome;
+
+    if (m_paths.insert(std::make_pair(record.m_pathHash, result.m_path)).second)
+    {
+        m_newPaths.push_back(result.m_path);
+    }
+
+    m_pending.push_back(record);
+}
+
+void CTestHistory::OnRunFinish()
+{
+    if (m_pending.empty())
+    {
+        return;
+    }
+
+    std::string blocks;
+
+    if (!m_newPaths.empty())
+    {
+        AppendBlock(blocks, TestHistoryPaths, m_newPaths.size(), 0, GetPathRecords(m_newPaths));
+    }
+
+    std::string records;
+    records.reserve(m_pending.size() * sizeof(STestHistoryResult));
+
+    for (auto i = m_pending.begin(), end = m_pending.end(); i != end; ++i)
+    {
+        AppendRecord(records, *i);
+    }
+
+    AppendBlock(blocks, TestHistoryRun, m_pending.size(), m_runTime, records);
+
+    Append(blocks);
+    AddRun(m_runTime, &m_pending[0], m_pending.size());
+
+    m_pending.clear();
+    m_newPaths.clear();
+
+    if (m_runTimes.size() >= std::max<std::size_t>(2 * m_keep, 1))
+    {
+        try
+        {
+            Compact();
+        }
+        catch (const std::runtime_error&)
+        {
+            // The history remains valid (if not compact); compaction is attempted again after the next run
+        }
+    }
+}
+
+void CTestHistory::AddRun(std::uint64_t time, const STestHistoryResult* results, std::size_t count)
+{
+    SRunResult result;
+    result.m_run = static_cast<std::uint32_t>(m_runTimes.size());
+
+    m_runTimes.push_back(time);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (results[i].m_outcome >= c_testOutcomeCount)
+        {
+            continue;
+        }
+
+        SEntry& entry = m_index[results[i].m_pathHash];
+
+        result.m_elapsed = results[i].m_elapsed;
+        result.m_outcome = static_cast<ETestOutcome>(results[i].m_outcome);
+
+        ++entry.m_outcomes[result.m_outcome];
+        entry.m_elapsed += result.m_elapsed;
+        entry.m_recent.push_back(result);
+    }
+}
+
+void CTestHistory::Append(const std::string& blocks)
+{
+    CFileLock lock(m_file);
+
+    std::FILE* file = std::fopen(m_file.c_str(), "r+b");
+
+    if (file == nullptr)
+    {
+        file = std::fopen(m_file.c_str(), "w+b");
+
+        if (file == nullptr)
+        {
+            return;
+        }
+    }
+
+    // Other test runner processes may have appended to (or compacted) the history since it was loaded
+    if (!GetValidSize(file, m_validSize))
+    {
+        std::fclose(file);
+        return;
+    }
+
+    if (m_validSize == 0)
+    {
+        const std::string header = GetHeader();
+        std::fwrite(header.data(), 1, header.size(), file);
+        m_validSize = header.size();
+    }
+
+    // Replace any incomplete trailing block
+    Truncate(file, m_validSize);
+    std::fseek(file, static_cast<long>(m_validSize), SEEK_SET);
+
+    if (std::fwrite(blocks.data(), 1, blocks.size(), file) == blocks.size())
+    {
+        m_validSize += blocks.size();
+    }
+
+    Commit(file);
+    std::fclose(file);
+}
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
@@ -0,0 +1,283 @@
+#if !defined( _CTestHistory_H_ )
+#define _CTestHistory_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include "TestCaseResult.h"
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+/**
+ * @brief Layout of the test history file (version 2) as maintained by CTestHistory.
+ *
+ * The file consists of a header followed by blocks, each of which is a STestHistoryBlock followed by its records.
+ * Blocks are only ever appended, except by compaction which rewrites the file as a whole. A trailing block which is
+ * incomplete (e.g. because the writing process was terminated) is ignored and replaced by the next append. All values
+ * are stored in the byte order of the writing machine.
+ *
+ * - TestHistoryPaths blocks introduce test case paths: STestHistoryPath records, each followed by the path characters
+ * - TestHistoryRun blocks hold the results of a single test run: STestHistoryResult records
+ * - TestHistorySummary blocks hold the accumulated results of compacted test runs: STestHistorySummary records
+ */
+const char c_testHistoryMagic[4] = { 'B', 'E', 'T', 'H' };
+
+/**
+ * @brief Current version of the test history layout
+ */
+const std::uint32_t c_testHistoryVersion = 2;
+
+/**
+ * @brief Number of distinct test outcomes (see ETestOutcome)
+ */
+const std::size_t c_testOutcomeCount = OutcomeResourceLimit + 1;
+
+/**
+ * @brief Number of outcomes recorded by STestHistorySummary records of version 1 files, which predate OutcomeResourceLimit
+ */
+const std::size_t c_testOutcomeCountV1 = OutcomeFlaky + 1;
+
+struct STestHistoryHeader
+{
+    char m_magic[4];
+    std::uint32_t m_version;
+};
+
+enum ETestHistoryBlockType
+{
+    TestHistoryPaths = 1,
+    TestHistoryRun = 2,
+    TestHistorySummary = 3
+};
+
+struct STestHistoryBlock
+{
+    std::uint32_t m_type;                   ///< ETestHistoryBlockType
+    std::uint32_t m_count;                  ///< number of records
+    std::uint32_t m_size;                   ///< size of the records in bytes
+    std::uint32_t m_reserved;
+    std::uint64_t m_time;                   ///< start of the test run in seconds since the epoch (TestHistoryRun only)
+};
+
+struct STestHistoryPath
+{
+    std::uint64_t m_pathHash;               ///< HashTestUnitPath of the path
+    std::uint32_t m_length;                 ///< number of path characters following the record
+    std::uint32_t m_reserved;
+};
+
+struct STestHistoryResult
+{
+    std::uint64_t m_pathHash;               ///< HashTestUnitPath of the test case path
+    std::uint32_t m_elapsed;                ///< elapsed execution time in microseconds (saturated)
+    std::uint32_t m_outcome;                ///< ETestOutcome
+};
+
+struct STestHistorySummary
+{
+    std::uint64_t m_pathHash;               ///< HashTestUnitPath of the test case path
+    std::uint64_t m_elapsed;                ///< total elapsed execution time in microseconds
+    std::uint32_t m_outcomes[c_testOutcomeCount];   ///< number of runs per outcome, indexed by ETestOutcome
+    std::uint32_t m_reserved;
+};
+
+static_assert(sizeof(STestHistoryHeader) == 8, "test history header layout");
+static_assert(sizeof(STestHistoryBlock) == 24, "test history block layout");
+static_assert(sizeof(STestHistoryPath) == 16, "test history path layout");
+static_assert(sizeof(STestHistoryResult) == 16, "test history result layout");
+static_assert(sizeof(STestHistorySummary) == 48, "test history summary layout");
+
+/**
+ * @brief Size of STestHistorySummary records of version 1 files
+ */
+const std::size_t c_testHistorySummarySizeV1 = 40;
+
+/**
+ * @brief ITestResultListener implementation which records the results of each test run in a local,
+ *        append-only history file and provides an in-memory index of the recorded history per test case.
+ *
+ * The results of a run are appended as a single block once the run finishes. Once the number of recorded
+ * runs reaches twice the amount of runs to keep, the history is compacted: the results of all but the most
+ * recent runs are folded into per test case summaries. Accesses to the history file are serialized by an exclusive
+ * lock on a lock file alongside (the history file path with ".lock" appended), so that several test runner processes
+ * may record to the same history.
+ */
+class CTestHistory :
+    public ITestResultListener,
+    private ::boost::noncopyable
+{
+public:
+    /**
+     * @brief Result of a test case in a run which is not compacted yet
+     */
+    struct SRunResult
+    {
+        std::uint32_t m_run;                ///< index of the run amongst the runs which are not compacted
+        std::uint32_t m_elapsed;            ///< elapsed execution time in microseconds
+        ETestOutcome m_outcome;             ///< outcome
+    };
+
+    /**
+     * @brief Recorded history of a single test case
+     */
+    struct SEntry
+    {
+        SEntry() :
+            m_elapsed(0)
+        {
+            for (std::size_t i = 0; i < c_testOutcomeCount; ++i)
+            {
+                m_outcomes[i] = 0;
+            }
+        };
+
+        /**
+         * @brief Getter for the number of runs in which the test case was executed, i.e. not skipped
+         */
+        std::uint32_t GetExecutions() const
+        {
+            std::uint32_t executions = 0;
+
+            for (std::size_t i = 0; i < c_testOutcomeCount; ++i)
+            {
+                executions += (i != OutcomeSkipped) ? m_outcomes[i] : 0;
+            }
+
+            return executions;
+        }
+
+        std::uint32_t m_outcomes[c_testOutcomeCount];   ///< number of runs per outcome (including compacted runs), indexed by ETestOutcome
+        std::uint64_t m_elapsed;                        ///< total elapsed execution time in microseconds (including compacted runs)
+        std::vector<SRunResult> m_recent;               ///< results of the runs which are not compacted yet, oldest first
+    };
+
+    typedef std::unordered_map<std::uint64_t, SEntry> TIndex;
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] file file-path of the history file
+     * @param[in] keep number of most recent runs whose individual results are kept by compaction
+     */
+    CTestHistory(const std::string& file, std::size_t keep);
+
+    /**
+     * @brief Destructor
+     */
+    virtual ~CTestHistory();
+
+    /**
+     * @brief Loads the history file and builds the index. A missing file is equivalent to an empty history.
+     *
+     * @throw std::runtime_error in case the file is not a test history of a supported version
+     */
+    void Load();
+
+    /**
+     * @brief Reloads the history file, folds the results of all but the most recent runs into per test case summaries
+     *        and rewrites the history file
+     *
+     * @throw std::runtime_error in case the file cannot be written
+     */
+    void Compact();
+
+    /**
+     * @brief Getter for the index of the recorded history, keyed by HashTestUnitPath of the test case path
+     */
+    const TIndex& GetIndex() const
+    {
+        return m_index;
+    }
+
+    /**
+     * @brief Looks up the recorded history of a test case
+     *
+     * @param[in] path the test case path as returned by GetTestUnitPath
+     * @return the recorded history; nullptr in case there is none
+     */
+    const SEntry* Find(const std::string& path) const;
+
+    /**
+     * @brief Resolves the path of a test case
+     *
+     * @param[in] pathHash HashTestUnitPath of the test case path
+     * @return the path; an empty string in case it is unknown
+     */
+    std::string GetPath(std::uint64_t pathHash) const;
+
+    /**
+     * @brief Getter for the start times (seconds since the epoch) of the runs which are not compacted yet, oldest first
+     */
+    const std::vector<std::uint64_t>& GetRunTimes() const
+    {
+        return m_runTimes;
+    }
+
+    /**
+     * @brief Writes the recorded history as XML document: one TestCase element per test case, stating the number of runs per
+     *        outcome, the mean elapsed time of the executions and the outcomes of the runs which are not compacted yet
+     *        (oldest first; '.' passed, 'F' failed, 'A' aborted, 'S' skipped, 'T' timeout, '~' flaky, 'R' resource limit,
+     *        ' ' not reported)
+     *
+     * @param[out] out the stream to write to
+     * @param[in] filter optional test unit path; only the history of the test case or of the test cases of the test suite is written
+     */
+    void WriteReport(std::ostream& out, const std::string& filter = std::string()) const;
+
+    // test result listener interface
+
+    virtual void OnRunStart() override;
+    virtual void OnTestCaseFinished(const STestCaseResult& result) override;
+
+    /**
+     * @brief Appends the results of the run to the history file and compacts the history if due
+     */
+    virtual void OnRunFinish() override;
+
+private:
+    /**
+     * @brief Loads the history file without locking it
+     */
+    void Read();
+
+    /**
+     * @brief Adds a run to the index
+     */
+    void AddRun(std::uint64_t time, const STestHistoryResult* results, std::size_t count);
+
+    /**
+     * @brief Appends blocks to the history file, replacing any incomplete trailing block. Blocks appended by other test
+     *        runner processes since the history was loaded are retained.
+     */
+    void Append(const std::string& blocks);
+
+    std::string m_file;
+    std::size_t m_keep;
+
+    TIndex m_index;
+    std::unordered_map<std::uint64_t, std::string> m_paths;
+    std::vector<std::uint64_t> m_runTimes;
+
+    std::uint64_t m_validSize;              ///< size of the history file up to the end of the last complete block
+
+    std::uint64_t m_runTime;
+    std::vector<STestHistoryResult> m_pending;
+    std::vector<std::string> m_newPaths;
+};
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
+
+#endif // _CTestHistory_H_
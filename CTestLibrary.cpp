@@ -0,0 +1,210 @@
+#include "CTestLibrary.h"
+
+#include <stdexcept>
+
+#include <boost/config.hpp>
+
+// System headers are included ahead of the dyn_lib namespace so that they are not declared within it
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#elif defined(BOOST_HAS_UNISTD_H)
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#endif
+
+//_________________________________________________________________//
+
+// System API
+
+namespace dyn_lib
+{
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32) // WIN32 API
+
+#include <windows.h>
+
+typedef HINSTANCE handle;
+
+/**
+@brief Loads a dll library on the Windows OS
+*/
+inline handle
+open(std::string const& file_name)
+{
+    return LoadLibrary(file_name.c_str());
+}
+
+//_________________________________________________________________//
+
+/**
+@brief Locates a method inside the loaded library on the Windows OS. The method needs to have C style interface. In case of troubles at this step it is
+suggested the use of dependency walker (http://www.dependencywalker.com/) so that it is made sure that the mangling used when generating
+the dll has been of correct type.
+*/
+template<typename TargType>
+inline TargType
+locate_symbol(handle h, std::string const& symbol)
+{
+    return reinterpret_cast<TargType>(GetProcAddress(h, symbol.c_str()));
+}
+
+//_________________________________________________________________//
+
+/**
+@brief  Unloads a library on the Windows OS
+*/
+inline void
+close(handle h)
+{
+    if (h)
+    {
+        FreeLibrary(h);
+    }
+}
+
+//_________________________________________________________________//
+
+inline std::string
+error()
+{
+    LPTSTR msg = NULL;
+
+    FormatMessage(FORMAT_MESSAGE_ALLOCATE_BUFFER | FORMAT_MESSAGE_FROM_SYSTEM,
+                  NULL,
+                  GetLastError(),
+                  MAKELANGID(LANG_NEUTRAL, SUBLANG_DEFAULT),
+                  (LPTSTR)&msg,
+                  0, NULL);
+
+    std::string res;
+
+    if (msg)
+    {
+        res = msg;
+        LocalFree(msg);
+    }
+
+    return res;
+}
+
+//_________________________________________________________________//
+
+#elif defined(BOOST_HAS_UNISTD_H) // POSIX API
+
+#include <dlfcn.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+
+typedef void* handle;
+
+/**
+*   @brief Loads a dll library on a POSIX run-time environment
+*/
+inline handle
+open(std::string const& file_name)
+{
+    return dlopen(file_name.c_str(), RTLD_LOCAL | RTLD_LAZY);
+}
+
+//_________________________________________________________________//
+/**
+*    @brief Locates a method inside the loaded library on a POSIX run-time environment
+*/
+template<typename TargType>
+inline TargType
+locate_symbol(handle h, std::string const& symbol)
+{
+    return reinterpret_cast<TargType>(dlsym(h, symbol.c_str()));
+}
+
+//_________________________________________________________________//
+/*
+*   @brief Unloads a dll library on a POSIX run-time environment
+*/
+inline void
+close(handle h)
+{
+    if (h)
+    {
+        dlclose(h);
+    }
+}
+
+//_________________________________________________________________//
+
+inline std::string
+error()
+{
+    return dlerror();
+}
+
+//_________________________________________________________________//
+
+#else
+
+#error "Dynamic library API is unknown"
+
+#endif
+} // namespace dyn_lib
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+namespace
+{
+
+typedef bool (*init_func_ptr)();
+
+} // namespace anonymous
+
+CTestLibrary::CTestLibrary(const std::string& path, const std::string& initFunction) :
+    m_path(path),
+    m_initFunction(initFunction),
+    m_handle(nullptr)
+{
+}
+
+CTestLibrary::~CTestLibrary()
+{
+    dyn_lib::close(static_cast<dyn_lib::handle>(m_handle));
+}
+
+void CTestLibrary::Open()
+{
+    if (m_handle == nullptr)
+    {
+        dyn_lib::handle handle = dyn_lib::open(m_path);    //load the library via the relevant OS API
+
+        if (!handle)
+            throw std::logic_error(std::string("Fail to load test library: ")
+                                   .append(dyn_lib::error()));
+
+        m_handle = handle;
+    }
+}
+
+bool CTestLibrary::Load()
+{
+    Open();
+
+    init_func_ptr init_func = dyn_lib::locate_symbol<init_func_ptr>(static_cast<dyn_lib::handle>(m_handle), m_initFunction);    //locate the initialization method inside the library
+
+    /**
+    @note It has been decided to suppress that the raise of an exception in case the initialization method is not method.  At any rate the user
+    will know that his manually registered tests has not been listed because they will not appear in the XML file.
+    */
+
+    return (init_func == nullptr) || ((*init_func)());
+}
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
@@ -0,0 +1,72 @@
+#if !defined( _CTestLibrary_H_ )
+#define _CTestLibrary_H_
+
+#include <string>
+
+#include <boost/noncopyable.hpp>
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+/**
+ * @brief A Boost UTF test library (dll/shared object) loaded into the test runner process.
+ *
+ * Loading the library registers its automatically registered test units with the Boost UTF framework
+ * of the process. The library is unloaded when the object is destroyed.
+ */
+class CTestLibrary : private ::boost::noncopyable
+{
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param[in] path file-path to the exe/dll module which contains a Boost test framework
+     * @param[in] initFunction name of the (C style exported) initialization function of the test library
+     */
+    CTestLibrary(const std::string& path, const std::string& initFunction);
+
+    /**
+     * @brief Destructor. Unloads the test library.
+     */
+    ~CTestLibrary();
+
+    /**
+     * @brief Loads the test library in case it has not been loaded yet, without calling its initialization function
+     *
+     * @throw std::logic_error in case the library cannot be loaded
+     */
+    void Open();
+
+    /**
+     * @brief Loads the test library (in case it has not been loaded yet) and calls its initialization function.
+     *
+     * @return true in case the initialization function has not been located (so that the enumeration can proceed anyway);
+     *         otherwise whatever the initialization function returns
+     * @throw std::logic_error in case the library cannot be loaded
+     */
+    bool Load();
+
+    /**
+     * @brief Getter for the file-path of the test library
+     */
+    const std::string& GetPath() const
+    {
+        return m_path;
+    }
+
+private:
+    std::string m_path;
+    std::string m_initFunction;
+
+    void* m_handle;
+};
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
+
+#endif // _CTestLibrary_H_
@@ -0,0 +1,184 @@
+#include "CTestResultObserver.h"
+
+//suppression of warnings related to 3rd party files
+#pragma warning ( disable: 6001 )
+#pragma warning ( disable: 6031 )
+
+#include <boost/test/execution_monitor.hpp>
+#include <boost/test/tree/traverse.hpp>
+#include <boost/test/tree/test_unit.hpp>
+
+//end suppression of warnings related to 3rd party files
+#pragma warning ( default: 6001 )
+#pragma warning ( default: 6031 )
+
+#include "COutputCapture.h"
+#include "TestUnitPath.h"
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+namespace
+{
+
+/**
+ * @brief Visitor which reports all test cases of a skipped test suite as skipped
+ */
+struct SSkippedTestCaseVisitor : public ::boost::unit_test::test_tree_visitor
+{
+    explicit SSkippedTestCaseVisitor(::boost::unit_test::test_observer& observer) :
+        m_observer(&observer)
+    {
+    };
+
+    virtual void visit(const ::boost::unit_test::test_case& testCase) override
+    {
+        m_observer->test_unit_skipped(testCase);
+    }
+
+    ::boost::unit_test::test_observer* m_observer;
+};
+
+} // namespace anonymous
+
+CTestResultObserver::CTestResultObserver() :
+    m_capture(nullptr),
+    m_failedAssertions(0),
+    m_aborted(false)
+{
+}
+
+CTestResultObserver::~CTestResultObserver()
+{
+}
+
+void CTestResultObserver::AddListener(ITestResultListener& listener)
+{
+    m_listeners.push_back(&listener);
+}
+
+void CTestResultObserver::test_start(::boost::unit_test::counter_t)
+{
+    for (auto i = m_listeners.begin(), end = m_listeners.end(); i != end; ++i)
+    {
+        (*i)->OnRunStart();
+    }
+}
+
+void CTestResultObserver::test_finish()
+{
+    for (auto i = m_listeners.begin(), end = m_listeners.end(); i != end; ++i)
+    {
+        (*i)->OnRunFinish();
+    }
+}
+
+void CTestResultObserver::test_unit_start(const ::boost::unit_test::test_unit& testUnit)
+{
+    if (testUnit.p_type == ::boost::unit_test::TUT_CASE)
+    {
+        m_current = STestCaseResult();
+        m_current.m_id = testUnit.p_id;
+        m_current.m_path = GetTestUnitPath(testUnit);
+
+        m_failedAssertions = 0;
+        m_aborted = false;
+
+        for (auto i = m_listeners.begin(), end = m_listeners.end(); i != end; ++i)
+        {
+            (*i)->OnTestCaseStarted(m_current.m_id, m_current.m_path);
+        }
+
+        if (m_capture != nullptr)
+        {
+            m_capture->Start();
+        }
+    }
+}
+
+void CTestResultObserver::test_unit_finish(const ::boost::unit_test::test_unit& testUnit, unsigned long elapsed)
+{
+    if (testUnit.p_type != ::boost::unit_test::TUT_CASE)
+    {
+        return;
+    }
+
+    m_current.m_elapsed = elapsed;
+
+    if (m_aborted)
+    {
+        m_current.m_outcome = OutcomeAborted;
+    }
+    else if (m_failedAssertions > testUnit.p_expected_failures)
+    {
+        m_current.m_outcome = OutcomeFailed;
+    }
+    else
+    {
+        m_current.m_outcome = OutcomePassed;
+    }
+
+    if (m_capture != nullptr)
+    {
+        m_current.m_output = m_capture->Stop(m_current.m_outcome != OutcomePassed);
+    }
+
+    Notify(m_current);
+}
+
+void CTestResultObserver::test_unit_skipped(const ::boost::unit_test::test_unit& testUnit)
+{
+    // Test units which are skipped are not started. Report every test case contained in a skipped test unit.
+    if (testUnit.p_type == ::boost::unit_test::TUT_CASE)
+    {
+        STestCaseResult result;
+        result.m_id = testUnit.p_id;
+        result.m_path = GetTestUnitPath(testUnit);
+        result.m_outcome = OutcomeSkipped;
+
+        Notify(result);
+    }
+    else
+    {
+        SSkippedTestCaseVisitor visitor(*this);
+        ::boost::unit_test::traverse_test_tree(static_cast<const ::boost::unit_test::test_suite&>(testUnit), visitor, true);
+    }
+}
+
+void CTestResultObserver::test_unit_aborted(const ::boost::unit_test::test_unit& testUnit)
+{
+    if (testUnit.p_type == ::boost::unit_test::TUT_CASE)
+    {
+        m_aborted = true;
+    }
+}
+
+void CTestResultObserver::assertion_result(::boost::unit_test::assertion_result result)
+{
+    if (result == ::boost::unit_test::AR_FAILED)
+    {
+        ++m_failedAssertions;
+    }
+}
+
+void CTestResultObserver::exception_caught(const ::boost::execution_exception& ex)
+{
+    m_aborted = true;
+    m_current.m_message.assign(ex.what().begin(), ex.what().end());
+}
+
+void CTestResultObserver::Notify(const STestCaseResult& result)
+{
+    for (auto i = m_listeners.begin(), end = m_listeners.end(); i != end; ++i)
+    {
+        (*i)->OnTestCaseFinished(result);
+    }
+}
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
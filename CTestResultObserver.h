@@ -0,0 +1,92 @@
+#if !defined( _CTestResultObserver_H_ )
+#define _CTestResultObserver_H_
+
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+#include <boost/test/tree/observer.hpp>
+
+#include "TestCaseResult.h"
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+class COutputCapture;
+
+/**
+ * @brief Boost test_observer implementation which determines the result of each executed
+ *        test case and forwards it to the registered listeners
+ */
+class CTestResultObserver :
+    public ::boost::unit_test::test_observer,
+    private ::boost::noncopyable
+{
+public:
+    typedef ::boost::unit_test::test_observer TBase;
+
+    /**
+     * @brief Constructor
+     */
+    CTestResultObserver();
+
+    /**
+     * @brief Destructor
+     */
+    virtual ~CTestResultObserver();
+
+    /**
+     * @brief Registers a listener which is notified of test case results. The listener needs to outlive this observer.
+     */
+    void AddListener(ITestResultListener& listener);
+
+    /**
+     * @brief States whether any listener is registered
+     */
+    bool HasListeners() const
+    {
+        return !m_listeners.empty();
+    }
+
+    /**
+     * @brief Captures the output of each test case using the provided capture. The output of
+     *        test cases which do not pass is retained in their results. The capture needs to outlive this observer.
+     */
+    void SetOutputCapture(COutputCapture* capture)
+    {
+        m_capture = capture;
+    }
+
+    // test observer interface
+
+    virtual void test_start(::boost::unit_test::counter_t testCasesAmount) override;
+    virtual void test_finish() override;
+    virtual void test_unit_start(const ::boost::unit_test::test_unit& testUnit) override;
+    virtual void test_unit_finish(const ::boost::unit_test::test_unit& testUnit, unsigned long elapsed) override;
+    virtual void test_unit_skipped(const ::boost::unit_test::test_unit& testUnit) override;
+    virtual void test_unit_aborted(const ::boost::unit_test::test_unit& testUnit) override;
+    virtual void assertion_result(::boost::unit_test::assertion_result result) override;
+    virtual void exception_caught(const ::boost::execution_exception& ex) override;
+
+private:
+    /**
+     * @brief Forwards a test case result to all listeners
+     */
+    void Notify(const STestCaseResult& result);
+
+    std::vector<ITestResultListener*> m_listeners;
+    COutputCapture* m_capture;
+
+    STestCaseResult m_current;
+    std::size_t m_failedAssertions;
+    bool m_aborted;
+};
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
+
+#endif // _CTestResultObserver_H_
@@ -0,0 +1,257 @@
+#include "CTestResultsWriter.h"
+
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+//suppression of warnings related to 3rd party files
+#pragma warning ( disable: 6001 )
+#pragma warning ( disable: 6031 )
+
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+#include <boost/test/utils/xml_printer.hpp>
+
+//end suppression of warnings related to 3rd party files
+#pragma warning ( default: 6001 )
+#pragma warning ( default: 6031 )
+
+#include "CompressedFile.h"
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+namespace
+{
+
+// Utility function which is used to simply avoid writing '::boost::unit_test::attr_value()'
+::boost::unit_test::attr_value attr_value()
+{
+    return ::boost::unit_test::attr_value();
+};
+
+/**
+ * @brief Writes an xml element read into a property tree, i.e. its attributes and child elements (but no text)
+ */
+void WriteElement(std::ostream& out, const std::string& name, const ::boost::property_tree::ptree& element, const std::string& indentation)
+{
+    out << indentation << '<' << name;
+
+    const ::boost::property_tree::ptree& attributes = element.get_child("<xmlattr>", ::boost::property_tree::ptree());
+
+    for (auto i = attributes.begin(), end = attributes.end(); i != end; ++i)
+    {
+        out << ' ' << i->first << attr_value() << i->second.data();
+    }
+
+    bool empty = true;
+
+    for (auto i = element.begin(), end = element.end(); i != end; ++i)
+    {
+        if (i->first == "<xmlattr>")
+        {
+            continue;
+        }
+
+        if (empty)
+        {
+            out << '>' << std::endl;
+            empty = false;
+        }
+
+        WriteElement(out, i->first, i->second, indentation + "    ");
+    }
+
+    if (empty)
+    {
+        out << " />" << std::endl;
+    }
+    else
+    {
+        out << indentation << "</" << name << '>' << std::endl;
+    }
+}
+
+} // namespace anonymous
+
+CTestResultsWriter::CTestResultsWriter(const std::string& source, std::ostream* out) :
+    m_out(out),
+    m_source(source)
+{
+}
+
+CTestResultsWriter::~CTestResultsWriter()
+{
+}
+
+void CTestResultsWriter::OnRunStart()
+{
+    *m_out << "<?xml version=\"1.0\" encoding=\"UTF-8\" ?>" << std::endl
+           << "<TestResults source" << attr_value() << m_source << '>' << std::endl
+           << m_topology;
+
+    for (auto i = m_prior.begin(), end = m_prior.end(); i != end; ++i)
+    {
+        OnTestCaseFinished(*i);
+    }
+}
+
+void CTestResultsWriter::OnTestCaseFinished(const STestCaseResult& result)
+{
+    *m_out << "    <TestCase"
+              " id" << attr_value() << result.m_id <<
+              " path" << attr_value() << result.m_path <<
+              " outcome" << attr_value() << GetOutcomeName(result.m_outcome) <<
+              " elapsed" << attr_value() << result.m_elapsed;
+
+    if (!result.m_message.empty())
+    {
+        *m_out << " message" << attr_value() << result.m_message;
+    }
+
+    if (!result.m_cpus.empty())
+    {
+        *m_out << " cpus" << attr_value() << result.m_cpus;
+    }
+
+    if (result.m_numaNode >= 0)
+    {
+        *m_out << " node" << attr_value() << result.m_numaNode;
+    }
+
+    if (result.m_output.empty())
+    {
+        // Flush so that results are preserved in case the run is interrupted
+        *m_out << " />" << std::endl;
+    }
+    else
+    {
+        *m_out << '>' << std::endl
+               << "        <Output>" << ::boost::unit_test::cdata() << result.m_output << "</Output>" << std::endl
+               << "    </TestCase>" << std::endl;
+    }
+}
+
+void CTestResultsWriter::OnRunFinish()
+{
+    *m_out << "</TestResults>" << std::endl;
+}
+
+CTestResultsWriter::TResults CTestResultsWriter::Read(std::istream& in, std::string* source, std::string* topology)
+{
+    TResults results;
+
+    ::boost::property_tree::ptree document;
+
+    try
+    {
+        ::boost::property_tree::read_xml(in, document);
+    }
+    catch (const ::boost::property_tree::ptree_error& ex)
+    {
+        throw std::runtime_error(std::string("Malformed test results: ") + ex.what());
+    }
+
+    const ::boost::property_tree::ptree& root = document.get_child("TestResults", ::boost::property_tree::ptree());
+
+    if (source != nullptr)
+    {
+        *source = root.get("<xmlattr>.source", std::string());
+    }
+
+    std::ostringstream topologies;
+
+    for (auto i = root.begin(), end = root.end(); i != end; ++i)
+    {
+        if (i->first == "Topology")
+        {
+            WriteElement(topologies, i->first, i->second, "    ");
+        }
+
+        if (i->first != "TestCase")
+        {
+            continue;
+        }
+
+        STestCaseResult result;
+
+        result.m_id = i->second.get("<xmlattr>.id", ::boost::unit_test::INV_TEST_UNIT_ID);
+        result.m_path = i->second.get("<xmlattr>.path", std::string());
+        result.m_elapsed = i->second.get("<xmlattr>.elapsed", 0ul);
+        result.m_message = i->second.get("<xmlattr>.message", std::string());
+        result.m_output = i->second.get("Output", std::string());
+        result.m_cpus = i->second.get("<xmlattr>.cpus", std::string());
+        result.m_numaNode = i->second.get("<xmlattr>.node", -1);
+
+        if (!ParseOutcomeName(i->second.get("<xmlattr>.outcome", std::string()), result.m_outcome))
+        {
+            throw std::runtime_error("Malformed test results: invalid outcome for " + result.m_path);
+        }
+
+        results.push_back(result);
+    }
+
+    if (topology != nullptr)
+    {
+        *topology = topologies.str();
+    }
+
+    return results;
+}
+
+void CTestResultsWriter::Merge(const std::vector<std::string>& inputs, std::ostream& out)
+{
+    std::string source;
+    std::vector<std::string> topologies;
+    TResults results;
+
+    for (auto i = inputs.begin(), end = inputs.end(); i != end; ++i)
+    {
+        std::unique_ptr<std::istream> in = OpenInputFile(*i);
+
+        std::string partialSource;
+        std::string partialTopology;
+        TResults partial = Read(*in, &partialSource, &partialTopology);
+
+        if (source.empty())
+        {
+            source = partialSource;
+        }
+
+        // Partial results of the same machine and placement share a topology, which is only written once
+        if (!partialTopology.empty() && (std::find(topologies.begin(), topologies.end(), partialTopology) == topologies.end()))
+        {
+            topologies.push_back(partialTopology);
+        }
+
+        results.insert(results.end(), partial.begin(), partial.end());
+    }
+
+    CTestResultsWriter writer(source, &out);
+
+    std::string topology;
+
+    for (auto i = topologies.begin(), end = topologies.end(); i != end; ++i)
+    {
+        topology += *i;
+    }
+
+    writer.SetTopology(topology);
+    writer.OnRunStart();
+
+    for (auto i = results.begin(), end = results.end(); i != end; ++i)
+    {
+        writer.OnTestCaseFinished(*i);
+    }
+
+    writer.OnRunFinish();
+}
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
@@ -0,0 +1,122 @@
+#if !defined( _CTestResultsWriter_H_ )
+#define _CTestResultsWriter_H_
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include "TestCaseResult.h"
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+/**
+ * @brief ITestResultListener implementation which writes test case results to an xml file as they are reported.
+ *
+ * Sample output:
+ * @code{.xml}
+ * <?xml version="1.0" encoding="UTF-8" ?>
+ * <TestResults source="TestProject.dll">
+ *     <TestCase id="65536" path="ExampleTestSuite/NumberTestCaseA" outcome="passed" elapsed="1024" />
+ * </TestResults>
+ * @endcode
+ *
+ * Elapsed times are expressed in microseconds.
+ */
+class CTestResultsWriter :
+    public ITestResultListener,
+    private ::boost::noncopyable
+{
+public:
+    typedef std::vector<STestCaseResult> TResults;
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] source file-path to the exe/dll module which contains a Boost test framework
+     * @param[in] out a pointer to the output stream which will be used to output the xml result
+     */
+    CTestResultsWriter(const std::string& source, std::ostream* out);
+
+    /**
+     * @brief Destructor
+     */
+    virtual ~CTestResultsWriter();
+
+    /**
+     * @brief Registers results of a previous (e.g. interrupted) run which are written ahead of the results of this run
+     */
+    void AddPriorResults(const TResults& results)
+    {
+        m_prior.insert(m_prior.end(), results.begin(), results.end());
+    }
+
+    /**
+     * @brief Sets an xml element describing the processor topology of the run (see CWorkerPlacement::DescribeTopology)
+     *        which is written ahead of the results
+     */
+    void SetTopology(const std::string& topology)
+    {
+        m_topology = topology;
+    }
+
+    // test result listener interface
+
+    /**
+     * @brief Writes the xml declaration, preamble and any prior results
+     */
+    virtual void OnRunStart() override;
+
+    /**
+     * @brief Writes the result as an xml element
+     */
+    virtual void OnTestCaseFinished(const STestCaseResult& result) override;
+
+    /**
+     * @brief Writes the closing xml elements
+     */
+    virtual void OnRunFinish() override;
+
+    /**
+     * @brief Reads test case results from a stream in the format generated by this class
+     *
+     * @param[in] in the stream to read from
+     * @param[out] source optional pointer which receives the source module of the results
+     * @param[out] topology optional pointer which receives the Topology elements of the results (as written ahead of the results)
+     * @return the test case results in document order
+     * @throw std::runtime_error in case of malformed content
+     */
+    static TResults Read(std::istream& in, std::string* source = nullptr, std::string* topology = nullptr);
+
+    /**
+     * @brief Merges partial result files (e.g. of multiple shards) into a single result file. The distinct Topology elements
+     *        of the partial result files are carried over in input order.
+     *
+     * @param[in] inputs file-paths of the partial result files (optionally gzip or Zstandard compressed)
+     * @param[in] out the stream to write the merged results to
+     * @throw std::runtime_error in case an input cannot be read
+     */
+    static void Merge(const std::vector<std::string>& inputs, std::ostream& out);
+
+private:
+    std::ostream* m_out;
+
+    std::string m_source;
+
+    TResults m_prior;
+
+    std::string m_topology;
+};
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
+
+#endif // _CTestResultsWriter_H_
@@ -0,0 +1,351 @@
+#include "CTestRunList.h"
+#include "CTestUnitInspector.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
+//suppression of warnings related to 3rd party files
+#pragma warning ( disable: 6001 )
+#pragma warning ( disable: 6031 )
+
+#include <boost/test/framework.hpp>
+#include <boost/test/tree/test_unit.hpp>
+#include <boost/test/tree/traverse.hpp>
+#include <boost/test/tree/visitor.hpp>
+
+//end suppression of warnings related to 3rd party files
+#pragma warning ( default: 6001 )
+#pragma warning ( default: 6031 )
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+namespace
+{
+
+typedef std::unordered_set<::boost::unit_test::test_unit_id> TIds;
+typedef std::unordered_set<std::string> TPaths;
+
+std::string Trim(const std::string& value)
+{
+    std::string::size_type begin = 0;
+    std::string::size_type end = value.length();
+
+    while ((begin < end) && std::isspace(static_cast<unsigned char>(value[begin])))
+    {
+        ++begin;
+    }
+
+    while ((end > begin) && std::isspace(static_cast<unsigned char>(value[end - 1])))
+    {
+        --end;
+    }
+
+    return value.substr(begin, end - begin);
+}
+
+bool IsNumeric(const std::string& value)
+{
+    return std::all_of(value.begin(), value.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)) != 0; });
+}
+
+/**
+ * @brief Boost test_tree_visitor implementation which sets the default run status of each test case according to
+ *        the selection. Paths are built up incrementally during traversal rather than per test unit.
+ */
+class CSelectionApplier :
+    public ::boost::unit_test::test_tree_visitor
+{
+public:
+    CSelectionApplier(const TIds& ids, const TPaths& paths) :
+        m_ids(&ids),
+        m_paths(&paths),
+        m_selectedCount(0)
+    {
+    }
+
+    virtual void visit(const ::boost::unit_test::test_case& testCase) override
+    {
+        const std::string::size_type length = Enter(testCase);
+        const bool selected = m_selected.back() || IsSelected(testCase);
+
+        // The Boost UTF mutates the status of test units via the const references of its visitors alike
+        const_cast<::boost::unit_test::test_case&>(testCase).p_default_status.set(
+            selected ? ::boost::unit_test::test_unit::RS_ENABLED : ::boost::unit_test::test_unit::RS_DISABLED);
+
+        if (selected)
+        {
+            ++m_selectedCount;
+        }
+
+        m_path.resize(length);
+    }
+
+    virtual bool test_suite_start(const ::boost::unit_test::test_suite& testSuite) override
+    {
+        if (m_lengths.empty())
+        {
+            // The root (master) test suite is not part of test unit paths
+            m_lengths.push_back(0);
+            m_selected.push_back(m_ids->count(testSuite.p_id) > 0);
+        }
+        else
+        {
+            m_lengths.push_back(Enter(testSuite));
+            m_selected.push_back(m_selected.back() || IsSelected(testSuite));
+        }
+
+        return true;
+    }
+
+    virtual void test_suite_finish(const ::boost::unit_test::test_suite&) override
+    {
+        m_path.resize(m_lengths.back());
+
+        m_lengths.pop_back();
+        m_selected.pop_back();
+    }
+
+    std::size_t GetSelectedCount() const
+    {
+        return m_selectedCount;
+    }
+
+    const TIds& GetMatchedIds() const
+    {
+        return m_matchedIds;
+    }
+
+    const TPaths& GetMatchedPaths() const
+    {
+        return m_matchedPaths;
+    }
+
+    const TIds& GetMatchedUnits() const
+    {
+        return m_matchedUnits;
+    }
+
+private:
+    // Appends the name of the test unit to the current path; returns the length of the path beforehand
+    std::string::size_type Enter(const ::boost::unit_test::test_unit& testUnit)
+    {
+        const std::string::size_type length = m_path.length();
+
+        if (length > 0)
+        {
+            m_path += '/';
+        }
+
+        m_path += testUnit.p_name.value;
+
+        return length;
+    }
+
+    bool IsSelected(const ::boost::unit_test::test_unit& testUnit)
+    {
+        bool selected = false;
+
+        if (m_ids->count(testUnit.p_id) > 0)
+        {
+            m_matchedIds.insert(testUnit.p_id);
+            selected = true;
+        }
+
+        if (!m_paths->empty() && (m_paths->count(m_path) > 0))
+        {
+            m_matchedPaths.insert(m_path);
+            selected = true;
+        }
+
+        if (selected)
+        {
+            m_matchedUnits.insert(testUnit.p_id);
+        }
+
+        return selected;
+    }
+
+    const TIds* m_ids;
+    const TPaths* m_paths;
+
+    std::string m_path;
+    std::vector<std::string::size_type> m_lengths;
+    std::vector<bool> m_selected;
+
+    std::size_t m_selectedCount;
+
+    TIds m_matchedIds;
+    TPaths m_matchedPaths;
+    TIds m_matchedUnits;
+};
+
+/**
+ * @brief Boost test_tree_visitor implementation which collects the dependencies of the visited test units, including
+ *        those declared by decorators which are not applied yet
+ */
+class CDependencyCollector :
+    public ::boost::unit_test::test_tree_visitor
+{
+public:
+    explicit CDependencyCollector(CTestUnitInspector& inspector) :
+        m_inspector(&inspector)
+    {
+    }
+
+    virtual void visit(const ::boost::unit_test::test_case& testCase) override
+    {
+        Add(testCase);
+    }
+
+    virtual bool test_suite_start(const ::boost::unit_test::test_suite& testSuite) override
+    {
+        Add(testSuite);
+
+        return true;
+    }
+
+    void Add(const ::boost::unit_test::test_unit& testUnit)
+    {
+        const STestUnitTraits traits = m_inspector->Inspect(testUnit);
+        m_dependencies.insert(m_dependencies.end(), traits.m_dependencies.begin(), traits.m_dependencies.end());
+    }
+
+    const std::vector<::boost::unit_test::test_unit_id>& GetDependencies() const
+    {
+        return m_dependencies;
+    }
+
+private:
+    CTestUnitInspector* m_inspector;
+    std::vector<::boost::unit_test::test_unit_id> m_dependencies;
+};
+
+/**
+ * @brief Determines the test units which the selected test units depend on, transitively. Like the Boost UTF does for
+ *        run filters, the dependencies of the test units beneath and of the test suites above a selected test unit are
+ *        taken into account as well.
+ */
+TIds GetDependencies(const TIds& selected)
+{
+    CTestUnitInspector inspector;
+
+    TIds dependencies;
+    std::vector<::boost::unit_test::test_unit_id> pending(selected.begin(), selected.end());
+
+    while (!pending.empty())
+    {
+        const ::boost::unit_test::test_unit& testUnit = ::boost::unit_test::framework::get(pending.back(), ::boost::unit_test::TUT_ANY);
+        pending.pop_back();
+
+        CDependencyCollector collector(inspector);
+        ::boost::unit_test::traverse_test_tree(testUnit.p_id, collector, true);
+
+        for (::boost::unit_test::test_unit_id parent = testUnit.p_parent_id; parent != ::boost::unit_test::INV_TEST_UNIT_ID;
+             parent = ::boost::unit_test::framework::get(parent, ::boost::unit_test::TUT_SUITE).p_parent_id)
+        {
+            collector.Add(::boost::unit_test::framework::get(parent, ::boost::unit_test::TUT_SUITE));
+        }
+
+        const auto& found = collector.GetDependencies();
+
+        for (auto i = found.begin(), end = found.end(); i != end; ++i)
+        {
+            if ((selected.count(*i) == 0) && dependencies.insert(*i).second)
+            {
+                pending.push_back(*i);
+            }
+        }
+    }
+
+    return dependencies;
+}
+
+} // namespace anonymous
+
+CTestRunList::CTestRunList() :
+    m_selectDependencies(false)
+{
+}
+
+std::size_t CTestRunList::Read(std::istream& in)
+{
+    std::size_t count = 0;
+    std::string line;
+
+    while (std::getline(in, line))
+    {
+        line = Trim(line);
+
+        if (line.empty() || (line[0] == '#'))
+        {
+            continue;
+        }
+
+        if (IsNumeric(line))
+        {
+            m_ids.insert(static_cast<::boost::unit_test::test_unit_id>(std::strtoul(line.c_str(), nullptr, 10)));
+        }
+        else
+        {
+            m_paths.insert(line);
+        }
+
+        ++count;
+    }
+
+    return count;
+}
+
+std::size_t CTestRunList::Apply(const ::boost::unit_test::test_suite& master)
+{
+    CSelectionApplier applier(m_ids, m_paths);
+    ::boost::unit_test::traverse_test_tree(master, applier, true);
+
+    m_unmatched.clear();
+
+    for (auto i = m_ids.begin(), end = m_ids.end(); i != end; ++i)
+    {
+        if ((applier.GetMatchedIds().count(*i) == 0) && (*i != master.p_id))
+        {
+            m_unmatched.push_back(std::to_string(*i));
+        }
+    }
+
+    for (auto i = m_paths.begin(), end = m_paths.end(); i != end; ++i)
+    {
+        if (applier.GetMatchedPaths().count(*i) == 0)
+        {
+            m_unmatched.push_back(*i);
+        }
+    }
+
+    std::sort(m_unmatched.begin(), m_unmatched.end());
+
+    if (m_selectDependencies)
+    {
+        const TIds dependencies = GetDependencies(applier.GetMatchedUnits());
+
+        if (!dependencies.empty())
+        {
+            TIds ids(m_ids);
+            ids.insert(dependencies.begin(), dependencies.end());
+
+            CSelectionApplier dependencyApplier(ids, m_paths);
+            ::boost::unit_test::traverse_test_tree(master, dependencyApplier, true);
+
+            return dependencyApplier.GetSelectedCount();
+        }
+    }
+
+    return applier.GetSelectedCount();
+}
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
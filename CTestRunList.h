@@ -0,0 +1,94 @@
+#if !defined( _CTestRunList_H_ )
+#define _CTestRunList_H_
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+//suppression of warnings related to 3rd party files
+#pragma warning ( disable: 6001 )
+#pragma warning ( disable: 6031 )
+
+#include <boost/test/tree/test_unit.hpp>
+
+//end suppression of warnings related to 3rd party files
+#pragma warning ( default: 6001 )
+#pragma warning ( default: 6031 )
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+/**
+ * @brief Selection of the test units to run, read from a file which lists one test unit id or path (as written by
+ *        GetTestUnitPath, e.g. "suite/test") per line. Empty lines and lines starting with '#' are ignored.
+ *
+ * Ids and paths are kept in hash sets and the selection is applied in a single traversal of the test tree, so that
+ * the cost of a selection is linear in the size of the test tree and the selection. Selecting a test suite selects
+ * all test cases beneath it.
+ */
+class CTestRunList :
+    private ::boost::noncopyable
+{
+public:
+    /**
+     * @brief Constructor. The selection is empty.
+     */
+    CTestRunList();
+
+    /**
+     * @brief Adds the test units listed by the provided stream to the selection
+     *
+     * @param[in] in the stream to read from
+     * @return the number of ids and paths read
+     */
+    std::size_t Read(std::istream& in);
+
+    /**
+     * @brief Setter for whether the test units which the selected test units depend on are selected as well (as the
+     *        Boost UTF does for run filters). Off by default.
+     */
+    void SetSelectDependencies(bool selectDependencies)
+    {
+        m_selectDependencies = selectDependencies;
+    }
+
+    /**
+     * @brief Applies the selection to the provided test tree ahead of the execution phase: the default run status of
+     *        the selected test cases is set to enabled and that of all other test cases to disabled. Needs to be called
+     *        from the initialization function (i.e. before the Boost UTF finalizes the setup phase) and is not to be
+     *        combined with Boost UTF run filters (--run_test), which take precedence over default run states.
+     *
+     * @param[in] master the root of the test tree
+     * @return the number of selected test cases
+     */
+    std::size_t Apply(const ::boost::unit_test::test_suite& master);
+
+    /**
+     * @brief Getter for the ids and paths of the selection which did not match any test unit of the last applied test tree
+     */
+    const std::vector<std::string>& GetUnmatched() const
+    {
+        return m_unmatched;
+    }
+
+private:
+    std::unordered_set<::boost::unit_test::test_unit_id> m_ids;
+    std::unordered_set<std::string> m_paths;
+    bool m_selectDependencies;
+
+    std::vector<std::string> m_unmatched;
+};
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
+
+#endif // _CTestRunList_H_
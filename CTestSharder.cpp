@@ -0,0 +1,495 @@
+#include "CTestSharder.h"
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <queue>
+#include <set>
+#include <stdexcept>
+#include <utility>
+
+//suppression of warnings related to 3rd party files
+#pragma warning ( disable: 6001 )
+#pragma warning ( disable: 6031 )
+
+#include <boost/test/tree/test_unit.hpp>
+#include <boost/test/tree/traverse.hpp>
+#include <boost/test/utils/xml_printer.hpp>
+
+//end suppression of warnings related to 3rd party files
+#pragma warning ( default: 6001 )
+#pragma warning ( default: 6031 )
+
+#include "CTestUnitInspector.h"
+#include "TestUnitPath.h"
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+namespace
+{
+
+// Utility function which is used to simply avoid writing '::boost::unit_test::attr_value()'
+::boost::unit_test::attr_value attr_value()
+{
+    return ::boost::unit_test::attr_value();
+};
+
+/**
+ * @brief Collects the test cases of a test tree along with the structure relevant to scheduling
+ */
+struct STestTreeScanner : public ::boost::unit_test::test_tree_visitor
+{
+    typedef std::map<::boost::unit_test::test_unit_id, std::vector<std::size_t> > TTestCaseMap;
+    typedef std::pair<::boost::unit_test::test_unit_id, ::boost::unit_test::test_unit_id> TDependency;
+
+    virtual void visit(const ::boost::unit_test::test_case& testCase) override
+    {
+        const std::size_t position = m_testCases.size();
+
+        const STestUnitTraits traits = m_inspector.Inspect(testCase);
+
+        m_testCases.push_back(&testCase);
+        m_paths.push_back(GetTestUnitPath(testCase));
+        m_disabled.push_back(IsDisabled(traits));
+        m_testCaseIds[testCase.p_id].push_back(position);
+
+        for (auto i = m_suites.begin(), end = m_suites.end(); i != end; ++i)
+        {
+            m_testCaseIds[i->first].push_back(position);
+        }
+
+        AddDependencies(testCase, traits);
+    }
+
+    virtual bool test_suite_start(const ::boost::unit_test::test_suite& testSuite) override
+    {
+        const STestUnitTraits traits = m_inspector.Inspect(testSuite);
+
+        // Fixtures of the master test suite are global fixtures, which are set up in every shard anyway
+        if (!m_suites.empty() && traits.m_fixture)
+        {
+            m_fixtures.insert(testSuite.p_id);
+        }
+
+        m_suites.push_back(std::make_pair(testSuite.p_id, IsDisabled(traits)));
+        AddDependencies(testSuite, traits);
+
+        return true;
+    }
+
+    virtual void test_suite_finish(const ::boost::unit_test::test_suite&) override
+    {
+        m_suites.pop_back();
+    }
+
+    bool IsDisabled(const STestUnitTraits& traits) const
+    {
+        return (!m_suites.empty() && m_suites.back().second) || traits.m_disabled;
+    }
+
+    void AddDependencies(const ::boost::unit_test::test_unit& testUnit, const STestUnitTraits& traits)
+    {
+        for (auto i = traits.m_dependencies.begin(), end = traits.m_dependencies.end(); i != end; ++i)
+        {
+            m_dependencies.push_back(TDependency(testUnit.p_id, *i));
+        }
+    }
+
+    CTestCaseCollector::TTestCases m_testCases;         ///< test cases in test tree order
+    std::vector<std::string> m_paths;                   ///< path of each test case
+    std::vector<bool> m_disabled;                       ///< disabled state of each test case
+    TTestCaseMap m_testCaseIds;                         ///< positions of the test cases of each test unit
+    std::set<::boost::unit_test::test_unit_id> m_fixtures;  ///< test suites (other than the master test suite) with fixtures
+    std::vector<TDependency> m_dependencies;            ///< (dependent, dependency) pairs
+
+    std::vector<std::pair<::boost::unit_test::test_unit_id, bool> > m_suites;   ///< currently visited test suites and their disabled state
+
+    CTestUnitInspector m_inspector;                     ///< determines the effect of the decorators of the test units
+};
+
+/**
+ * @brief Partitions the test cases into blocks: test suites with a fixture whose cost does not exceed
+ *        the fair share of a shard form a block, any other test case forms a block of its own
+ */
+struct SBlockBuilder : public ::boost::unit_test::test_tree_visitor
+{
+    SBlockBuilder(const STestTreeScanner& scanner, const std::vector<unsigned long long>& costs, unsigned long long share) :
+        m_scanner(&scanner),
+        m_costs(&costs),
+        m_share(share),
+        m_blocks(scanner.m_testCases.size(), 0)
+    {
+    };
+
+    virtual void visit(const ::boost::unit_test::test_case& testCase) override
+    {
+        m_blocks[m_scanner->m_testCaseIds.find(testCase.p_id)->second.front()] = m_fixtures.size();
+        m_fixtures.push_back(std::string());
+    }
+
+    virtual bool test_suite_start(const ::boost::unit_test::test_suite& testSuite) override
+    {
+        if (m_scanner->m_fixtures.find(testSuite.p_id) == m_scanner->m_fixtures.end())
+        {
+            return true;
+        }
+
+        const auto found = m_scanner->m_testCaseIds.find(testSuite.p_id);
+
+        if (found == m_scanner->m_testCaseIds.end())
+        {
+            // Test suite without test cases
+            return true;
+        }
+
+        const std::vector<std::size_t>& testCases = found->second;
+
+        unsigned long long cost = 0;
+
+        for (auto i = testCases.begin(), end = testCases.end(); i != end; ++i)
+        {
+            cost += (*m_costs)[*i];
+        }
+
+        if (cost > m_share)
+        {
+            // Repeating the fixture in several shards is cheaper than a shard which takes considerably longer than the others
+            m_splits.push_back(std::make_pair(GetTestUnitPath(testSuite), cost));
+            return true;
+        }
+
+        for (auto i = testCases.begin(), end = testCases.end(); i != end; ++i)
+        {
+            m_blocks[*i] = m_fixtures.size();
+        }
+
+        m_fixtures.push_back(GetTestUnitPath(testSuite));
+
+        return false;
+    }
+
+    const STestTreeScanner* m_scanner;
+    const std::vector<unsigned long long>* m_costs;
+    unsigned long long m_share;
+
+    std::vector<std::size_t> m_blocks;                  ///< block of each test case
+    std::vector<std::string> m_fixtures;                ///< path of the test suite whose fixture is shared by each block; empty for single test cases
+    std::vector<std::pair<std::string, unsigned long long> > m_splits;  ///< test suites with a fixture which are split, and their cost
+};
+
+/**
+ * @brief Union-find representative of a block
+ */
+std::size_t FindBlock(std::vector<std::size_t>& parents, std::size_t block)
+{
+    while (parents[block] != block)
+    {
+        parents[block] = parents[parents[block]];
+        block = parents[block];
+    }
+
+    return block;
+}
+
+struct SGroupCost
+{
+    unsigned long long m_cost;
+    const std::string* m_path;
+    std::size_t m_group;
+
+    // Most costly first; ties are broken by path so that every shard computes the same assignment
+    bool operator<(const SGroupCost& other) const
+    {
+        return (m_cost != other.m_cost) ? (m_cost > other.m_cost) : (*m_path < *other.m_path);
+    }
+};
+
+} // namespace anonymous
+
+CTestSharder::CTestSharder(std::size_t index, std::size_t count) :
+    m_index(index),
+    m_count(count)
+{
+    if (index >= count)
+    {
+        throw std::logic_error("Shard index needs to be less than the shard count");
+    }
+}
+
+void CTestSharder::AddDurations(const std::vector<STestCaseResult>& results)
+{
+    for (auto i = results.begin(), end = results.end(); i != end; ++i)
+    {
+        if ((i->m_outcome != OutcomeSkipped) && !i->m_path.empty())
+        {
+            m_durations[i->m_path] = i->m_elapsed;
+        }
+    }
+}
+
+CTestCaseCollector::TTestCases CTestSharder::Select(const ::boost::unit_test::test_suite& master, std::ostream* plan) const
+{
+    // Consider all test cases regardless of their status so that every shard partitions the same set
+    STestTreeScanner scanner;
+    ::boost::unit_test::traverse_test_tree(master, scanner, true);
+
+    const std::size_t size = scanner.m_testCases.size();
+
+    // Cost of each test case: its recorded duration, the mean recorded duration if there is none, or 1 in case no durations are available
+    unsigned long long mean = 1;
+
+    if (!m_durations.empty())
+    {
+        unsigned long long total = 0;
+
+        for (auto i = m_durations.begin(), end = m_durations.end(); i != end; ++i)
+        {
+            total += i->second;
+        }
+
+        mean = std::max<unsigned long long>(total / m_durations.size(), 1);
+    }
+
+    std::vector<unsigned long long> costs(size, 0);
+    unsigned long long total = 0;
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        if (!scanner.m_disabled[i])
+        {
+            TDurationMap::const_iterator duration = m_durations.find(scanner.m_paths[i]);
+            costs[i] = (duration != m_durations.end()) ? duration->second : mean;
+            total += costs[i];
+        }
+    }
+
+    SBlockBuilder builder(scanner, costs, std::max<unsigned long long>(total / m_count, 1));
+    ::boost::unit_test::traverse_test_tree(master, builder, true);
+
+    // Join the blocks of test cases which depend on each other
+    std::vector<std::size_t> parents(builder.m_fixtures.size());
+    std::vector<bool> dependencies(builder.m_fixtures.size(), false);
+
+    for (std::size_t i = 0; i < parents.size(); ++i)
+    {
+        parents[i] = i;
+    }
+
+    for (auto i = scanner.m_dependencies.begin(), end = scanner.m_dependencies.end(); i != end; ++i)
+    {
+        STestTreeScanner::TTestCaseMap::const_iterator dependent = scanner.m_testCaseIds.find(i->first);
+        STestTreeScanner::TTestCaseMap::const_iterator dependency = scanner.m_testCaseIds.find(i->second);
+
+        // Dependencies on empty test suites (or on test units outside of the tree) do not constrain scheduling
+        if ((dependent == scanner.m_testCaseIds.end()) || (dependency == scanner.m_testCaseIds.end()))
+        {
+            continue;
+        }
+
+        const std::size_t root = FindBlock(parents, builder.m_blocks[dependency->second.front()]);
+        dependencies[root] = true;
+
+        const std::vector<std::size_t>* testCases[] = { &dependent->second, &dependency->second };
+
+        for (std::size_t j = 0; j < 2; ++j)
+        {
+            for (auto k = testCases[j]->begin(), kend = testCases[j]->end(); k != kend; ++k)
+            {
+                const std::size_t block = FindBlock(parents, builder.m_blocks[*k]);
+
+                if (block != root)
+                {
+                    parents[block] = root;
+                    dependencies[root] = dependencies[root] || dependencies[block];
+                }
+            }
+        }
+    }
+
+    // Groups are ordered by their first test case
+    TGroups groups;
+    std::vector<std::size_t> groupOfBlock(parents.size(), size);
+    std::vector<std::size_t> groupOfTestCase(size, 0);
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        const std::size_t block = builder.m_blocks[i];
+        const std::size_t root = FindBlock(parents, block);
+
+        if (groupOfBlock[root] == size)
+        {
+            groupOfBlock[root] = groups.size();
+            groups.push_back(SGroup());
+        }
+
+        SGroup& group = groups[groupOfBlock[root]];
+
+        group.m_testCases.push_back(i);
+        group.m_cost += costs[i];
+        group.m_dependencies = group.m_dependencies || dependencies[root];
+
+        if (!builder.m_fixtures[block].empty() && (std::find(group.m_fixtures.begin(), group.m_fixtures.end(), builder.m_fixtures[block]) == group.m_fixtures.end()))
+        {
+            group.m_fixtures.push_back(builder.m_fixtures[block]);
+        }
+
+        groupOfTestCase[i] = groupOfBlock[root];
+    }
+
+    Assign(scanner.m_paths, groups);
+
+    CTestCaseCollector::TTestCases selection;
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        if (groups[groupOfTestCase[i]].m_shard == m_index)
+        {
+            selection.push_back(scanner.m_testCases[i]);
+        }
+    }
+
+    if (plan != nullptr)
+    {
+        std::vector<unsigned long long> loads(m_count, 0);
+        std::vector<std::size_t> counts(m_count, 0);
+
+        for (auto i = groups.begin(), end = groups.end(); i != end; ++i)
+        {
+            loads[i->m_shard] += i->m_cost;
+            counts[i->m_shard] += i->m_testCases.size();
+        }
+
+        *plan << "<?xml version=\"1.0\" encoding=\"UTF-8\" ?>" << std::endl
+              << "<ShardPlan count" << attr_value() << m_count <<
+                 " index" << attr_value() << m_index <<
+                 " balanced" << attr_value() << (m_durations.empty() ? "false" : "true") << '>' << std::endl;
+
+        for (std::size_t shard = 0; shard < m_count; ++shard)
+        {
+            *plan << "    <Shard index" << attr_value() << shard <<
+                     " testCases" << attr_value() << counts[shard] <<
+                     " cost" << attr_value() << loads[shard] << " />" << std::endl;
+        }
+
+        for (auto i = builder.m_splits.begin(), end = builder.m_splits.end(); i != end; ++i)
+        {
+            *plan << "    <SplitFixture path" << attr_value() << i->first << " cost" << attr_value() << i->second << " />" << std::endl;
+        }
+
+        for (auto i = groups.begin(), end = groups.end(); i != end; ++i)
+        {
+            if (i->m_testCases.size() < 2)
+            {
+                continue;
+            }
+
+            *plan << "    <Group shard" << attr_value() << i->m_shard <<
+                     " cost" << attr_value() << i->m_cost <<
+                     " dependencies" << attr_value() << (i->m_dependencies ? "true" : "false") << '>' << std::endl;
+
+            for (auto j = i->m_fixtures.begin(), jend = i->m_fixtures.end(); j != jend; ++j)
+            {
+                *plan << "        <Fixture path" << attr_value() << *j << " />" << std::endl;
+            }
+
+            for (auto j = i->m_testCases.begin(), jend = i->m_testCases.end(); j != jend; ++j)
+            {
+                *plan << "        <TestCase path" << attr_value() << scanner.m_paths[*j] << " />" << std::endl;
+            }
+
+            *plan << "    </Group>" << std::endl;
+        }
+
+        *plan << "</ShardPlan>" << std::endl;
+    }
+
+    return selection;
+}
+
+void CTestSharder::Assign(const std::vector<std::string>& paths, TGroups& groups) const
+{
+    if (m_durations.empty())
+    {
+        // A group consisting of a single test case is assigned by the hash of its path, as are test cases without structure
+        for (auto i = groups.begin(), end = groups.end(); i != end; ++i)
+        {
+            i->m_shard = static_cast<std::size_t>(HashTestUnitPath(paths[i->m_testCases.front()]) % m_count);
+        }
+
+        return;
+    }
+
+    // Duration balanced: assign the most costly groups first, each to the currently least loaded shard
+    std::vector<SGroupCost> costs;
+    costs.reserve(groups.size());
+
+    for (std::size_t i = 0; i < groups.size(); ++i)
+    {
+        SGroupCost cost;
+        cost.m_cost = groups[i].m_cost;
+        cost.m_path = &paths[groups[i].m_testCases.front()];
+        cost.m_group = i;
+
+        costs.push_back(cost);
+    }
+
+    std::sort(costs.begin(), costs.end());
+
+    // (load, shard) pairs; the least loaded shard with the lowest index is on top
+    typedef std::pair<unsigned long long, std::size_t> TShardLoad;
+    std::priority_queue<TShardLoad, std::vector<TShardLoad>, std::greater<TShardLoad> > loads;
+
+    for (std::size_t shard = 0; shard < m_count; ++shard)
+    {
+        loads.push(TShardLoad(0, shard));
+    }
+
+    for (auto i = costs.begin(), end = costs.end(); i != end; ++i)
+    {
+        TShardLoad load = loads.top();
+        loads.pop();
+
+        groups[i->m_group].m_shard = load.second;
+
+        load.first += i->m_cost;
+        loads.push(load);
+    }
+}
+
+std::size_t CTestSharder::Apply(::boost::unit_test::test_suite& master, std::ostream* plan) const
+{
+    CTestCaseCollector::TTestCases selection = Select(master, plan);
+
+    std::set<::boost::unit_test::test_unit_id> selected;
+
+    for (auto i = selection.begin(), end = selection.end(); i != end; ++i)
+    {
+        selected.insert((*i)->p_id);
+    }
+
+    CTestCaseCollector collector(false);
+    ::boost::unit_test::traverse_test_tree(master, collector, true);
+
+    CTestCaseCollector::TTestCases excluded;
+
+    for (auto i = collector.GetTestCases().begin(), end = collector.GetTestCases().end(); i != end; ++i)
+    {
+        if (selected.find((*i)->p_id) == selected.end())
+        {
+            excluded.push_back(*i);
+        }
+    }
+
+    CTestCaseCollector::Remove(excluded);
+
+    return selection.size();
+}
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
@@ -0,0 +1,113 @@
+#if !defined( _CTestSharder_H_ )
+#define _CTestSharder_H_
+
+#include <cstddef>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "CTestCaseCollector.h"
+#include "TestCaseResult.h"
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+/**
+ * @brief Deterministically partitions the test cases of a test tree into a number of shards so that
+ *        independent test runner invocations (e.g. on different machines) each execute a distinct slice.
+ *
+ * By default test cases are assigned by a stable hash of their path. In case recorded durations are
+ * available, test cases are instead distributed so that the shards have similar total durations
+ * (longest processing time first). Test cases without a recorded duration are assumed to take the
+ * mean recorded duration.
+ *
+ * Test cases which need to run in the same process are kept in the same shard:
+ * - test cases which depend on each other (directly or via their test suites, see depends_on)
+ * - the test cases of a test suite with a fixture, so that the fixture is set up once rather than
+ *   once per shard. Such a test suite is split along its child test units only in case its test cases
+ *   alone would exceed the fair share of a shard (the total cost divided by the number of shards).
+ *
+ * Disabled test cases are partitioned as well (so that all shards partition the same set) but do not
+ * contribute to the cost of a shard.
+ */
+class CTestSharder
+{
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param[in] index zero-based index of the shard to select
+     * @param[in] count total number of shards
+     * @throw std::logic_error in case index is not less than count
+     */
+    CTestSharder(std::size_t index, std::size_t count);
+
+    /**
+     * @brief Registers recorded test case durations. Enables duration balanced sharding.
+     *
+     * @param[in] results previously recorded test case results
+     */
+    void AddDurations(const std::vector<STestCaseResult>& results);
+
+    /**
+     * @brief Selects the test cases of this shard
+     *
+     * @param[in] master the master test suite of the test tree
+     * @param[out] plan optional stream to which the scheduling decisions are written as XML document
+     * @return the test cases of this shard, in test tree order
+     */
+    CTestCaseCollector::TTestCases Select(const ::boost::unit_test::test_suite& master, std::ostream* plan = nullptr) const;
+
+    /**
+     * @brief Removes all test cases which do not belong to this shard from the test tree
+     *
+     * @param[in] master the master test suite of the test tree
+     * @param[out] plan optional stream to which the scheduling decisions are written as XML document
+     * @return the number of test cases which remain
+     */
+    std::size_t Apply(::boost::unit_test::test_suite& master, std::ostream* plan = nullptr) const;
+
+private:
+    /**
+     * @brief Test cases which are assigned to a shard as a whole
+     */
+    struct SGroup
+    {
+        SGroup() :
+            m_cost(0),
+            m_shard(0),
+            m_dependencies(false)
+        {
+        };
+
+        std::vector<std::size_t> m_testCases;   ///< positions of the test cases in test tree order
+        std::vector<std::string> m_fixtures;    ///< paths of the test suites whose fixture is shared by the test cases
+        unsigned long long m_cost;              ///< total cost of the test cases
+        std::size_t m_shard;                    ///< shard the group is assigned to
+        bool m_dependencies;                    ///< true in case test cases are grouped due to dependencies
+    };
+
+    typedef std::vector<SGroup> TGroups;
+
+    /**
+     * @brief Assigns the groups to shards, either by hash of the path of their first test case or by duration
+     */
+    void Assign(const std::vector<std::string>& paths, TGroups& groups) const;
+
+    std::size_t m_index;
+    std::size_t m_count;
+
+    typedef std::map<std::string, unsigned long> TDurationMap;
+    TDurationMap m_durations;
+};
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
+
+#endif // _CTestSharder_H_
@@ -0,0 +1,107 @@
+#include "CTestUnitInspector.h"
+
+#include <stdexcept>
+
+//suppression of warnings related to 3rd party files
+#pragma warning ( disable: 6001 )
+#pragma warning ( disable: 6031 )
+
+#include <boost/test/tree/decorator.hpp>
+
+//end suppression of warnings related to 3rd party files
+#pragma warning ( default: 6001 )
+#pragma warning ( default: 6031 )
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+namespace
+{
+
+/**
+ * @brief Determines whether a decorator affects scheduling (i.e. adds a fixture, a dependency or enables/disables)
+ */
+bool IsSchedulingDecorator(const ::boost::unit_test::decorator::base& decorator)
+{
+    return (dynamic_cast<const ::boost::unit_test::decorator::fixture_t*>(&decorator) != nullptr) ||
+           (dynamic_cast<const ::boost::unit_test::decorator::depends_on*>(&decorator) != nullptr) ||
+           (dynamic_cast<const ::boost::unit_test::decorator::enable_if_impl*>(&decorator) != nullptr);
+}
+
+} // namespace anonymous
+
+/**
+ * @brief Test suite which the decorators of the inspected test units are applied to
+ */
+class CTestUnitInspector::CScratchTestSuite : public ::boost::unit_test::test_suite
+{
+public:
+    CScratchTestSuite() :
+        ::boost::unit_test::test_suite("scratch", "", 0)
+    {
+    };
+
+    // Test suites can only be destroyed by derived classes
+    virtual ~CScratchTestSuite()
+    {
+    };
+};
+
+CTestUnitInspector::CTestUnitInspector() :
+    m_scratch(new CScratchTestSuite)
+{
+}
+
+CTestUnitInspector::~CTestUnitInspector()
+{
+}
+
+STestUnitTraits CTestUnitInspector::Inspect(const ::boost::unit_test::test_unit& testUnit)
+{
+    STestUnitTraits traits;
+
+    m_scratch->p_fixtures.value.clear();
+    m_scratch->p_default_status.set(::boost::unit_test::test_unit::RS_INHERIT);
+
+    // The dependencies of the scratch test suite can only be added to, so only those added for this test unit are considered.
+    // Dereferencing the address works whether the dependencies are a Boost UTF property or a plain list.
+    const auto& scratchDependencies = *&m_scratch->p_dependencies;
+    const std::size_t previousDependencies = scratchDependencies.size();
+
+    const auto& decorators = testUnit.p_decorators.get();
+
+    for (auto i = decorators.begin(), end = decorators.end(); i != end; ++i)
+    {
+        if (!IsSchedulingDecorator(**i))
+        {
+            continue;
+        }
+
+        try
+        {
+            (*i)->apply(*m_scratch);
+        }
+        catch (const std::exception&)
+        {
+            // Malformed decorators are reported by the Boost UTF framework once the test tree is set up
+        }
+    }
+
+    const auto& dependencies = *&testUnit.p_dependencies;
+
+    traits.m_fixture = !testUnit.p_fixtures.get().empty() || !m_scratch->p_fixtures.get().empty();
+    traits.m_disabled = (testUnit.p_default_status == ::boost::unit_test::test_unit::RS_DISABLED) ||
+                        (m_scratch->p_default_status == ::boost::unit_test::test_unit::RS_DISABLED);
+    traits.m_dependencies.assign(dependencies.begin(), dependencies.end());
+    traits.m_dependencies.insert(traits.m_dependencies.end(), scratchDependencies.begin() + previousDependencies, scratchDependencies.end());
+
+    return traits;
+}
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
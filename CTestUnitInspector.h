@@ -0,0 +1,82 @@
+#if !defined( _CTestUnitInspector_H_ )
+#define _CTestUnitInspector_H_
+
+#include <memory>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+//suppression of warnings related to 3rd party files
+#pragma warning ( disable: 6001 )
+#pragma warning ( disable: 6031 )
+
+#include <boost/test/tree/test_unit.hpp>
+
+//end suppression of warnings related to 3rd party files
+#pragma warning ( default: 6001 )
+#pragma warning ( default: 6031 )
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+/**
+ * @brief Properties of a test unit which are relevant to scheduling
+ */
+struct STestUnitTraits
+{
+    STestUnitTraits() :
+        m_fixture(false),
+        m_disabled(false)
+    {
+    };
+
+    bool m_fixture;                                             ///< true in case the test unit has a fixture
+    bool m_disabled;                                            ///< true in case the test unit is disabled
+    std::vector<::boost::unit_test::test_unit_id> m_dependencies;   ///< test units the test unit depends on
+};
+
+/**
+ * @brief Determines the scheduling traits of test units ahead of the end of the Boost UTF setup phase.
+ *
+ * Decorators (e.g. fixture, depends_on, disabled) are only applied by the Boost UTF framework once the test tree
+ * is set up, i.e. after the initialization function returns. Their effect is hence determined by applying them to
+ * a scratch test suite. Every test suite which is constructed registers with the Boost UTF framework and uses up one
+ * of its limited test unit ids for good; a single scratch test suite is hence reused for all inspected test units.
+ */
+class CTestUnitInspector :
+    private ::boost::noncopyable
+{
+public:
+    /**
+     * @brief Constructor. Registers the scratch test suite with the Boost UTF framework.
+     */
+    CTestUnitInspector();
+
+    /**
+     * @brief Destructor
+     */
+    ~CTestUnitInspector();
+
+    /**
+     * @brief Determines the scheduling traits of a test unit, taking its (not yet applied) decorators into account
+     *
+     * @param[in] testUnit the test unit to inspect
+     * @return the scheduling traits of the test unit
+     */
+    STestUnitTraits Inspect(const ::boost::unit_test::test_unit& testUnit);
+
+private:
+    class CScratchTestSuite;
+
+    std::unique_ptr<CScratchTestSuite> m_scratch;
+};
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
+
+#endif // _CTestUnitInspector_H_
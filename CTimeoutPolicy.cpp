@@ -0,0 +1,173 @@
+#include "CTimeoutPolicy.h"
+
+#include <stdexcept>
+#include <sstream>
+
+//suppression of warnings related to 3rd party files
+#pragma warning ( disable: 6001 )
+#pragma warning ( disable: 6031 )
+
+#include <boost/algorithm/string/trim.hpp>
+#include <boost/lexical_cast.hpp>
+
+//end suppression of warnings related to 3rd party files
+#pragma warning ( default: 6001 )
+#pragma warning ( default: 6031 )
+
+#include "TestUnitPath.h"
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+namespace
+{
+
+const std::string c_suitePrefix("suite:");
+const std::string c_labelPrefix("label:");
+
+std::logic_error MalformedLine(std::size_t lineNumber, const std::string& line)
+{
+    std::ostringstream error;
+    error << "Malformed timeout configuration at line " << lineNumber << ": " << line;
+    return std::logic_error(error.str());
+}
+
+} // namespace anonymous
+
+CTimeoutPolicy::CTimeoutPolicy() :
+    m_default(0),
+    m_global(0)
+{
+}
+
+void CTimeoutPolicy::Load(std::istream& in)
+{
+    std::string line;
+    std::size_t lineNumber = 0;
+
+    while (std::getline(in, line))
+    {
+        ++lineNumber;
+
+        ::boost::algorithm::trim(line);
+
+        if (line.empty() || (line[0] == '#'))
+        {
+            continue;
+        }
+
+        std::string::size_type separator = line.rfind('=');
+
+        if (separator == std::string::npos)
+        {
+            throw MalformedLine(lineNumber, line);
+        }
+
+        std::string key = ::boost::algorithm::trim_copy(line.substr(0, separator));
+        std::string value = ::boost::algorithm::trim_copy(line.substr(separator + 1));
+
+        unsigned long seconds = 0;
+
+        try
+        {
+            seconds = ::boost::lexical_cast<unsigned long>(value);
+        }
+        catch (const ::boost::bad_lexical_cast&)
+        {
+            throw MalformedLine(lineNumber, line);
+        }
+
+        if (key == "default")
+        {
+            SetDefaultTimeout(seconds);
+        }
+        else if (key == "global")
+        {
+            SetGlobalTimeout(seconds);
+        }
+        else if (key.compare(0, c_suitePrefix.length(), c_suitePrefix) == 0)
+        {
+            SetSuiteTimeout(key.substr(c_suitePrefix.length()), seconds);
+        }
+        else if (key.compare(0, c_labelPrefix.length(), c_labelPrefix) == 0)
+        {
+            SetLabelTimeout(key.substr(c_labelPrefix.length()), seconds);
+        }
+        else
+        {
+            throw MalformedLine(lineNumber, line);
+        }
+    }
+}
+
+void CTimeoutPolicy::SetSuiteTimeout(const std::string& path, unsigned long seconds)
+{
+    m_suites[path] = seconds;
+}
+
+void CTimeoutPolicy::SetLabelTimeout(const std::string& label, unsigned long seconds)
+{
+    m_labels[label] = seconds;
+}
+
+unsigned long CTimeoutPolicy::GetTimeout(const ::boost::unit_test::test_case& testCase) const
+{
+    // Boost UTF timeout decorator
+    if (testCase.p_timeout > 0)
+    {
+        return testCase.p_timeout;
+    }
+
+    // Labels
+    unsigned long timeout = 0;
+
+    for (auto i = testCase.p_labels.get().begin(), end = testCase.p_labels.get().end(); i != end; ++i)
+    {
+        TTimeoutMap::const_iterator label = m_labels.find(*i);
+
+        if ((label != m_labels.end()) && ((timeout == 0) || (label->second < timeout)))
+        {
+            timeout = label->second;
+        }
+    }
+
+    if (timeout > 0)
+    {
+        return timeout;
+    }
+
+    // Innermost test suite
+    if (!m_suites.empty())
+    {
+        std::string path = GetTestUnitPath(testCase);
+
+        for (;;)
+        {
+            TTimeoutMap::const_iterator suite = m_suites.find(path);
+
+            if (suite != m_suites.end())
+            {
+                return suite->second;
+            }
+
+            std::string::size_type separator = path.rfind('/');
+
+            if (separator == std::string::npos)
+            {
+                break;
+            }
+
+            path.erase(separator);
+        }
+    }
+
+    return m_default;
+}
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
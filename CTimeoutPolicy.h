@@ -0,0 +1,107 @@
+#if !defined( _CTimeoutPolicy_H_ )
+#define _CTimeoutPolicy_H_
+
+#include <istream>
+#include <map>
+#include <string>
+
+#include <boost/test/tree/test_unit.hpp>
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+/**
+ * @brief Resolves the time budget of test cases and of the whole test run.
+ *
+ * Timeouts are resolved, in order of precedence, from:
+ *  - the Boost UTF timeout decorator of the test case,
+ *  - a label of the test case (the smallest label timeout applies),
+ *  - the innermost test suite (or test case) path for which a timeout is configured,
+ *  - the default test case timeout.
+ *
+ * All timeouts are expressed in seconds. A value of 0 signifies no timeout.
+ */
+class CTimeoutPolicy
+{
+public:
+    /**
+     * @brief Constructor. No timeouts are configured.
+     */
+    CTimeoutPolicy();
+
+    /**
+     * @brief Loads timeout configuration from a stream. Each (non-empty, non-comment) line has one of the forms:
+     *
+     *  - <c>default = {seconds}</c>
+     *  - <c>global = {seconds}</c>
+     *  - <c>suite:{test unit path} = {seconds}</c>
+     *  - <c>label:{label} = {seconds}</c>
+     *
+     * Lines starting with '#' are comments.
+     *
+     * @param[in] in the stream to read the configuration from
+     * @throw std::logic_error in case of malformed content
+     */
+    void Load(std::istream& in);
+
+    /**
+     * @brief Sets the default test case timeout
+     */
+    void SetDefaultTimeout(unsigned long seconds)
+    {
+        m_default = seconds;
+    }
+
+    /**
+     * @brief Sets the timeout of the whole test run
+     */
+    void SetGlobalTimeout(unsigned long seconds)
+    {
+        m_global = seconds;
+    }
+
+    /**
+     * @brief Getter for the timeout of the whole test run
+     */
+    unsigned long GetGlobalTimeout() const
+    {
+        return m_global;
+    }
+
+    /**
+     * @brief Sets the timeout of all test cases contained in the test unit identified by path
+     */
+    void SetSuiteTimeout(const std::string& path, unsigned long seconds);
+
+    /**
+     * @brief Sets the timeout of all test cases having the provided label
+     */
+    void SetLabelTimeout(const std::string& label, unsigned long seconds);
+
+    /**
+     * @brief Resolves the timeout of the provided test case
+     *
+     * @param[in] testCase the test case whose timeout is requested
+     * @return the timeout in seconds; 0 if no timeout applies
+     */
+    unsigned long GetTimeout(const ::boost::unit_test::test_case& testCase) const;
+
+private:
+    unsigned long m_default;
+    unsigned long m_global;
+
+    typedef std::map<std::string, unsigned long> TTimeoutMap;
+
+    TTimeoutMap m_suites;
+    TTimeoutMap m_labels;
+};
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
+
+#endif // _CTimeoutPolicy_H_
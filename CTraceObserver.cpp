@@ -0,0 +1,98 @@
+#include "CTraceObserver.h"
+
+#include <string>
+
+//suppression of warnings related to 3rd party files
+#pragma warning ( disable: 6001 )
+#pragma warning ( disable: 6031 )
+
+#include <boost/test/tree/test_unit.hpp>
+
+//end suppression of warnings related to 3rd party files
+#pragma warning ( default: 6001 )
+#pragma warning ( default: 6031 )
+
+#include "TestUnitPath.h"
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+CTraceObserver::CTraceObserver(CTraceTimeline& timeline) :
+    m_timeline(&timeline)
+{
+}
+
+CTraceObserver::~CTraceObserver()
+{
+}
+
+void CTraceObserver::test_unit_start(const ::boost::unit_test::test_unit&)
+{
+    const std::int64_t now = CTraceTimeline::Now();
+
+    if (!m_open.empty() && (m_open.back().m_firstChildStart < 0))
+    {
+        m_open.back().m_firstChildStart = now;
+    }
+
+    SOpenTestUnit unit;
+
+    unit.m_start = now;
+    unit.m_firstChildStart = -1;
+    unit.m_lastChildFinish = -1;
+
+    m_open.push_back(unit);
+}
+
+void CTraceObserver::test_unit_finish(const ::boost::unit_test::test_unit& testUnit, unsigned long)
+{
+    const std::int64_t now = CTraceTimeline::Now();
+
+    if (m_open.empty())
+    {
+        return;
+    }
+
+    const SOpenTestUnit unit = m_open.back();
+    m_open.pop_back();
+
+    std::string path = GetTestUnitPath(testUnit);
+
+    if (path.empty())
+    {
+        // The master test suite
+        path = testUnit.p_name.value;
+    }
+
+    if (testUnit.p_type == ::boost::unit_test::TUT_CASE)
+    {
+        m_timeline->Record("test", path, unit.m_start, now);
+    }
+    else
+    {
+        if (unit.m_firstChildStart >= 0)
+        {
+            m_timeline->Record("fixture", "setup " + path, unit.m_start, unit.m_firstChildStart);
+        }
+
+        if (unit.m_lastChildFinish >= 0)
+        {
+            m_timeline->Record("fixture", "teardown " + path, unit.m_lastChildFinish, now);
+        }
+
+        m_timeline->Record("suite", path, unit.m_start, now);
+    }
+
+    if (!m_open.empty())
+    {
+        m_open.back().m_lastChildFinish = now;
+    }
+}
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
@@ -0,0 +1,77 @@
+#if !defined( _CTraceObserver_H_ )
+#define _CTraceObserver_H_
+
+#include <cstdint>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+#include <boost/test/tree/observer.hpp>
+
+#include "CTraceTimeline.h"
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+/**
+ * @brief Boost test_observer implementation which records the test units of a test run on a timeline.
+ *
+ * Each test case and test suite is recorded as a span. The Boost UTF does not notify observers of fixtures; the setup
+ * of a test suite is hence recorded as the span from the start of the suite to the start of its first child and the
+ * teardown as the span from the end of its last child to the end of the suite.
+ */
+class CTraceObserver :
+    public ::boost::unit_test::test_observer,
+    private ::boost::noncopyable
+{
+public:
+    typedef ::boost::unit_test::test_observer TBase;
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] timeline the timeline to record to. The timeline needs to outlive this observer.
+     */
+    explicit CTraceObserver(CTraceTimeline& timeline);
+
+    /**
+     * @brief Destructor
+     */
+    virtual ~CTraceObserver();
+
+    // test observer interface
+
+    /**
+     * @brief Observer method for the start of a test unit. Starts the span of the test unit.
+     */
+    virtual void test_unit_start(const ::boost::unit_test::test_unit& testUnit) override;
+
+    /**
+     * @brief Observer method for the end of a test unit. Records the span of the test unit and, for test suites, the setup and teardown spans.
+     */
+    virtual void test_unit_finish(const ::boost::unit_test::test_unit& testUnit, unsigned long elapsed) override;
+
+private:
+    /**
+     * @brief A test unit which has been started but not finished yet
+     */
+    struct SOpenTestUnit
+    {
+        std::int64_t m_start;
+        std::int64_t m_firstChildStart;     ///< start of the first child; -1 in case no child has been started
+        std::int64_t m_lastChildFinish;     ///< end of the last child; -1 in case no child has been finished
+    };
+
+    CTraceTimeline* m_timeline;
+
+    std::vector<SOpenTestUnit> m_open;
+};
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
+
+#endif // _CTraceObserver_H_
@@ -0,0 +1,216 @@
+#include "CTraceTimeline.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+#include <boost/config.hpp>
+
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32)
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+namespace
+{
+
+/**
+ * @brief Events reserved per thread up front so that recording rarely reallocates
+ */
+const std::size_t c_reservedEvents = 1024;
+
+std::atomic<unsigned long long> s_serials(0);
+
+unsigned long GetCurrentProcessIdentifier()
+{
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32)
+    return static_cast<unsigned long>(::GetCurrentProcessId());
+#else
+    return static_cast<unsigned long>(::getpid());
+#endif
+}
+
+void WriteJsonString(std::ostream& out, const std::string& value)
+{
+    out << '"';
+
+    for (auto i = value.begin(), end = value.end(); i != end; ++i)
+    {
+        const unsigned char c = static_cast<unsigned char>(*i);
+
+        if ((c == '"') || (c == '\\'))
+        {
+            out << '\\' << *i;
+        }
+        else if (c < 0x20)
+        {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+            out << escaped;
+        }
+        else
+        {
+            out << *i;
+        }
+    }
+
+    out << '"';
+}
+
+void WriteName(std::ostream& out, const char* metadata, unsigned long process, unsigned thread, const std::string& name)
+{
+    out << "{\"name\":\"" << metadata << "\",\"ph\":\"M\",\"pid\":" << process << ",\"tid\":" << thread << ",\"args\":{\"name\":";
+    WriteJsonString(out, name);
+    out << "}}";
+}
+
+} // namespace anonymous
+
+thread_local CTraceTimeline::SThreadBuffer* CTraceTimeline::s_buffer = nullptr;
+thread_local unsigned long long CTraceTimeline::s_bufferSerial = 0;
+
+CTraceTimeline::CTraceTimeline(const std::string& processName) :
+    m_processName(processName),
+    m_process(GetCurrentProcessIdentifier()),
+    m_serial(++s_serials)
+{
+    NameThread("main");
+}
+
+CTraceTimeline::~CTraceTimeline()
+{
+}
+
+std::int64_t CTraceTimeline::Now()
+{
+    // steady_clock is the system wide monotonic clock (CLOCK_MONOTONIC, QueryPerformanceCounter), so that
+    // the timestamps of worker processes line up with those of the supervising process
+    return static_cast<std::int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void CTraceTimeline::Record(const char* category, const std::string& name, std::int64_t start, std::int64_t finish)
+{
+    SEvent event;
+
+    event.m_category = category;
+    event.m_name = name;
+    event.m_start = start;
+    event.m_duration = (finish > start) ? (finish - start) : 0;
+
+    GetBuffer().m_events.push_back(std::move(event));
+}
+
+void CTraceTimeline::NameThread(const std::string& name)
+{
+    GetBuffer().m_name = name;
+}
+
+bool CTraceTimeline::MergeFragment(const std::string& path)
+{
+    std::ifstream in(path.c_str());
+
+    if (!in)
+    {
+        return false;
+    }
+
+    std::string line;
+
+    while (std::getline(in, line))
+    {
+        // A worker which has been terminated while writing may leave a truncated last line
+        if (!line.empty() && (line[0] == '{') && (line[line.size() - 1] == '}'))
+        {
+            m_fragments.push_back(line);
+        }
+    }
+
+    return true;
+}
+
+void CTraceTimeline::Write(std::ostream& out) const
+{
+    out << "{\"traceEvents\":[\n";
+
+    WriteEvents(out, ",\n");
+
+    for (auto i = m_fragments.begin(), end = m_fragments.end(); i != end; ++i)
+    {
+        out << ",\n" << *i;
+    }
+
+    out << "\n],\n\"displayTimeUnit\":\"ms\"}\n";
+}
+
+void CTraceTimeline::WriteFragment(const std::string& path) const
+{
+    std::ofstream out(path.c_str());
+
+    if (!out)
+    {
+        throw std::runtime_error("Fail to write trace fragment: " + path);
+    }
+
+    WriteEvents(out, "\n");
+    out << '\n';
+}
+
+CTraceTimeline::SThreadBuffer& CTraceTimeline::GetBuffer()
+{
+    if (s_bufferSerial != m_serial)
+    {
+        // First span of the calling thread; the only one which takes the lock
+        std::unique_ptr<SThreadBuffer> buffer(new SThreadBuffer);
+        buffer->m_events.reserve(c_reservedEvents);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        buffer->m_thread = static_cast<unsigned>(m_buffers.size() + 1);
+
+        s_buffer = buffer.get();
+        s_bufferSerial = m_serial;
+
+        m_buffers.push_back(std::move(buffer));
+    }
+
+    return *s_buffer;
+}
+
+void CTraceTimeline::WriteEvents(std::ostream& out, const char* separator) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    WriteName(out, "process_name", m_process, 0, m_processName);
+
+    for (auto i = m_buffers.begin(), end = m_buffers.end(); i != end; ++i)
+    {
+        const SThreadBuffer& buffer = **i;
+
+        out << separator;
+        WriteName(out, "thread_name", m_process, buffer.m_thread,
+            buffer.m_name.empty() ? ("thread " + std::to_string(buffer.m_thread)) : buffer.m_name);
+
+        for (auto event = buffer.m_events.begin(), last = buffer.m_events.end(); event != last; ++event)
+        {
+            out << separator << "{\"name\":";
+            WriteJsonString(out, event->m_name);
+            out << ",\"cat\":\"" << event->m_category << "\",\"ph\":\"X\",\"ts\":" << event->m_start << ",\"dur\":" << event->m_duration <<
+                   ",\"pid\":" << m_process << ",\"tid\":" << buffer.m_thread << '}';
+        }
+    }
+}
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
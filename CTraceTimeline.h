@@ -0,0 +1,179 @@
+#if !defined( _CTraceTimeline_H_ )
+#define _CTraceTimeline_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+/**
+ * @brief Records a timeline of a test run and writes it in the Chrome trace event format (JSON), as understood by
+ *        chrome://tracing and Perfetto.
+ *
+ * Spans are recorded as complete ("X") events into a buffer of the recording thread, so that recording takes no lock
+ * once a thread has recorded its first span. Each thread is shown as a track of the process it belongs to. Worker
+ * processes record their own timeline and write it as a fragment (see WriteFragment) which the supervising process
+ * merges into its timeline (see MergeFragment), so that each worker is shown as a process of its own. Timestamps
+ * are taken from the monotonic clock of the machine and hence line up across processes.
+ */
+class CTraceTimeline :
+    private ::boost::noncopyable
+{
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param[in] processName name of the track of the current process
+     */
+    explicit CTraceTimeline(const std::string& processName);
+
+    /**
+     * @brief Destructor
+     */
+    ~CTraceTimeline();
+
+    /**
+     * @brief Getter for the current time in microseconds, as used for the timestamps of spans
+     */
+    static std::int64_t Now();
+
+    /**
+     * @brief Records a span on the track of the calling thread
+     *
+     * @param[in] category category of the span (e.g. "test")
+     * @param[in] name name of the span (e.g. the path of a test case)
+     * @param[in] start start of the span, as returned by Now()
+     * @param[in] finish end of the span, as returned by Now()
+     */
+    void Record(const char* category, const std::string& name, std::int64_t start, std::int64_t finish);
+
+    /**
+     * @brief Names the track of the calling thread. Unnamed tracks are named "thread <n>".
+     */
+    void NameThread(const std::string& name);
+
+    /**
+     * @brief Merges a fragment written by a worker process (see WriteFragment) into this timeline
+     *
+     * @param[in] path file-path to the fragment
+     * @return true in case the fragment has been read; false in case it does not exist (e.g. the worker crashed)
+     */
+    bool MergeFragment(const std::string& path);
+
+    /**
+     * @brief Writes the timeline as a Chrome trace event JSON document, the merged fragments included
+     */
+    void Write(std::ostream& out) const;
+
+    /**
+     * @brief Writes the events of the timeline as a fragment, to be merged into the timeline of the supervising process
+     *
+     * @param[in] path file-path to write the fragment to
+     * @throw std::runtime_error in case the file cannot be written
+     */
+    void WriteFragment(const std::string& path) const;
+
+private:
+    /**
+     * @brief A span recorded by a thread
+     */
+    struct SEvent
+    {
+        const char* m_category;
+        std::string m_name;
+        std::int64_t m_start;
+        std::int64_t m_duration;
+    };
+
+    /**
+     * @brief The events recorded by a single thread
+     */
+    struct SThreadBuffer
+    {
+        unsigned m_thread;                  ///< track (tid) of the thread
+        std::string m_name;                 ///< name of the track; empty for the default name
+        std::vector<SEvent> m_events;
+    };
+
+    /**
+     * @brief Getter for the buffer of the calling thread. Creates the buffer on first use by the thread.
+     */
+    SThreadBuffer& GetBuffer();
+
+    /**
+     * @brief Writes the events of all threads along with the names of the tracks, one event per line
+     *
+     * @param[in] out the stream to write to
+     * @param[in] separator written between two events
+     */
+    void WriteEvents(std::ostream& out, const char* separator) const;
+
+    std::string m_processName;
+    unsigned long m_process;
+    unsigned long long m_serial;            ///< distinguishes this timeline from any earlier one in the per-thread buffer cache
+
+    mutable std::mutex m_mutex;             ///< guards the buffer list; the buffers are only written by their threads
+    std::vector<std::unique_ptr<SThreadBuffer>> m_buffers;
+
+    std::vector<std::string> m_fragments;   ///< events of the merged fragments, one event per element
+
+    static thread_local SThreadBuffer* s_buffer;                ///< buffer of the calling thread, valid for the timeline with serial s_bufferSerial
+    static thread_local unsigned long long s_bufferSerial;
+};
+
+/**
+ * @brief Records a span on the track of the calling thread for its lifetime. Does nothing in case no timeline is provided.
+ */
+class CTraceSpan :
+    private ::boost::noncopyable
+{
+public:
+    /**
+     * @brief Constructor. Starts the span.
+     *
+     * @param[in] timeline the timeline to record to; may be nullptr
+     * @param[in] category category of the span
+     * @param[in] name name of the span
+     */
+    CTraceSpan(CTraceTimeline* timeline, const char* category, const std::string& name) :
+        m_timeline(timeline),
+        m_category(category),
+        m_name((timeline == nullptr) ? std::string() : name),
+        m_start((timeline == nullptr) ? 0 : CTraceTimeline::Now())
+    {
+    }
+
+    /**
+     * @brief Destructor. Records the span.
+     */
+    ~CTraceSpan()
+    {
+        if (m_timeline != nullptr)
+        {
+            m_timeline->Record(m_category, m_name, m_start, CTraceTimeline::Now());
+        }
+    }
+
+private:
+    CTraceTimeline* m_timeline;
+    const char* m_category;
+    std::string m_name;
+    std::int64_t m_start;
+};
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
+
+#endif // _CTraceTimeline_H_
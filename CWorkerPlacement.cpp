@@ -0,0 +1,472 @@
+#include "CWorkerPlacement.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include <boost/config.hpp>
+
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#elif defined(__linux__)
+#include <dirent.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+//suppression of warnings related to 3rd party files
+#pragma warning ( disable: 6001 )
+#pragma warning ( disable: 6031 )
+
+#include <boost/test/utils/xml_printer.hpp>
+
+//end suppression of warnings related to 3rd party files
+#pragma warning ( default: 6001 )
+#pragma warning ( default: 6031 )
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+namespace
+{
+
+// Utility function which is used to simply avoid writing '::boost::unit_test::attr_value()'
+::boost::unit_test::attr_value attr_value()
+{
+    return ::boost::unit_test::attr_value();
+};
+
+#if defined(__linux__)
+// Memory policy mode of set_mempolicy(2); <numaif.h> is part of libnuma and not necessarily available
+const int c_mpolBind = 2;
+#endif
+
+bool IsMultiNode(const CWorkerPlacement::TTopology& topology)
+{
+    for (auto i = topology.begin(), end = topology.end(); i != end; ++i)
+    {
+        if (i->m_node != topology.front().m_node)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+unsigned GetNode(const CWorkerPlacement::TTopology& topology, unsigned cpu)
+{
+    for (auto i = topology.begin(), end = topology.end(); i != end; ++i)
+    {
+        if (i->m_index == cpu)
+        {
+            return i->m_node;
+        }
+    }
+
+    return 0;
+}
+
+} // namespace anonymous
+
+bool ParsePlacementPolicy(const std::string& name, EPlacementPolicy& policy)
+{
+    static const EPlacementPolicy policies[] = { PlacementNone, PlacementCore, PlacementNode };
+
+    for (std::size_t i = 0; i < (sizeof(policies) / sizeof(policies[0])); ++i)
+    {
+        if (name == GetPlacementPolicyName(policies[i]))
+        {
+            policy = policies[i];
+            return true;
+        }
+    }
+
+    return false;
+}
+
+const char* GetPlacementPolicyName(EPlacementPolicy policy)
+{
+    switch (policy)
+    {
+    case PlacementNone: return "none";
+    case PlacementCore: return "core";
+    case PlacementNode: return "node";
+    }
+
+    return "unknown";
+}
+
+CWorkerPlacement::CWorkerPlacement(EPlacementPolicy policy, std::size_t reserved, const std::string& reservedLabel) :
+    m_policy(policy),
+    m_reservedLabel(reservedLabel),
+    m_topology(DetectTopology()),
+    m_nextShared(0),
+    m_nextReserved(0)
+{
+    if (reserved >= m_topology.size())
+    {
+        std::ostringstream error;
+        error << "Cannot reserve " << reserved << " of " << m_topology.size() << " available cores";
+
+        throw std::logic_error(error.str());
+    }
+
+    for (std::size_t i = 0; i < m_topology.size(); ++i)
+    {
+        ((i < (m_topology.size() - reserved)) ? m_shared : m_reserved).push_back(m_topology[i].m_index);
+    }
+}
+
+CWorkerPlacement::SPlacement CWorkerPlacement::Next(const ::boost::unit_test::test_case& testCase)
+{
+    const std::vector<std::string>& labels = testCase.p_labels.get();
+    const bool reserved = !m_reserved.empty() && (std::find(labels.begin(), labels.end(), m_reservedLabel) != labels.end());
+
+    const TCpus& pool = reserved ? m_reserved : m_shared;
+    std::size_t& next = reserved ? m_nextReserved : m_nextShared;
+
+    const bool multiNode = IsMultiNode(m_topology);
+
+    SPlacement placement;
+
+    switch (m_policy)
+    {
+    case PlacementNone:
+        // Workers are only confined in case cores are reserved
+        if (!m_reserved.empty())
+        {
+            placement.m_cpus = pool;
+        }
+        break;
+
+    case PlacementCore:
+        placement.m_cpus.push_back(pool[next++ % pool.size()]);
+
+        if (multiNode)
+        {
+            placement.m_node = static_cast<int>(GetNode(m_topology, placement.m_cpus.front()));
+        }
+        break;
+
+    case PlacementNode:
+    {
+        std::set<unsigned> nodes;
+
+        for (auto i = pool.begin(), end = pool.end(); i != end; ++i)
+        {
+            nodes.insert(GetNode(m_topology, *i));
+        }
+
+        auto node = nodes.begin();
+        std::advance(node, next++ % nodes.size());
+
+        for (auto i = pool.begin(), end = pool.end(); i != end; ++i)
+        {
+            if (GetNode(m_topology, *i) == *node)
+            {
+                placement.m_cpus.push_back(*i);
+            }
+        }
+
+        if (multiNode)
+        {
+            placement.m_node = static_cast<int>(*node);
+        }
+        break;
+    }
+    }
+
+    return placement;
+}
+
+std::string CWorkerPlacement::DescribeTopology(const std::string& indentation) const
+{
+    std::ostringstream out;
+
+    out << indentation << "<Topology"
+           " policy" << attr_value() << GetPlacementPolicyName(m_policy);
+
+    if (!m_reserved.empty())
+    {
+        out << " reserved" << attr_value() << FormatCpus(m_reserved) <<
+               " reservedLabel" << attr_value() << m_reservedLabel;
+    }
+
+    out << '>' << std::endl;
+
+    std::set<unsigned> nodes;
+
+    for (auto i = m_topology.begin(), end = m_topology.end(); i != end; ++i)
+    {
+        nodes.insert(i->m_node);
+    }
+
+    for (auto node = nodes.begin(), nend = nodes.end(); node != nend; ++node)
+    {
+        TCpus cpus;
+
+        for (auto i = m_topology.begin(), end = m_topology.end(); i != end; ++i)
+        {
+            if (i->m_node == *node)
+            {
+                cpus.push_back(i->m_index);
+            }
+        }
+
+        out << indentation << "    <Node"
+               " index" << attr_value() << *node <<
+               " cpus" << attr_value() << FormatCpus(cpus) << " />" << std::endl;
+    }
+
+    out << indentation << "</Topology>" << std::endl;
+
+    return out.str();
+}
+
+CWorkerPlacement::TTopology CWorkerPlacement::DetectTopology()
+{
+    TTopology topology;
+
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32)
+    // Restricted to the processor group of the process
+    DWORD_PTR processMask = 0;
+    DWORD_PTR systemMask = 0;
+
+    if (GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask))
+    {
+        for (unsigned i = 0; i < (sizeof(DWORD_PTR) * 8); ++i)
+        {
+            if ((processMask & (static_cast<DWORD_PTR>(1) << i)) != 0)
+            {
+                UCHAR node = 0;
+
+                SCpu cpu;
+                cpu.m_index = i;
+                cpu.m_node = GetNumaProcessorNode(static_cast<UCHAR>(i), &node) ? node : 0;
+
+                topology.push_back(cpu);
+            }
+        }
+    }
+#elif defined(__linux__)
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0)
+    {
+        for (unsigned i = 0; i < CPU_SETSIZE; ++i)
+        {
+            if (CPU_ISSET(i, &allowed))
+            {
+                SCpu cpu;
+                cpu.m_index = i;
+                cpu.m_node = 0;
+
+                topology.push_back(cpu);
+            }
+        }
+    }
+
+    // NUMA nodes are listed in sysfs as node<N> directories, each of which states its processors
+    if (DIR* nodes = opendir("/sys/devices/system/node"))
+    {
+        while (dirent* entry = readdir(nodes))
+        {
+            const std::string name(entry->d_name);
+
+            if ((name.compare(0, 4, "node") != 0) || (name.length() == 4) || (name.find_first_not_of("0123456789", 4) != std::string::npos))
+            {
+                continue;
+            }
+
+            std::ifstream cpulist("/sys/devices/system/node/" + name + "/cpulist");
+            std::string list;
+            TCpus cpus;
+
+            if (std::getline(cpulist, list) && ParseCpus(list, cpus))
+            {
+                const unsigned node = static_cast<unsigned>(std::strtoul(name.c_str() + 4, nullptr, 10));
+
+                for (auto i = topology.begin(), end = topology.end(); i != end; ++i)
+                {
+                    if (std::binary_search(cpus.begin(), cpus.end(), i->m_index))
+                    {
+                        i->m_node = node;
+                    }
+                }
+            }
+        }
+
+        closedir(nodes);
+    }
+#endif
+
+    if (topology.empty())
+    {
+        // No affinity support; assume all processors are available on a single node
+        for (unsigned i = 0, count = std::max(std::thread::hardware_concurrency(), 1u); i < count; ++i)
+        {
+            SCpu cpu;
+            cpu.m_index = i;
+            cpu.m_node = 0;
+
+            topology.push_back(cpu);
+        }
+    }
+
+    return topology;
+}
+
+void CWorkerPlacement::Apply(const SPlacement& placement)
+{
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32)
+    if (!placement.m_cpus.empty())
+    {
+        DWORD_PTR mask = 0;
+
+        for (auto i = placement.m_cpus.begin(), end = placement.m_cpus.end(); i != end; ++i)
+        {
+            mask |= (*i < (sizeof(DWORD_PTR) * 8)) ? (static_cast<DWORD_PTR>(1) << *i) : 0;
+        }
+
+        if ((mask == 0) || !SetProcessAffinityMask(GetCurrentProcess(), mask))
+        {
+            std::ostringstream error;
+            error << "Failed to pin the process to processors " << FormatCpus(placement.m_cpus) << " (error " << GetLastError() << ')';
+
+            throw std::runtime_error(error.str());
+        }
+    }
+
+    // Windows allocates memory on the node of the processor a thread runs on by default; pinning implies node locality
+#elif defined(__linux__)
+    if (!placement.m_cpus.empty())
+    {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+
+        for (auto i = placement.m_cpus.begin(), end = placement.m_cpus.end(); i != end; ++i)
+        {
+            if (*i < CPU_SETSIZE)
+            {
+                CPU_SET(*i, &cpus);
+            }
+        }
+
+        if (sched_setaffinity(0, sizeof(cpus), &cpus) != 0)
+        {
+            throw std::runtime_error("Failed to pin the process to processors " + FormatCpus(placement.m_cpus) + ": " + std::strerror(errno));
+        }
+    }
+
+    if (placement.m_node >= 0)
+    {
+        const std::size_t bits = sizeof(unsigned long) * 8;
+        std::vector<unsigned long> nodes((placement.m_node / bits) + 1, 0);
+        nodes[placement.m_node / bits] = 1ul << (placement.m_node % bits);
+
+        if (syscall(SYS_set_mempolicy, c_mpolBind, &nodes[0], nodes.size() * bits) != 0)
+        {
+            std::ostringstream error;
+            error << "Failed to bind the memory of the process to NUMA node " << placement.m_node << ": " << std::strerror(errno);
+
+            throw std::runtime_error(error.str());
+        }
+    }
+#else
+    if (!placement.m_cpus.empty() || (placement.m_node >= 0))
+    {
+        throw std::runtime_error("Worker placement is not supported on this platform");
+    }
+#endif
+}
+
+std::string CWorkerPlacement::FormatCpus(const TCpus& cpus)
+{
+    std::ostringstream out;
+
+    for (std::size_t i = 0; i < cpus.size();)
+    {
+        // Collapse consecutive processors into a range
+        std::size_t last = i;
+
+        while (((last + 1) < cpus.size()) && (cpus[last + 1] == (cpus[last] + 1)))
+        {
+            ++last;
+        }
+
+        out << ((i > 0) ? "," : "") << cpus[i];
+
+        if (last > i)
+        {
+            out << '-' << cpus[last];
+        }
+
+        i = last + 1;
+    }
+
+    return out.str();
+}
+
+bool CWorkerPlacement::ParseCpus(const std::string& list, TCpus& cpus)
+{
+    cpus.clear();
+
+    std::istringstream in(list);
+    std::string range;
+
+    while (std::getline(in, range, ','))
+    {
+        char* end = nullptr;
+        const unsigned long first = std::strtoul(range.c_str(), &end, 10);
+        unsigned long last = first;
+
+        if (end == range.c_str())
+        {
+            return false;
+        }
+
+        if (*end == '-')
+        {
+            const char* const begin = end + 1;
+            last = std::strtoul(begin, &end, 10);
+
+            if ((end == begin) || (last < first))
+            {
+                return false;
+            }
+        }
+
+        if ((*end != '\0') && (*end != '\n'))
+        {
+            return false;
+        }
+
+        for (unsigned long i = first; i <= last; ++i)
+        {
+            cpus.push_back(static_cast<unsigned>(i));
+        }
+    }
+
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+
+    return !cpus.empty();
+}
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
@@ -0,0 +1,166 @@
+#if !defined( _CWorkerPlacement_H_ )
+#define _CWorkerPlacement_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+//suppression of warnings related to 3rd party files
+#pragma warning ( disable: 6001 )
+#pragma warning ( disable: 6031 )
+
+#include <boost/test/tree/test_unit.hpp>
+
+//end suppression of warnings related to 3rd party files
+#pragma warning ( default: 6001 )
+#pragma warning ( default: 6031 )
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+/**
+ * @brief Policies of placing worker (child) processes on the processors of the machine
+ */
+enum EPlacementPolicy
+{
+    PlacementNone,                          ///< workers are not pinned (apart from keeping clear of reserved cores)
+    PlacementCore,                          ///< each worker is pinned to a single core, round-robin
+    PlacementNode                           ///< each worker is pinned to the cores of a NUMA node, round-robin
+};
+
+/**
+ * @brief Parses a placement policy name: "none", "core" or "node"
+ *
+ * @param[in] name the name to parse
+ * @param[out] policy receives the parsed policy
+ * @return true if the name denotes a placement policy; false otherwise
+ */
+bool ParsePlacementPolicy(const std::string& name, EPlacementPolicy& policy);
+
+/**
+ * @brief Getter for the name of a placement policy
+ */
+const char* GetPlacementPolicyName(EPlacementPolicy policy);
+
+/**
+ * @brief Assigns processors (and the local NUMA node) to the worker processes of the test runner.
+ *
+ * Placements are handed out round-robin over the processors available to the test runner process. A number of
+ * cores may be reserved for test cases carrying a dedicated label (e.g. benchmarks): those test cases are placed
+ * on the reserved cores only and all other test cases are kept clear of them. Memory of a worker is bound to the
+ * NUMA node of its processors in case the machine has more than one node.
+ */
+class CWorkerPlacement :
+    private ::boost::noncopyable
+{
+public:
+    typedef std::vector<unsigned> TCpus;
+
+    /**
+     * @brief A logical processor and the NUMA node it belongs to
+     */
+    struct SCpu
+    {
+        unsigned m_index;
+        unsigned m_node;
+    };
+
+    typedef std::vector<SCpu> TTopology;
+
+    /**
+     * @brief Placement of a single worker process
+     */
+    struct SPlacement
+    {
+        SPlacement() :
+            m_node(-1)
+        {
+        };
+
+        TCpus m_cpus;                       ///< processors to pin the worker to; empty for no pinning
+        int m_node;                         ///< NUMA node to bind the memory of the worker to; -1 for no binding
+    };
+
+    /**
+     * @brief Constructor. Detects the topology of the processors available to the current process.
+     *
+     * @param[in] policy the placement policy
+     * @param[in] reserved number of cores reserved for test cases labelled as reservedLabel (taken from the highest numbered processors)
+     * @param[in] reservedLabel label of the test cases which run on the reserved cores
+     * @throw std::logic_error in case all cores would be reserved
+     */
+    CWorkerPlacement(EPlacementPolicy policy, std::size_t reserved, const std::string& reservedLabel);
+
+    /**
+     * @brief Getter for the detected topology
+     */
+    const TTopology& GetTopology() const
+    {
+        return m_topology;
+    }
+
+    /**
+     * @brief Determines the placement of the worker which executes the provided test case
+     */
+    SPlacement Next(const ::boost::unit_test::test_case& testCase);
+
+    /**
+     * @brief Describes the topology and the placement configuration as an xml element, e.g.
+     *        <c>&lt;Topology policy="core" reserved="14-15" reservedLabel="benchmark"&gt;&lt;Node index="0" cpus="0-7" /&gt;...&lt;/Topology&gt;</c>
+     *
+     * @param[in] indentation prefix of each line of the element
+     */
+    std::string DescribeTopology(const std::string& indentation) const;
+
+    /**
+     * @brief Detects the processors available to the current process along with their NUMA nodes
+     */
+    static TTopology DetectTopology();
+
+    /**
+     * @brief Pins the current process to the provided processors and binds its memory to the provided NUMA node.
+     *        Meant to be called by worker processes before the test library is loaded.
+     *
+     * @param[in] placement the placement to apply
+     * @throw std::runtime_error in case the placement cannot be applied
+     */
+    static void Apply(const SPlacement& placement);
+
+    /**
+     * @brief Formats a processor list in the notation of the Linux cpulist files, e.g. "0-3,8"
+     */
+    static std::string FormatCpus(const TCpus& cpus);
+
+    /**
+     * @brief Parses a processor list in the notation of the Linux cpulist files, e.g. "0-3,8"
+     *
+     * @param[in] list the list to parse
+     * @param[out] cpus receives the processors in ascending order
+     * @return true if the list is well-formed; false otherwise
+     */
+    static bool ParseCpus(const std::string& list, TCpus& cpus);
+
+private:
+    EPlacementPolicy m_policy;
+    std::string m_reservedLabel;
+
+    TTopology m_topology;
+
+    TCpus m_shared;                         ///< processors available to test cases in general
+    TCpus m_reserved;                       ///< processors reserved for labelled test cases
+
+    std::size_t m_nextShared;
+    std::size_t m_nextReserved;
+};
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
+
+#endif // _CWorkerPlacement_H_
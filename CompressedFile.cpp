@@ -0,0 +1,192 @@
+#include "CompressedFile.h"
+
+#include <fstream>
+#include <stdexcept>
+
+//suppression of warnings related to 3rd party files
+#pragma warning ( disable: 6001 )
+#pragma warning ( disable: 6031 )
+
+#include <boost/iostreams/device/file.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+#if defined(ETAS_COMPRESSION_ZSTD)
+#include <boost/iostreams/filter/zstd.hpp>
+#endif
+
+//end suppression of warnings related to 3rd party files
+#pragma warning ( default: 6001 )
+#pragma warning ( default: 6031 )
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+namespace
+{
+
+const unsigned char c_gzipMagic[] = { 0x1F, 0x8B };
+const unsigned char c_zstdMagic[] = { 0x28, 0xB5, 0x2F, 0xFD };
+
+bool EndsWith(const std::string& base, const std::string& match)
+{
+    return (base.length() >= match.length()) && (base.compare(base.length() - match.length(), match.length(), match) == 0);
+}
+
+template <std::size_t N>
+bool StartsWith(const char* data, std::size_t size, const unsigned char (&magic)[N])
+{
+    if (size < N)
+    {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        if (static_cast<unsigned char>(data[i]) != magic[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void ThrowUnsupported(const std::string& path)
+{
+    throw std::runtime_error("Zstandard compression is not supported by this build: " + path);
+}
+
+} // namespace anonymous
+
+bool ParseCompression(const std::string& name, ECompression& compression)
+{
+    if (name == "none")
+    {
+        compression = CompressionNone;
+    }
+    else if (name == "gzip")
+    {
+        compression = CompressionGzip;
+    }
+    else if (name == "zstd")
+    {
+        compression = CompressionZstd;
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+ECompression GetCompressionFromPath(const std::string& path)
+{
+    if (EndsWith(path, ".gz"))
+    {
+        return CompressionGzip;
+    }
+
+    if (EndsWith(path, ".zst"))
+    {
+        return CompressionZstd;
+    }
+
+    return CompressionNone;
+}
+
+std::unique_ptr<std::ostream> OpenOutputFile(const std::string& path, ECompression compression)
+{
+    if (compression == CompressionNone)
+    {
+        std::unique_ptr<std::ostream> out(new std::ofstream(path, (std::ios_base::out | std::ios_base::trunc)));
+
+        if (!*out)
+        {
+            throw std::runtime_error("Fail to open output file: " + path);
+        }
+
+        return out;
+    }
+
+    std::unique_ptr<::boost::iostreams::filtering_ostream> out(new ::boost::iostreams::filtering_ostream());
+
+    if (compression == CompressionGzip)
+    {
+        out->push(::boost::iostreams::gzip_compressor());
+    }
+    else
+    {
+#if defined(ETAS_COMPRESSION_ZSTD)
+        out->push(::boost::iostreams::zstd_compressor());
+#else
+        ThrowUnsupported(path);
+#endif
+    }
+
+    ::boost::iostreams::file_sink file(path, (std::ios_base::out | std::ios_base::trunc | std::ios_base::binary));
+
+    if (!file.is_open())
+    {
+        throw std::runtime_error("Fail to open output file: " + path);
+    }
+
+    // The stream closes the chain, and hence completes the compressed content, once it is destroyed
+    out->push(file);
+
+    return std::unique_ptr<std::ostream>(out.release());
+}
+
+std::unique_ptr<std::istream> OpenInputFile(const std::string& path)
+{
+    char magic[sizeof(c_zstdMagic)] = { 0 };
+    std::size_t size = 0;
+
+    {
+        std::ifstream in(path, (std::ios_base::in | std::ios_base::binary));
+
+        if (!in)
+        {
+            throw std::runtime_error("Fail to open input file: " + path);
+        }
+
+        in.read(magic, sizeof(magic));
+        size = static_cast<std::size_t>(in.gcount());
+    }
+
+    const bool gzip = StartsWith(magic, size, c_gzipMagic);
+    const bool zstd = StartsWith(magic, size, c_zstdMagic);
+
+    if (!gzip && !zstd)
+    {
+        return std::unique_ptr<std::istream>(new std::ifstream(path));
+    }
+
+    std::unique_ptr<::boost::iostreams::filtering_istream> in(new ::boost::iostreams::filtering_istream());
+
+    if (gzip)
+    {
+        in->push(::boost::iostreams::gzip_decompressor());
+    }
+    else
+    {
+#if defined(ETAS_COMPRESSION_ZSTD)
+        in->push(::boost::iostreams::zstd_decompressor());
+#else
+        ThrowUnsupported(path);
+#endif
+    }
+
+    in->push(::boost::iostreams::file_source(path, (std::ios_base::in | std::ios_base::binary)));
+
+    return std::unique_ptr<std::istream>(in.release());
+}
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
@@ -0,0 +1,70 @@
+#if !defined( _CompressedFile_H_ )
+#define _CompressedFile_H_
+
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+/**
+ * @brief Compression formats of output files
+ */
+enum ECompression
+{
+    CompressionNone,    ///< plain output
+    CompressionGzip,    ///< gzip (zlib) compressed output
+    CompressionZstd     ///< Zstandard compressed output; requires a build with ETAS_COMPRESSION_ZSTD defined (Boost 1.70 or later)
+};
+
+/**
+ * @brief Parses a compression name ("none", "gzip" or "zstd")
+ *
+ * @param[in] name the compression name
+ * @param[out] compression the parsed compression
+ * @return true if the name is a valid compression name
+ */
+bool ParseCompression(const std::string& name, ECompression& compression);
+
+/**
+ * @brief Determines the compression implied by the extension of a file-path, i.e. ".gz" or ".zst"
+ *
+ * @param[in] path the file-path
+ * @return the implied compression; CompressionNone for any other extension
+ */
+ECompression GetCompressionFromPath(const std::string& path);
+
+/**
+ * @brief Opens a file for writing. The written content is compressed as it is streamed.
+ *
+ * @note Compressed content is only complete once the stream is destroyed; flushing the stream
+ *       does not necessarily write out the content written so far.
+ *
+ * @param[in] path the file-path
+ * @param[in] compression the compression to apply
+ * @return the output stream
+ * @throw std::runtime_error in case the file cannot be opened or the compression is not supported by this build
+ */
+std::unique_ptr<std::ostream> OpenOutputFile(const std::string& path, ECompression compression);
+
+/**
+ * @brief Opens a file for reading. Compressed content (as identified by its leading magic number) is
+ *        decompressed as it is streamed.
+ *
+ * @param[in] path the file-path
+ * @return the input stream
+ * @throw std::runtime_error in case the file cannot be opened or its compression is not supported by this build
+ */
+std::unique_ptr<std::istream> OpenInputFile(const std::string& path);
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
+
+#endif // _CompressedFile_H_
@@ -0,0 +1,168 @@
+#include "CrashHandler.h"
+
+#include <atomic>
+#include <csignal>
+#include <cstddef>
+
+#include <boost/config.hpp>
+
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32) // WIN32 API
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#else // POSIX API
+
+#include <cstring>
+
+#endif
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+namespace
+{
+
+const std::size_t c_maxCallbacks = 8;
+
+std::atomic<TCrashCallback> s_callbacks[c_maxCallbacks];
+std::size_t s_callbackCount = 0;
+
+void CallCallbacks()
+{
+    for (std::size_t i = 0; i < c_maxCallbacks; ++i)
+    {
+        // Each callback is called at most once, even if it crashes itself
+        TCrashCallback callback = s_callbacks[i].exchange(nullptr);
+
+        if (callback != nullptr)
+        {
+            callback();
+        }
+    }
+}
+
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32) // WIN32 API
+
+LPTOP_LEVEL_EXCEPTION_FILTER s_previousFilter = NULL;
+void (*s_previousAbortHandler)(int) = SIG_DFL;
+
+LONG WINAPI CrashExceptionFilter(EXCEPTION_POINTERS* info)
+{
+    CallCallbacks();
+    return (s_previousFilter != NULL) ? s_previousFilter(info) : EXCEPTION_CONTINUE_SEARCH;
+}
+
+extern "C" void AbortSignalHandler(int signal)
+{
+    CallCallbacks();
+
+    std::signal(signal, s_previousAbortHandler);
+    std::raise(signal);
+}
+
+void InstallHandlers()
+{
+    s_previousFilter = SetUnhandledExceptionFilter(CrashExceptionFilter);
+    s_previousAbortHandler = std::signal(SIGABRT, AbortSignalHandler);
+}
+
+void UninstallHandlers()
+{
+    SetUnhandledExceptionFilter(s_previousFilter);
+    std::signal(SIGABRT, s_previousAbortHandler);
+}
+
+#else // POSIX API
+
+const int c_crashSignals[] = { SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT };
+const std::size_t c_crashSignalCount = sizeof(c_crashSignals) / sizeof(c_crashSignals[0]);
+
+struct sigaction s_previousActions[c_crashSignalCount];
+
+extern "C" void CrashSignalHandler(int signal)
+{
+    CallCallbacks();
+
+    // Hand over to whatever handled the signal before (by default, terminate the process)
+    for (std::size_t i = 0; i < c_crashSignalCount; ++i)
+    {
+        if (c_crashSignals[i] == signal)
+        {
+            sigaction(signal, &s_previousActions[i], nullptr);
+        }
+    }
+
+    raise(signal);
+}
+
+void InstallHandlers()
+{
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = CrashSignalHandler;
+    sigemptyset(&action.sa_mask);
+
+    for (std::size_t i = 0; i < c_crashSignalCount; ++i)
+    {
+        sigaction(c_crashSignals[i], &action, &s_previousActions[i]);
+    }
+}
+
+void UninstallHandlers()
+{
+    for (std::size_t i = 0; i < c_crashSignalCount; ++i)
+    {
+        sigaction(c_crashSignals[i], &s_previousActions[i], nullptr);
+    }
+}
+
+#endif
+
+} // namespace anonymous
+
+bool AddCrashCallback(TCrashCallback callback)
+{
+    for (std::size_t i = 0; i < c_maxCallbacks; ++i)
+    {
+        TCrashCallback expected = nullptr;
+
+        if (s_callbacks[i].compare_exchange_strong(expected, callback))
+        {
+            if (s_callbackCount++ == 0)
+            {
+                InstallHandlers();
+            }
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void RemoveCrashCallback(TCrashCallback callback)
+{
+    for (std::size_t i = 0; i < c_maxCallbacks; ++i)
+    {
+        TCrashCallback expected = callback;
+
+        if (s_callbacks[i].compare_exchange_strong(expected, nullptr))
+        {
+            if (--s_callbackCount == 0)
+            {
+                UninstallHandlers();
+            }
+
+            return;
+        }
+    }
+}
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
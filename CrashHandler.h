@@ -0,0 +1,39 @@
+#if !defined( _CrashHandler_H_ )
+#define _CrashHandler_H_
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+/**
+ * @brief Function called when the process crashes, e.g. to write out buffered output. Needs to be async-signal-safe.
+ */
+typedef void (*TCrashCallback)();
+
+/**
+ * @brief Registers a function to call when the process crashes.
+ *
+ * Crashes are intercepted via the fatal signals (SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT) on POSIX systems and via the
+ * unhandled exception filter and SIGABRT on Windows. After the callbacks have been called, the crash is handed over to
+ * whatever handled it before. The handlers are installed along with the first callback.
+ *
+ * @param[in] callback the function to call
+ * @return false in case too many callbacks are registered
+ */
+bool AddCrashCallback(TCrashCallback callback);
+
+/**
+ * @brief Unregisters a function registered via AddCrashCallback. The handlers are uninstalled along with the last callback.
+ *
+ * @param[in] callback the function to unregister
+ */
+void RemoveCrashCallback(TCrashCallback callback);
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
+
+#endif // _CrashHandler_H_
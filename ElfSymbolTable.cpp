@@ -0,0 +1,138 @@
+#include "ElfSymbolTable.h"
+
+#if !defined(BOOST_WINDOWS) || defined(BOOST_DISABLE_WIN32)
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#include <elf.h>
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+namespace
+{
+
+/**
+ * @brief Reads the function symbols from the symbol table of an ELF image of the class of the Elf_Ehdr type
+ */
+template <typename Elf_Ehdr, typename Elf_Shdr, typename Elf_Sym>
+std::vector<SElfSymbol> ReadElfFunctionSymbols(const std::vector<char>& image, const std::string& file)
+{
+    Elf_Ehdr header;
+    std::memcpy(&header, &image[0], sizeof(header));
+
+    if ((header.e_shoff == 0) || (header.e_shentsize != sizeof(Elf_Shdr)) ||
+        (header.e_shoff > image.size()) || (((image.size() - header.e_shoff) / sizeof(Elf_Shdr)) < header.e_shnum))
+    {
+        throw std::runtime_error("Malformed or unsupported ELF image: " + file);
+    }
+
+    std::vector<Elf_Shdr> sections(header.e_shnum);
+
+    if (!sections.empty())
+    {
+        std::memcpy(&sections[0], &image[header.e_shoff], sections.size() * sizeof(Elf_Shdr));
+    }
+
+    // Prefer the full symbol table; stripped images only provide the dynamic symbol table
+    auto table = std::find_if(sections.begin(), sections.end(), [](const Elf_Shdr& section) { return section.sh_type == SHT_SYMTAB; });
+
+    if (table == sections.end())
+    {
+        table = std::find_if(sections.begin(), sections.end(), [](const Elf_Shdr& section) { return section.sh_type == SHT_DYNSYM; });
+    }
+
+    if (table == sections.end())
+    {
+        throw std::runtime_error("No symbol table in " + file);
+    }
+
+    if ((table->sh_link >= sections.size()) ||
+        (table->sh_offset > image.size()) || (table->sh_size > (image.size() - table->sh_offset)) ||
+        (sections[table->sh_link].sh_offset > image.size()) || (sections[table->sh_link].sh_size > (image.size() - sections[table->sh_link].sh_offset)))
+    {
+        throw std::runtime_error("Malformed ELF image: " + file);
+    }
+
+    const char* const strings = &image[sections[table->sh_link].sh_offset];
+    const std::size_t stringsSize = static_cast<std::size_t>(sections[table->sh_link].sh_size);
+
+    std::vector<SElfSymbol> symbols;
+
+    for (std::size_t offset = 0; (offset + sizeof(Elf_Sym)) <= table->sh_size; offset += sizeof(Elf_Sym))
+    {
+        Elf_Sym entry;
+        std::memcpy(&entry, &image[table->sh_offset + offset], sizeof(entry));
+
+        if ((ELF32_ST_TYPE(entry.st_info) != STT_FUNC) || (entry.st_shndx == SHN_UNDEF) || (entry.st_name >= stringsSize))
+        {
+            continue;
+        }
+
+        const char* const name = strings + entry.st_name;
+
+        SElfSymbol symbol;
+        symbol.m_address = entry.st_value;
+        symbol.m_size = entry.st_size;
+        symbol.m_name.assign(name, strnlen(name, stringsSize - entry.st_name));
+
+        symbols.push_back(symbol);
+    }
+
+    return symbols;
+}
+
+} // namespace anonymous
+
+std::vector<SElfSymbol> ReadElfFunctionSymbols(const std::string& file)
+{
+    std::ifstream in(file, std::ios_base::in | std::ios_base::binary);
+
+    if (!in)
+    {
+        throw std::runtime_error("Fail to open " + file);
+    }
+
+    std::vector<char> image((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    if ((image.size() < EI_NIDENT) || (std::memcmp(&image[0], ELFMAG, SELFMAG) != 0))
+    {
+        throw std::runtime_error("Not an ELF image: " + file);
+    }
+
+#if defined(BOOST_LITTLE_ENDIAN) || (defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__))
+    const unsigned char data = ELFDATA2LSB;
+#else
+    const unsigned char data = ELFDATA2MSB;
+#endif
+
+    if (image[EI_DATA] != data)
+    {
+        throw std::runtime_error("Unsupported ELF byte order: " + file);
+    }
+
+    if ((image[EI_CLASS] == ELFCLASS64) && (image.size() >= sizeof(Elf64_Ehdr)))
+    {
+        return ReadElfFunctionSymbols<Elf64_Ehdr, Elf64_Shdr, Elf64_Sym>(image, file);
+    }
+    else if ((image[EI_CLASS] == ELFCLASS32) && (image.size() >= sizeof(Elf32_Ehdr)))
+    {
+        return ReadElfFunctionSymbols<Elf32_Ehdr, Elf32_Shdr, Elf32_Sym>(image, file);
+    }
+
+    throw std::runtime_error("Unsupported ELF class: " + file);
+}
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
+
+#endif
@@ -0,0 +1,47 @@
+#if !defined( _ElfSymbolTable_H_ )
+#define _ElfSymbolTable_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <boost/config.hpp>
+
+#if !defined(BOOST_WINDOWS) || defined(BOOST_DISABLE_WIN32)
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+/**
+ * @brief Function symbol as read from the symbol table of an ELF image
+ */
+struct SElfSymbol
+{
+    std::uint64_t m_address;                ///< link-time address of the function, i.e. not relocated
+    std::uint64_t m_size;                   ///< size of the function in bytes; 0 in case it is unknown
+    std::string m_name;                     ///< mangled name
+};
+
+/**
+ * @brief Reads the defined function symbols of an ELF image of the byte order of the running machine.
+ *
+ * The full symbol table is preferred since it includes functions of internal linkage (e.g. static functions and
+ * functions of anonymous namespaces) and hidden functions; stripped images only provide the dynamic symbol table.
+ *
+ * @param[in] file file-path of the ELF image
+ * @return the function symbols in order of the symbol table
+ * @throw std::runtime_error in case the image cannot be read, is not an ELF image of a supported class and byte order or has no symbol table
+ */
+std::vector<SElfSymbol> ReadElfFunctionSymbols(const std::string& file);
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
+
+#endif
+
+#endif // _ElfSymbolTable_H_
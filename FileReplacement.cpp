@@ -0,0 +1,30 @@
+#include "FileReplacement.h"
+
+#include <cstdio>
+
+#include <boost/config.hpp>
+
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32)
+#include <windows.h>
+#endif
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+bool ReplaceFileWith(const std::string& target, const std::string& source)
+{
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32)
+    return ::MoveFileExA(source.c_str(), target.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != FALSE;
+#else
+    // rename replaces an existing target atomically on POSIX systems
+    return std::rename(source.c_str(), target.c_str()) == 0;
+#endif
+}
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
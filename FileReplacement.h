@@ -0,0 +1,27 @@
+#if !defined( _FileReplacement_H_ )
+#define _FileReplacement_H_
+
+#include <string>
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+/**
+ * @brief Replaces a file by another one (typically a temporary file written next to it) in a single step, so that
+ *        readers observe either the previous or the new content and the target is never missing
+ *
+ * @param[in] target file-path of the file to replace; created in case it does not exist
+ * @param[in] source file-path of the file which takes the place of the target; it no longer exists on success
+ * @return true on success; false otherwise, in which case the target is left untouched
+ */
+bool ReplaceFileWith(const std::string& target, const std::string& source);
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
+
+#endif // _FileReplacement_H_
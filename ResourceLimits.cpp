@@ -0,0 +1,193 @@
+#include "ResourceLimits.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <sstream>
+
+#include <boost/config.hpp>
+
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32)
+#include <io.h>
+#include <windows.h>
+#else
+#include <csignal>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+namespace
+{
+
+void WriteError(const char* message)
+{
+    // Nothing but a plain write; the heap is exhausted or a signal is being handled
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32)
+    _write(2, message, static_cast<unsigned int>(std::strlen(message)));
+#else
+    if (write(STDERR_FILENO, message, std::strlen(message)) < 0)
+    {
+        // Nothing else to do; the exit code tells the limit violation
+    }
+#endif
+}
+
+std::atomic<bool> s_allocationFailed(false);
+
+void MemoryLimitHandler()
+{
+    // The allocation fails as usual, so that test code handling std::bad_alloc keeps working; the failure is merely noted
+    s_allocationFailed = true;
+    throw std::bad_alloc();
+}
+
+/**
+ * @brief Determines whether allocations of the current process fail once its memory limit is reached, i.e. whether the
+ *        limit is enforced in terms of address space (POSIX) or committed memory (Windows) rather than by a cgroup
+ */
+bool HasAllocationLimit()
+{
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32)
+    JOBOBJECT_EXTENDED_LIMIT_INFORMATION limits = {};
+
+    return QueryInformationJobObject(NULL, JobObjectExtendedLimitInformation, &limits, sizeof(limits), NULL) &&
+           ((limits.BasicLimitInformation.LimitFlags & (JOB_OBJECT_LIMIT_PROCESS_MEMORY | JOB_OBJECT_LIMIT_JOB_MEMORY)) != 0);
+#else
+    rlimit limit;
+
+    return (getrlimit(RLIMIT_AS, &limit) == 0) && (limit.rlim_cur != RLIM_INFINITY);
+#endif
+}
+
+#if !defined(BOOST_WINDOWS) || defined(BOOST_DISABLE_WIN32)
+extern "C" void CpuTimeLimitHandler(int)
+{
+    WriteError("cpu time limit exceeded\n");
+    _exit(c_cpuTimeLimitExitCode);
+}
+#endif
+
+std::string FormatBytes(std::uint64_t bytes)
+{
+    std::ostringstream out;
+
+    if (bytes >= (1ull << 20))
+    {
+        out << (bytes >> 20) << " MiB";
+    }
+    else
+    {
+        out << (bytes >> 10) << " KiB";
+    }
+
+    return out.str();
+}
+
+} // namespace anonymous
+
+void InstallResourceLimitHandlers()
+{
+    // Processes limited by a cgroup are killed by the kernel instead, which the parent learns from memory.events
+    if (HasAllocationLimit())
+    {
+        std::set_new_handler(MemoryLimitHandler);
+    }
+
+#if !defined(BOOST_WINDOWS) || defined(BOOST_DISABLE_WIN32)
+    // The soft limit raises SIGXCPU ahead of the hard limit which raises SIGKILL
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = CpuTimeLimitHandler;
+    sigemptyset(&action.sa_mask);
+
+    sigaction(SIGXCPU, &action, nullptr);
+#endif
+}
+
+int GetWorkerExitCode(int exitCode)
+{
+    if ((exitCode != 0) && s_allocationFailed)
+    {
+        WriteError("memory limit exceeded\n");
+        return c_memoryLimitExitCode;
+    }
+
+    return exitCode;
+}
+
+std::string GetExceededResource(const SResourceLimits& limits, const SResourceUsage& usage, bool exitedNormally, int exitCode)
+{
+    if ((limits.m_memory > 0) && ((exitedNormally && (exitCode == c_memoryLimitExitCode)) || (usage.m_memoryLimitHits > 0)))
+    {
+        return "memory";
+    }
+
+    if ((limits.m_cpuTime > 0) && ((exitedNormally && (exitCode == c_cpuTimeLimitExitCode)) ||
+        (!exitedNormally && (usage.m_cpuTime >= (static_cast<std::uint64_t>(limits.m_cpuTime) * 1000000)))))
+    {
+        return "cpu time";
+    }
+
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32)
+    // Job objects do not count failed process creations
+    if ((limits.m_processes > 0) && (usage.m_peakProcesses >= limits.m_processes))
+#else
+    if ((limits.m_processes > 0) && (usage.m_processLimitHits > 0))
+#endif
+    {
+        return "processes";
+    }
+
+#if !defined(BOOST_WINDOWS) || defined(BOOST_DISABLE_WIN32)
+    // Open files are not limited on Windows, where the sampled figure counts handles of any kind
+    if ((limits.m_openFiles > 0) && (usage.m_peakOpenFiles >= limits.m_openFiles))
+    {
+        return "open files";
+    }
+#endif
+
+    return std::string();
+}
+
+std::string DescribeResourceViolation(const std::string& resource, const SResourceLimits& limits, const SResourceUsage& usage)
+{
+    std::ostringstream out;
+
+    out << resource << " limit exceeded (";
+
+    if (resource == "memory")
+    {
+        out << FormatBytes(limits.m_memory);
+    }
+    else if (resource == "cpu time")
+    {
+        out << limits.m_cpuTime << " s";
+    }
+    else if (resource == "processes")
+    {
+        out << limits.m_processes;
+    }
+    else
+    {
+        out << limits.m_openFiles;
+    }
+
+    out << "); peak memory " << FormatBytes(usage.m_peakMemory) <<
+           ", cpu time " << (usage.m_cpuTime / 1000) << " ms"
+           ", open files " << usage.m_peakOpenFiles <<
+           ", processes " << usage.m_peakProcesses;
+
+    return out.str();
+}
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
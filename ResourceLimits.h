@@ -0,0 +1,111 @@
+#if !defined( _ResourceLimits_H_ )
+#define _ResourceLimits_H_
+
+#include <cstdint>
+#include <string>
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+/**
+ * @brief Exit code of a worker process which ran out of memory under a memory limit (see InstallResourceLimitHandlers)
+ */
+const int c_memoryLimitExitCode = 202;
+
+/**
+ * @brief Exit code of a worker process which ran out of processor time under a processor time limit (see InstallResourceLimitHandlers)
+ */
+const int c_cpuTimeLimitExitCode = 203;
+
+/**
+ * @brief Resource limits of a worker process. A value of 0 denotes no limit.
+ */
+struct SResourceLimits
+{
+    SResourceLimits() :
+        m_memory(0),
+        m_cpuTime(0),
+        m_openFiles(0),
+        m_processes(0)
+    {
+    };
+
+    /**
+     * @brief States whether none of the resources is limited
+     */
+    bool IsEmpty() const
+    {
+        return (m_memory == 0) && (m_cpuTime == 0) && (m_openFiles == 0) && (m_processes == 0);
+    }
+
+    std::uint64_t m_memory;                 ///< memory in bytes (cgroup memory.max, address space or job commit limit)
+    unsigned long m_cpuTime;                ///< processor time in seconds
+    unsigned long m_openFiles;              ///< number of open file descriptors (POSIX only)
+    unsigned long m_processes;              ///< number of processes, the worker included (cgroup v2 or job object only)
+};
+
+/**
+ * @brief Resource usage high-water marks of a worker process
+ */
+struct SResourceUsage
+{
+    SResourceUsage() :
+        m_peakMemory(0),
+        m_cpuTime(0),
+        m_peakOpenFiles(0),
+        m_peakProcesses(0),
+        m_memoryLimitHits(0),
+        m_processLimitHits(0)
+    {
+    };
+
+    std::uint64_t m_peakMemory;             ///< peak resident (POSIX) or committed (Windows) memory in bytes
+    std::uint64_t m_cpuTime;                ///< processor time (user and system) in microseconds
+    unsigned long m_peakOpenFiles;          ///< peak number of open file descriptors (handles on Windows), as sampled
+    unsigned long m_peakProcesses;          ///< peak number of processes, as sampled
+    unsigned long m_memoryLimitHits;        ///< number of processes killed for exceeding the memory limit (cgroup only)
+    unsigned long m_processLimitHits;       ///< number of process creations which failed due to the process limit (cgroup only)
+};
+
+/**
+ * @brief Installs handlers in the current (worker) process so that the parent can tell a limit violation from an ordinary
+ *        failure: the process terminates with c_cpuTimeLimitExitCode when its processor time limit is reached (POSIX only)
+ *        and, in case its memory limit makes allocations fail (i.e. the limit is not enforced by a cgroup), allocation
+ *        failures are noted for GetWorkerExitCode. Allocation failures still raise std::bad_alloc.
+ */
+void InstallResourceLimitHandlers();
+
+/**
+ * @brief Maps the exit code of a worker process which is about to exit
+ *
+ * @param[in] exitCode the exit code of the test run
+ * @return c_memoryLimitExitCode in case the test run failed after an allocation failed under the memory limit; exitCode otherwise
+ */
+int GetWorkerExitCode(int exitCode);
+
+/**
+ * @brief Determines whether a worker process has been stopped by one of its resource limits
+ *
+ * @param[in] limits the limits of the worker
+ * @param[in] usage the resource usage of the worker
+ * @param[in] exitedNormally whether the worker exited via exit/return from main
+ * @param[in] exitCode the exit code (or terminating signal) of the worker
+ * @return the name of the exceeded resource; an empty string in case no limit has been exceeded
+ */
+std::string GetExceededResource(const SResourceLimits& limits, const SResourceUsage& usage, bool exitedNormally, int exitCode);
+
+/**
+ * @brief Describes the limit violation and the resource usage of a worker in human readable form, e.g.
+ *        "memory limit exceeded (512 MiB); peak memory 530 MiB, cpu time 1200 ms, open files 12, processes 1"
+ */
+std::string DescribeResourceViolation(const std::string& resource, const SResourceLimits& limits, const SResourceUsage& usage);
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
+
+#endif // _ResourceLimits_H_
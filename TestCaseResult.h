@@ -0,0 +1,161 @@
+#if !defined( _TestCaseResult_H_ )
+#define _TestCaseResult_H_
+
+#include <string>
+
+#include <boost/test/tree/test_unit.hpp>
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+/**
+ * @brief Outcome of a single test case execution
+ */
+enum ETestOutcome
+{
+    OutcomePassed,      ///< the test case passed
+    OutcomeFailed,      ///< at least one assertion of the test case failed
+    OutcomeAborted,     ///< the test case (or the process executing it) terminated abnormally
+    OutcomeSkipped,     ///< the test case was not executed
+    OutcomeTimeout,     ///< the test case exceeded its time budget and was terminated
+    OutcomeFlaky,       ///< the test case did not pass at first but passed when executed again
+    OutcomeResourceLimit    ///< the test case exceeded a resource limit (memory, cpu time, open files or processes) and was stopped
+};
+
+/**
+ * @brief Returns a human readable, lower case name for the provided outcome
+ */
+inline const char* GetOutcomeName(ETestOutcome outcome)
+{
+    switch (outcome)
+    {
+    case OutcomePassed:  return "passed";
+    case OutcomeFailed:  return "failed";
+    case OutcomeAborted: return "aborted";
+    case OutcomeSkipped: return "skipped";
+    case OutcomeTimeout: return "timeout";
+    case OutcomeFlaky:   return "flaky";
+    case OutcomeResourceLimit: return "resource-limit";
+    }
+
+    return "unknown";
+}
+
+/**
+ * @brief Parses an outcome name as returned by GetOutcomeName
+ *
+ * @param[in] name the outcome name
+ * @param[out] outcome the parsed outcome
+ * @return true if the name is a valid outcome name
+ */
+inline bool ParseOutcomeName(const std::string& name, ETestOutcome& outcome)
+{
+    const ETestOutcome outcomes[] = { OutcomePassed, OutcomeFailed, OutcomeAborted, OutcomeSkipped, OutcomeTimeout, OutcomeFlaky, OutcomeResourceLimit };
+
+    for (std::size_t i = 0; i < (sizeof(outcomes) / sizeof(outcomes[0])); ++i)
+    {
+        if (name == GetOutcomeName(outcomes[i]))
+        {
+            outcome = outcomes[i];
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Determines whether the provided outcome denotes a failed test case execution, i.e. one which fails the run
+ *        and which is subject to reruns. Passed, skipped and flaky test cases do not fail the run.
+ */
+inline bool IsFailedOutcome(ETestOutcome outcome)
+{
+    switch (outcome)
+    {
+    case OutcomeFailed:
+    case OutcomeAborted:
+    case OutcomeTimeout:
+    case OutcomeResourceLimit:
+        return true;
+
+    case OutcomePassed:
+    case OutcomeSkipped:
+    case OutcomeFlaky:
+        break;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Result of a single test case execution
+ */
+struct STestCaseResult
+{
+    STestCaseResult() :
+        m_id(::boost::unit_test::INV_TEST_UNIT_ID),
+        m_outcome(OutcomeSkipped),
+        m_elapsed(0),
+        m_numaNode(-1)
+    {
+    };
+
+    ::boost::unit_test::test_unit_id m_id;  ///< test case id as assigned by the Boost UTF framework
+    std::string m_path;                     ///< full test case path (see GetTestUnitPath)
+    ETestOutcome m_outcome;                 ///< test case outcome
+    unsigned long m_elapsed;                ///< elapsed execution time in microseconds
+    std::string m_message;                  ///< optional detail on the outcome
+    std::string m_output;                   ///< optional output captured during the test case execution
+    std::string m_cpus;                     ///< processors the test case was pinned to (see CWorkerPlacement); empty if not pinned
+    int m_numaNode;                         ///< NUMA node the memory of the test case was bound to; -1 if not bound
+};
+
+/**
+ * @brief Interface for consumers of test case results
+ */
+class ITestResultListener
+{
+public:
+    virtual ~ITestResultListener()
+    {
+    };
+
+    /**
+     * @brief Notification of the start of the test run
+     */
+    virtual void OnRunStart()
+    {
+    };
+
+    /**
+     * @brief Notification of the start of a test case
+     *
+     * @param[in] id test case id as assigned by the Boost UTF framework
+     * @param[in] path full test case path (see GetTestUnitPath)
+     */
+    virtual void OnTestCaseStarted(::boost::unit_test::test_unit_id /* id */, const std::string& /* path */)
+    {
+    };
+
+    /**
+     * @brief Notification of a finished (or skipped) test case
+     */
+    virtual void OnTestCaseFinished(const STestCaseResult& result) = 0;
+
+    /**
+     * @brief Notification of the end of the test run
+     */
+    virtual void OnRunFinish()
+    {
+    };
+};
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
+
+#endif // _TestCaseResult_H_
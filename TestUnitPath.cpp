@@ -0,0 +1,95 @@
+#include "TestUnitPath.h"
+
+#include <algorithm>
+#include <cctype>
+#include <vector>
+
+//suppression of warnings related to 3rd party files
+#pragma warning ( disable: 6001 )
+#pragma warning ( disable: 6031 )
+
+#include <boost/config.hpp>
+#include <boost/test/framework.hpp>
+#include <boost/test/tree/test_unit.hpp>
+
+//end suppression of warnings related to 3rd party files
+#pragma warning ( default: 6001 )
+#pragma warning ( default: 6031 )
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+namespace
+{
+
+#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32)
+const char c_pathSeparator = '\\';
+#else
+const char c_pathSeparator = '/';
+#endif
+
+} // namespace anonymous
+
+std::string GetTestUnitPath(const ::boost::unit_test::test_unit& testUnit)
+{
+    const ::boost::unit_test::test_unit_id master = ::boost::unit_test::framework::master_test_suite().p_id;
+
+    std::vector<const ::boost::unit_test::test_unit*> units;
+
+    // Walk up to (but excluding) the master test suite
+    for (const ::boost::unit_test::test_unit* unit = &testUnit; unit->p_id != master; unit = &::boost::unit_test::framework::get(unit->p_parent_id, ::boost::unit_test::TUT_ANY))
+    {
+        units.push_back(unit);
+    }
+
+    std::string path;
+
+    for (auto i = units.rbegin(), end = units.rend(); i != end; ++i)
+    {
+        if (!path.empty())
+        {
+            path += '/';
+        }
+
+        path += (*i)->p_name.value;
+    }
+
+    return path;
+}
+
+unsigned long long HashTestUnitPath(const std::string& path)
+{
+    unsigned long long hash = 14695981039346656037ULL;
+
+    for (std::string::const_iterator i = path.begin(), end = path.end(); i != end; ++i)
+    {
+        hash ^= static_cast<unsigned char>(*i);
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+std::string GetTestUnitFilePath(const std::string& directory, const std::string& path, const std::string& extension)
+{
+    std::string name(path);
+
+    std::replace_if(name.begin(), name.end(), [](char c) { return !std::isalnum(static_cast<unsigned char>(c)) && (c != '_') && (c != '-'); }, '_');
+
+    std::string file(directory);
+
+    if (!file.empty() && (file[file.length() - 1] != '/') && (file[file.length() - 1] != c_pathSeparator))
+    {
+        file += c_pathSeparator;
+    }
+
+    return file.append(name).append(extension);
+}
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
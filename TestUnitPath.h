@@ -0,0 +1,48 @@
+#if !defined( _TestUnitPath_H_ )
+#define _TestUnitPath_H_
+
+#include <string>
+
+#include <boost/test/tree/test_unit.hpp>
+
+namespace etas
+{
+namespace boost
+{
+namespace unit_test
+{
+
+/**
+ * @brief Builds the full path of a test unit, e.g. "ExampleTestSuite/NumberTestCaseA".
+ *
+ * The master test suite is not part of the path so that the result can be passed as-is
+ * to the Boost UTF --run_test directive.
+ *
+ * @param[in] testUnit the test unit whose path is requested
+ * @return the '/' separated path of the test unit; an empty string for the master test suite
+ */
+std::string GetTestUnitPath(const ::boost::unit_test::test_unit& testUnit);
+
+/**
+ * @brief Computes a stable (i.e. platform and run independent) 64-bit FNV-1a hash of a test unit path
+ *
+ * @param[in] path the test unit path as returned by GetTestUnitPath
+ * @return the hash value
+ */
+unsigned long long HashTestUnitPath(const std::string& path);
+
+/**
+ * @brief Builds the file-path of a per test unit output file, e.g. "out/ExampleTestSuite_NumberTestCaseA.dmp"
+ *
+ * @param[in] directory the directory containing the file
+ * @param[in] path the test unit path as returned by GetTestUnitPath
+ * @param[in] extension the file extension (including the leading '.')
+ * @return the file-path; characters of the test unit path which are not safe within file names are replaced by '_'
+ */
+std::string GetTestUnitFilePath(const std::string& directory, const std::string& path, const std::string& extension);
+
+} // namespace unit_test
+} // namespace boost
+} // namespace etas
+
+#endif // _TestUnitPath_H_
@@ -35,309 +35,1279 @@ namespace cla = boost::runtime::cla;
 #include <iostream>
 
 #include <boost/cstdlib.hpp>    // for exit codes
+#include <boost/lexical_cast.hpp>
 
+#include <algorithm>
 #include <fstream>
+#include <iterator>
+#include <sstream>
+#include <utility>
+#include <vector>
 #include "CBoostTestTreeLister.h"
 #include "CBoostTestTreeDebugLister.h"
+#include "CBinaryTestIndexWriter.h"
+#include "CAllocationTracker.h"
+#include "CAsyncLogSink.h"
+#include "CChildProcess.h"
+#include "CFlakinessStatistics.h"
+#include "CFlakyTestDetector.h"
+#include "CIsolatedTestRunner.h"
+#include "CJUnitReportWriter.h"
+#include "CompressedFile.h"
+#include "COutputCapture.h"
+#include "CRunJournal.h"
+#include "CStaticTestDiscovery.h"
+#include "CSamplingProfiler.h"
+#include "CTestCaseCollector.h"
+#include "CTestHistory.h"
+#include "CTestLibrary.h"
+#include "CTestResultObserver.h"
+#include "CTestResultsWriter.h"
+#include "CTestRunList.h"
+#include "CTestSharder.h"
+#include "CTimeoutPolicy.h"
+#include "CTraceObserver.h"
+#include "CTraceTimeline.h"
+#include "CWorkerPlacement.h"
+#include "ResourceLimits.h"
+#include "TestUnitPath.h"
 
-//_________________________________________________________________//
+//____________________________________________________________________________//
+
+static std::string test_lib_name;
+static std::string init_func_name("init_unit_test");
+
+/**
+*   @brief The loaded test library
+*/
+static std::unique_ptr<::etas::boost::unit_test::CTestLibrary> test_lib;
+
+/**
+*   @brief Timeline of the test run (if any), written as a Chrome trace event document (or a fragment thereof in child processes)
+*/
+static std::unique_ptr<::etas::boost::unit_test::CTraceTimeline> trace_timeline;
+
+//____________________________________________________________________________//
+/**
+*   @brief Load the Boost UTF dll containing the tests, locate the initialization method
+*          (either the default "init_unit_test" or the one supplied via parameter --init) and in case
+*          the initialization method is found, call it.
+*
+*   @return returns true in case the initialization method has not been located (so that the enumeration can proceed anyway)
+*            In case the initialization method has been found, the method is called and whatever status that method return returns
+*           is returned by load_test_lib
+*/
+bool load_test_lib()
+{
+    if (!test_lib)
+    {
+        test_lib.reset(new ::etas::boost::unit_test::CTestLibrary(test_lib_name, init_func_name));
+    }
+
+    {
+        ::etas::boost::unit_test::CTraceSpan span(trace_timeline.get(), "runner", "load library");
+        test_lib->Open();
+    }
+
+    ::etas::boost::unit_test::CTraceSpan span(trace_timeline.get(), "runner", "init function " + init_func_name);
+    return test_lib->Load();
+}
+
+//____________________________________________________________________________//
+
+/**
+*   @brief Test observers which are registered with the Boost UTF framework when tests are executed
+*/
+static std::vector<::boost::unit_test::test_observer*> run_observers;
+
+/**
+*   @brief Selection of the test units to execute, read from the file supplied via --run-list (if any)
+*/
+static std::unique_ptr<::etas::boost::unit_test::CTestRunList> run_list;
+
+/**
+*   @brief Test case sharder applied to the test tree before tests are executed (if any)
+*/
+static std::unique_ptr<::etas::boost::unit_test::CTestSharder> test_sharder;
+
+/**
+*   @brief Output stream to which the scheduling decisions of the test case sharder are written (if any)
+*/
+static std::unique_ptr<std::ostream> shard_plan_out;
+
+/**
+*   @brief Journal of the test run (if any). Test cases which have already been journalled are not executed again.
+*/
+static std::unique_ptr<::etas::boost::unit_test::CRunJournal> run_journal;
+
+/**
+*   @brief Asynchronous sink of the Boost UTF log when tests are executed (if any)
+*/
+static std::unique_ptr<::etas::boost::unit_test::CAsyncLogSink> async_log;
+
+/**
+*   @brief Lister (and its output stream) writing the discovery document of the test tree prior to executing tests (if any)
+*/
+static std::unique_ptr<std::ostream> discovery_out;
+static std::unique_ptr<::etas::boost::unit_test::CBoostTestTreeLister> discovery_lister;
+
+/**
+*   @brief Placement of the child processes on processors and NUMA nodes when test cases are executed in child processes (if any)
+*/
+static std::unique_ptr<::etas::boost::unit_test::CWorkerPlacement> worker_placement;
+
+/**
+*   @brief Initialization method which loads the test library via load_test_lib, writes the discovery document (if requested)
+*          and restricts the test tree to the test cases selected via the command line (e.g. the test cases of a shard).
+*
+*   @return whatever load_test_lib returns
+*/
+bool init_test_tree()
+{
+    bool res = load_test_lib();
+
+    if (discovery_lister)
+    {
+        ::etas::boost::unit_test::CTraceSpan span(trace_timeline.get(), "traversal", "write discovery document");
+
+        // The discovery document describes the complete test tree, irrespective of any test selection
+        ::boost::unit_test::traverse_test_tree(::boost::unit_test::framework::master_test_suite(), *discovery_lister);
+        discovery_lister->WriteTrailer() << std::flush;
+        discovery_lister.reset();
+        discovery_out.reset();
+    }
+
+    if (test_sharder)
+    {
+        ::etas::boost::unit_test::CTraceSpan span(trace_timeline.get(), "traversal", "shard test tree");
+        test_sharder->Apply(::boost::unit_test::framework::master_test_suite(), shard_plan_out.get());
+        shard_plan_out.reset();
+    }
+
+    if (run_list)
+    {
+        ::etas::boost::unit_test::CTraceSpan span(trace_timeline.get(), "traversal", "apply run list");
+
+        run_list->Apply(::boost::unit_test::framework::master_test_suite());
+
+        const std::vector<std::string>& unmatched = run_list->GetUnmatched();
+
+        if (!unmatched.empty())
+        {
+            std::cout << "Warning: " << unmatched.size() << " entries of --run-list do not match any test unit, e.g. " << unmatched.front() << std::endl;
+        }
+
+        run_list.reset();
+    }
+
+    if (run_journal && !run_journal->GetJournalledResults().empty())
+    {
+        ::etas::boost::unit_test::CTraceSpan span(trace_timeline.get(), "traversal", "skip journalled test cases");
+
+        const ::etas::boost::unit_test::CTestCaseCollector::TTestCases completed = run_journal->GetSkippedTestCases(::boost::unit_test::framework::master_test_suite());
+
+        // Completed test cases stay in the test tree, since test cases which are yet to run may depend on them
+        ::etas::boost::unit_test::CTestCaseCollector::Disable(completed);
+    }
+
+    return res;
+}
+
+//____________________________________________________________________________//
+/**
+*   @brief Initialization method used when executing tests. Initializes the test tree via init_test_tree
+*          and registers any additional test observers requested via the command line.
+*
+*   @return whatever load_test_lib returns
+*/
+bool init_test_run()
+{
+    bool res = init_test_tree();
+
+    for (auto i = run_observers.begin(), end = run_observers.end(); i != end; ++i)
+    {
+        ::boost::unit_test::framework::register_observer(**i);
+    }
+
+    if (async_log)
+    {
+        // Set from within the initialization function so as to take precedence over the Boost UTF --log_sink directive
+        ::boost::unit_test::unit_test_log.set_stream(async_log->GetStream());
+    }
+
+    return res;
+}
+
+//____________________________________________________________________________//
+/**
+*   @brief Retrieves the value of a command line argument
+*
+*   @param [in]  P   Reference to the object handling the command line parsing
+*   @param [in]  arg Name of the command line argument
+*   @return          The argument value or an empty string in case the argument has not been supplied
+*/
+std::string GetArgument(const cla::parser& P, const std::string& arg)
+{
+    std::string value;
+
+    if (P[arg])
+    {
+        assign_op(value, P.get(arg), 0);
+    }
+
+    return value;
+}
+
+//____________________________________________________________________________//
+/**
+*   @brief Retrieves the value of a numeric command line argument
+*
+*   @param [in]  P   Reference to the object handling the command line parsing
+*   @param [in]  arg Name of the command line argument
+*   @return          The argument value or 0 in case the argument has not been supplied
+*   @throw std::logic_error in case the argument value is not numeric
+*/
+unsigned long GetNumericArgument(const cla::parser& P, const std::string& arg)
+{
+    std::string value = GetArgument(P, arg);
+
+    try
+    {
+        return value.empty() ? 0 : ::boost::lexical_cast<unsigned long>(value);
+    }
+    catch (const ::boost::bad_lexical_cast&)
+    {
+        throw std::logic_error("Invalid numeric value for --" + arg + ": " + value);
+    }
+}
+
+//____________________________________________________________________________//
+/**
+*   @brief Retrieves the value of a boolean command line argument
+*
+*   @param [in]  P   Reference to the object handling the command line parsing
+*   @param [in]  arg Name of the command line argument
+*   @return          The argument value or false in case the argument has not been supplied
+*   @throw std::logic_error in case the argument value is neither 'true' nor 'false'
+*/
+bool GetBooleanArgument(const cla::parser& P, const std::string& arg)
+{
+    std::string value = GetArgument(P, arg);
+
+    if (value.empty() || (value == "false"))
+    {
+        return false;
+    }
+
+    if (value != "true")
+    {
+        throw std::logic_error("Invalid boolean value for --" + arg + ": " + value);
+    }
+
+    return true;
+}
+
+//____________________________________________________________________________//
+/**
+*   @brief Generates an output stream so as to write to file. The output is compressed as requested via <b>--compress</b>
+*          or, by default, as implied by the file extension.
+*
+*   @param [in]  P   Reference to the object handling the command line parsing
+*   @param [in]  arg Full filepath where to write the XML file to
+*/
+std::unique_ptr<std::ostream> GetListOutputStream(const cla::parser& P, const std::string& arg)
+{
+    std::string listOut;
+    assign_op(listOut, P.get(arg), 0);
+
+    if (!listOut.empty())
+    {
+        ::etas::boost::unit_test::ECompression compression = ::etas::boost::unit_test::GetCompressionFromPath(listOut);
+
+        if (P["compress"] && !::etas::boost::unit_test::ParseCompression(GetArgument(P, "compress"), compression))
+        {
+            throw std::logic_error("--compress needs to be either 'none', 'gzip' or 'zstd'");
+        }
+
+        return ::etas::boost::unit_test::OpenOutputFile(listOut, compression);
+    }
+
+    return std::unique_ptr<std::ostream>();
+}
+
+//____________________________________________________________________________//
+
+typedef std::unique_ptr<::etas::boost::unit_test::CBoostTestTreeLister> TBoostTestTreeListerPtr;
+
+/*
+*   @brief Factory method return the correct type of test enumerator(lister) depending on the verbosity required
+*
+*   @param [in]  arg      string containing either either "list" or "list-debug" on which the factory method will use to determine the type of lister to return
+*   @param [in]  dll      library path containing the Boost UTF tests
+*   @param [in]  out      pointer to an output stream class which the test enumerator will use to output the report
+*   @param [in]  files    true to write source file-paths via a file dictionary (CBoostTestTreeDebugLister only)
+*   @param [in]  expand   true to write the test cases of families of generated test cases individually
+*   @return      object   of either type CBoostTestTreeLister or CBoostTestTreeDebugLister depending on the verbosity required as supplied by argument arg
+*/
+TBoostTestTreeListerPtr GetTestTreeLister(const std::string& arg, const std::string dll, std::ostream* out = nullptr, bool files = false, bool expand = false)
+{
+    out = (out == nullptr) ? &std::cout : out;
+
+    if (arg == "list")
+    {
+        TBoostTestTreeListerPtr lister(new ::etas::boost::unit_test::CBoostTestTreeLister(dll, out)); //less detail
+        lister->SetExpandFamilies(expand);
+
+        return lister;
+    }
+    else
+    {
+        std::unique_ptr<::etas::boost::unit_test::CBoostTestTreeDebugLister> lister(new ::etas::boost::unit_test::CBoostTestTreeDebugLister(dll, out)); //more detail
+        lister->SetFileDictionary(files);
+        lister->SetExpandFamilies(expand);
+
+        return TBoostTestTreeListerPtr(lister.release());
+    }
+
+}
+
+//____________________________________________________________________________//
+/**
+*   @brief Method utilized to format and write any exceptions to the output stream
+*
+*   @param [in] out    reference to the output stream where to write the exception to
+*   @param [in] dll    library path containing the Boost UTF tests
+*   @param [in] error  exception detail
+*/
+std::ostream& WriteError(std::ostream& out, const std::string& dll, const std::string& error = std::string())
+{
+    out << "<![CDATA[Error: Could not load " << dll << '.';
+
+    if (!error.empty())
+    {
+        out << " Detail: " << error;
+    }
+
+    out << "]]>";
+
+    return out;
+}
+
+//____________________________________________________________________________//
+/**
+*   @brief Method handling the enumeration of the tests.
+*
+*   @param [in]  P   Reference to the object handling the command line parsing
+*   @return          Returns either boost::exit_success or boost::exit_failure
+*/
+int ListTests(const cla::parser& P)
+{
+    int res = ::boost::exit_success;
+
+    std::string arg = (P["list"]) ? "list" : "list-debug";
+
+    std::unique_ptr<std::ostream> out = GetListOutputStream(P, arg);
+    TBoostTestTreeListerPtr lister = GetTestTreeLister(arg, test_lib_name, out.get(), GetBooleanArgument(P, "file-dictionary"),
+        GetBooleanArgument(P, "expand-families"));
+
+    if (lister != nullptr)
+    {
+        std::ostream& listing = lister->WriteHeader();
+
+        try
+        {
+            /**
+            * Load library before enumerating test suite to ensure correct registration.
+            * Execute initialization function since it may be the case that client code registers custom tests
+            */
+            if (load_test_lib())
+            {
+                //if the loading the library was successfull, then we proceed in enumerating the tests.
+                ::boost::unit_test::traverse_test_tree(::boost::unit_test::framework::master_test_suite(), *lister);
+            }
+        }
+        catch (std::exception& ex)
+        {
+            WriteError(listing, test_lib_name, ((ex.what() == nullptr) ? std::string() : ex.what()));
+            res = ::boost::exit_failure;
+        }
+        catch (...)
+        {
+            WriteError(listing, test_lib_name);
+            res = ::boost::exit_failure;
+        }
+
+        lister->WriteTrailer();
+    }
+
+    return res;
+}
+
+//____________________________________________________________________________//
+/**
+*   @brief Method handling the enumeration of the tests from the symbol table of the library, without loading it.
+*
+*   @param [in]  P   Reference to the object handling the command line parsing
+*   @return          Returns either boost::exit_success or boost::exit_failure
+*/
+int ListTestsStatic(const cla::parser& P)
+{
+    ::etas::boost::unit_test::CStaticTestDiscovery discovery(test_lib_name);
+
+    try
+    {
+        discovery.Discover();
+    }
+    catch (std::exception& ex)
+    {
+        std::cout << ex.what() << std::endl;
+        return ::boost::exit_failure;
+    }
+
+    std::unique_ptr<std::ostream> out = GetListOutputStream(P, "list-static");
+    discovery.Write(out ? *out : std::cout);
+
+    return ::boost::exit_success;
+}
+
+//____________________________________________________________________________//
+/**
+*   @brief Method utilized to enumerate the tests of the library into a binary test index
+*
+*   @param [in]  P   Reference to the object handling the command line parsing
+*   @return          boost::exit_success in case the index has been written; boost::exit_failure otherwise
+*/
+int WriteTestIndex(const cla::parser& P)
+{
+    std::string file;
+    assign_op(file, P.get("list-index"), 0);
+
+    try
+    {
+        ::etas::boost::unit_test::CBinaryTestIndexWriter writer(test_lib_name);
+
+        if (load_test_lib())
+        {
+            // Applies the decorators and settles the default run status of each test unit
+            ::boost::unit_test::framework::finalize_setup_phase();
 
-// System API
+            ::boost::unit_test::traverse_test_tree(::boost::unit_test::framework::master_test_suite(), writer, true);
+        }
+
+        std::ofstream out(file, (std::ios_base::out | std::ios_base::trunc | std::ios_base::binary));
+
+        if (!writer.Write(out).flush())
+        {
+            throw std::runtime_error("Fail to write " + file);
+        }
+    }
+    catch (std::exception& ex)
+    {
+        std::cout << "Fail to write test index of " << test_lib_name << ": " << ex.what() << std::endl;
+        return ::boost::exit_failure;
+    }
+
+    return ::boost::exit_success;
+}
+
+//____________________________________________________________________________//
+/**
+*   @brief Builds the command line arguments for child processes of the test runner, i.e. the arguments supplied to this
+*          process excluding the executable, the Boost UTF test selection (--run_test) and the supplied parent only arguments.
+*
+*   @param [in]  argc       argument count
+*   @param [in]  argv       argument vector
+*   @param [in]  parentOnly names of the arguments (taking a value) which are not forwarded
+*/
+::etas::boost::unit_test::CChildProcess::TArguments GetChildArguments(int argc, char* argv[], const std::vector<std::string>& parentOnly)
+{
+    ::etas::boost::unit_test::CChildProcess::TArguments args;
+
+    std::vector<std::string> excluded(parentOnly);
+    excluded.push_back("run_test");
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg(argv[i]);
+
+        bool skip = false;
+
+        for (auto name = excluded.begin(), end = excluded.end(); (name != end) && !skip; ++name)
+        {
+            const std::string option = "--" + *name;
+
+            if (arg == option)
+            {
+                // Value supplied as a separate argument
+                skip = true;
+                ++i;
+            }
+            else if (arg.compare(0, option.length() + 1, option + '=') == 0)
+            {
+                skip = true;
+            }
+        }
+
+        if ((arg == "-t") && !skip)
+        {
+            skip = true;
+            ++i;
+        }
+
+        if (!skip)
+        {
+            args.push_back(arg);
+        }
+    }
+
+    const bool asyncLog = std::find_if(args.begin(), args.end(), [](const std::string& arg)
+        { return (arg == "--async-log") || (arg.compare(0, 12, "--async-log=") == 0); }) != args.end();
+
+    if (asyncLog)
+    {
+        // The children share the log file of the parent, which they must not start afresh
+        args.push_back("--async-log-append");
+        args.push_back("true");
+    }
+
+    return args;
+}
+
+//____________________________________________________________________________//
+/**
+*   @brief Loads the test library and initializes the Boost UTF test tree without executing any tests.
+*          Boost UTF test selection arguments (e.g. --run_test) are applied to the enabled status of the test units.
+*
+*   @param [in]  argc   argument count
+*   @param [in]  argv   argument vector
+*/
+void LoadTestTree(int argc, char* argv[])
+{
+    ::boost::unit_test::framework::init(&init_test_tree, argc, argv);
+    ::boost::unit_test::framework::finalize_setup_phase();
+
+    // The run status of the test units (i.e. the default run status with the test selection applied) is
+    // otherwise only assigned once the Boost UTF executes tests
+    ::boost::unit_test::framework::impl::setup_for_execution(::boost::unit_test::framework::master_test_suite());
+}
+
+//____________________________________________________________________________//
+
+typedef std::vector<std::unique_ptr<std::ostream>> TOutputStreams;
+typedef std::vector<std::unique_ptr<::etas::boost::unit_test::ITestResultListener>> TResultListeners;
+typedef std::vector<::etas::boost::unit_test::ITestResultListener*> TResultListenerPtrs;
+
+/**
+*   @brief Command line arguments (taking a value) which are only relevant to the test runner process which
+*          supervises child processes and are hence not forwarded to them
+*/
+static const char* const parent_only_arguments[] = {
+    "test-timeout", "run-timeout", "timeout-config", "snapshot-dir", "alloc-report",
+    "shard-index", "shard-count", "shard-durations", "shard-plan", "results", "journal", "resume",
+    "rerun-failures", "flaky-stats", "junit", "discover", "discover-debug", "compress", "file-dictionary", "expand-families",
+    "history", "history-keep", "placement", "reserve-cores", "reserve-label", "worker-cpus", "worker-node", "worker-test",
+    "limit-memory", "limit-cpu", "limit-files", "limit-processes", "limit-cgroup", "worker-limits",
+    "trace", "trace-fragment", "run-list", "async-log-append"
+};
+
+/**
+*   @brief Creates the test result listeners requested via the command line
+*
+*   @param [in]  P          Reference to the object handling the command line parsing
+*   @param [out] streams    receives the output streams used by the listeners
+*   @param [out] listeners  receives the listeners created by this method
+*   @return                 all listeners to notify, i.e. the created listeners and the run journal (if any)
+*/
+TResultListenerPtrs CreateResultListeners(const cla::parser& P, TOutputStreams& streams, TResultListeners& listeners)
+{
+    TResultListenerPtrs active;
+
+    if (P["results"])
+    {
+        streams.push_back(GetListOutputStream(P, "results"));
+
+        std::unique_ptr<::etas::boost::unit_test::CTestResultsWriter> writer(new ::etas::boost::unit_test::CTestResultsWriter(test_lib_name, streams.back().get()));
+
+        if (run_journal)
+        {
+            // The report combines the results of the interrupted run(s) with the results of this run
+            writer->AddPriorResults(run_journal->GetJournalledResults());
+        }
+
+        if (worker_placement)
+        {
+            writer->SetTopology(worker_placement->DescribeTopology("    "));
+        }
+
+        listeners.push_back(std::move(writer));
+    }
+
+    if (P["junit"])
+    {
+        std::unique_ptr<::etas::boost::unit_test::CJUnitReportWriter> junit(new ::etas::boost::unit_test::CJUnitReportWriter(test_lib_name, GetArgument(P, "junit")));
+
+        // Failed test cases are reported again with the result of their reruns (see ConfigureFlakyTestDetection)
+        junit->SetDeferFailures(GetNumericArgument(P, "rerun-failures") > 0);
+
+        listeners.push_back(std::move(junit));
+    }
+
+    if (P["history"])
+    {
+        std::unique_ptr<::etas::boost::unit_test::CTestHistory> history(new ::etas::boost::unit_test::CTestHistory(GetArgument(P, "history"),
+            P["history-keep"] ? GetNumericArgument(P, "history-keep") : 16));
+
+        history->Load();
+
+        listeners.push_back(std::move(history));
+    }
+
+    for (auto i = listeners.begin(), end = listeners.end(); i != end; ++i)
+    {
+        active.push_back(i->get());
+    }
+
+    if (run_journal)
+    {
+        active.push_back(run_journal.get());
+    }
+
+    return active;
+}
+
+//____________________________________________________________________________//
+/**
+*   @brief Opens the run journal as requested via the command line (if any)
+*
+*   @param [in]  P   Reference to the object handling the command line parsing
+*/
+void ConfigureJournal(const cla::parser& P)
+{
+    if (!P["journal"] && !P["resume"])
+    {
+        return;
+    }
+
+    const bool resume = P["resume"];
+
+    run_journal.reset(new ::etas::boost::unit_test::CRunJournal(
+        GetArgument(P, resume ? "resume" : "journal"),
+        ::etas::boost::unit_test::CRunJournal::GetFingerprint(test_lib_name)
+    ));
+
+    if (run_journal->Open(resume))
+    {
+        std::cout << "Resuming test run: " << run_journal->GetJournalledResults().size() << " test cases have already been executed" << std::endl;
+    }
+    else if (resume)
+    {
+        std::cout << "No journal of the same test library build found; starting a new test run" << std::endl;
+    }
+}
+
+//____________________________________________________________________________//
+/**
+*   @brief Reads the selection of test units to execute as requested via the command line (if any)
+*
+*   @param [in]  P      Reference to the object handling the command line parsing
+*   @param [in]  argc   argument count
+*   @param [in]  argv   argument vector
+*   @throw std::logic_error in case the selection is combined with Boost UTF run filters
+*/
+void ConfigureRunList(const cla::parser& P, int argc, char* argv[])
+{
+    if (P["worker-test"])
+    {
+        // A child process of an isolated test run executes a single test case, selected by id, along with its dependencies
+        std::istringstream in(GetArgument(P, "worker-test"));
+
+        run_list.reset(new ::etas::boost::unit_test::CTestRunList);
+        run_list->Read(in);
+        run_list->SetSelectDependencies(true);
+
+        return;
+    }
+
+    if (!P["run-list"])
+    {
+        return;
+    }
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg(argv[i]);
+
+        // Boost UTF run filters take precedence over the default run status of test units
+        if ((arg == "-t") || (arg.compare(0, 10, "--run_test") == 0))
+        {
+            throw std::logic_error("--run-list cannot be combined with --run_test");
+        }
+    }
+
+    std::unique_ptr<std::istream> in = ::etas::boost::unit_test::OpenInputFile(GetArgument(P, "run-list"));
+
+    run_list.reset(new ::etas::boost::unit_test::CTestRunList);
+    run_list->Read(*in);
+}
+
+//____________________________________________________________________________//
+/**
+*   @brief Configures the discovery document to write prior to executing tests as requested via the command line (if any)
+*
+*   @param [in]  P   Reference to the object handling the command line parsing
+*/
+void ConfigureDiscovery(const cla::parser& P)
+{
+    if (!P["discover"] && !P["discover-debug"])
+    {
+        return;
+    }
+
+    const std::string arg = P["discover"] ? "discover" : "discover-debug";
+
+    discovery_out = GetListOutputStream(P, arg);
+    discovery_lister = GetTestTreeLister(P["discover"] ? "list" : "list-debug", test_lib_name, discovery_out.get(),
+        GetBooleanArgument(P, "file-dictionary"), GetBooleanArgument(P, "expand-families"));
+    discovery_lister->WriteHeader();
+}
+
+//____________________________________________________________________________//
+/**
+*   @brief Configures the placement of child processes as requested via the command line (if any)
+*
+*   @param [in]  P   Reference to the object handling the command line parsing
+*/
+void ConfigurePlacement(const cla::parser& P)
+{
+    if (!P["placement"] && !P["reserve-cores"])
+    {
+        return;
+    }
+
+    ::etas::boost::unit_test::EPlacementPolicy policy = ::etas::boost::unit_test::PlacementNone;
+
+    if (P["placement"] && !::etas::boost::unit_test::ParsePlacementPolicy(GetArgument(P, "placement"), policy))
+    {
+        throw std::logic_error("--placement needs to be either 'none', 'core' or 'node'");
+    }
+
+    worker_placement.reset(new ::etas::boost::unit_test::CWorkerPlacement(policy,
+        P["reserve-cores"] ? GetNumericArgument(P, "reserve-cores") : 0,
+        P["reserve-label"] ? GetArgument(P, "reserve-label") : "benchmark"));
+}
+
+//____________________________________________________________________________//
+/**
+*   @brief Applies the placement which the parent test runner assigned to this (child) process (if any)
+*
+*   @param [in]  P   Reference to the object handling the command line parsing
+*/
+void ApplyWorkerPlacement(const cla::parser& P)
+{
+    ::etas::boost::unit_test::CWorkerPlacement::SPlacement placement;
+
+    if (P["worker-cpus"] && !::etas::boost::unit_test::CWorkerPlacement::ParseCpus(GetArgument(P, "worker-cpus"), placement.m_cpus))
+    {
+        throw std::logic_error("--worker-cpus needs to be a list of processors, e.g. '0-3,8'");
+    }
+
+    if (P["worker-node"])
+    {
+        placement.m_node = static_cast<int>(GetNumericArgument(P, "worker-node"));
+    }
+
+    ::etas::boost::unit_test::CWorkerPlacement::Apply(placement);
+}
+
+//____________________________________________________________________________//
+/**
+*   @brief Configures test case sharding as requested via the command line (if any)
+*
+*   @param [in]  P   Reference to the object handling the command line parsing
+*/
+void ConfigureSharding(const cla::parser& P)
+{
+    if (!P["shard-count"])
+    {
+        return;
+    }
+
+    test_sharder.reset(new ::etas::boost::unit_test::CTestSharder(GetNumericArgument(P, "shard-index"), GetNumericArgument(P, "shard-count")));
+
+    if (P["shard-durations"])
+    {
+        std::unique_ptr<std::istream> durations = ::etas::boost::unit_test::OpenInputFile(GetArgument(P, "shard-durations"));
+        test_sharder->AddDurations(::etas::boost::unit_test::CTestResultsWriter::Read(*durations));
+    }
+
+    if (P["shard-plan"])
+    {
+        shard_plan_out = GetListOutputStream(P, "shard-plan");
+    }
+}
+
+//____________________________________________________________________________//
+/**
+*   @brief Configures the timeline of the test run as requested via the command line (if any). Child processes of
+*          an isolated test run record a timeline fragment as requested by the parent test runner via --trace-fragment.
+*
+*   @param [in]  P   Reference to the object handling the command line parsing
+*/
+void ConfigureTrace(const cla::parser& P)
+{
+    if (P["trace-fragment"])
+    {
+        trace_timeline.reset(new ::etas::boost::unit_test::CTraceTimeline("worker"));
+    }
+    else if (P["trace"])
+    {
+        trace_timeline.reset(new ::etas::boost::unit_test::CTraceTimeline("test runner"));
+    }
+}
+
+//____________________________________________________________________________//
+/**
+*   @brief Writes out the timeline of the test run (if any)
+*
+*   @param [in]  P   Reference to the object handling the command line parsing
+*/
+void WriteTrace(const cla::parser& P)
+{
+    if (!trace_timeline)
+    {
+        return;
+    }
+
+    if (P["trace-fragment"])
+    {
+        trace_timeline->WriteFragment(GetArgument(P, "trace-fragment"));
+    }
+    else
+    {
+        std::unique_ptr<std::ostream> out = GetListOutputStream(P, "trace");
+        trace_timeline->Write(*out);
+    }
+
+    trace_timeline.reset();
+}
+
+//____________________________________________________________________________//
+/**
+*   @brief Method handling the merge of partial test result files (e.g. of multiple shards) into a single file.
+*
+*   @param [in]  P   Reference to the object handling the command line parsing
+*   @return          Returns either boost::exit_success or boost::exit_failure
+*/
+int MergeResults(const cla::parser& P)
+{
+    std::vector<std::string> inputs;
+
+    const std::string list = GetArgument(P, "merge-results");
+
+    for (std::string::size_type begin = 0, end = 0; begin < list.length(); begin = end + 1)
+    {
+        end = list.find(';', begin);
+        end = (end == std::string::npos) ? list.length() : end;
+
+        if (end > begin)
+        {
+            inputs.push_back(list.substr(begin, end - begin));
+        }
+    }
+
+    std::unique_ptr<std::ostream> out = P["results"] ? GetListOutputStream(P, "results") : std::unique_ptr<std::ostream>();
+
+    try
+    {
+        ::etas::boost::unit_test::CTestResultsWriter::Merge(inputs, out ? *out : std::cout);
+    }
+    catch (std::exception& ex)
+    {
+        std::cout << ex.what() << std::endl;
+        return ::boost::exit_failure;
+    }
+
+    return ::boost::exit_success;
+}
 
-namespace dyn_lib
+//____________________________________________________________________________//
+/**
+*   @brief Method handling the report of a recorded test history
+*
+*   @param [in]  P   Reference to the object handling the command line parsing
+*   @return          Returns either boost::exit_success or boost::exit_failure
+*/
+int QueryHistory(const cla::parser& P)
 {
-#if defined(BOOST_WINDOWS) && !defined(BOOST_DISABLE_WIN32) // WIN32 API
+    try
+    {
+        ::etas::boost::unit_test::CTestHistory history(GetArgument(P, "history-query"), 0);
+        history.Load();
 
-#include <windows.h>
+        history.WriteReport(std::cout, P["history-test"] ? GetArgument(P, "history-test") : std::string());
+    }
+    catch (std::exception& ex)
+    {
+        std::cout << ex.what() << std::endl;
+        return ::boost::exit_failure;
+    }
 
-typedef HINSTANCE handle;
+    return ::boost::exit_success;
+}
 
+//____________________________________________________________________________//
 /**
-@brief Loads a dll library on the Windows OS
+*   @brief States whether resource limits of the test cases are requested via the command line
+*
+*   @param [in]  P   Reference to the object handling the command line parsing
 */
-inline handle
-open(std::string const& file_name)
+bool HasResourceLimits(const cla::parser& P)
 {
-    return LoadLibrary(file_name.c_str());
+    return P["limit-memory"] || P["limit-cpu"] || P["limit-files"] || P["limit-processes"];
 }
 
-//_________________________________________________________________//
-
+//____________________________________________________________________________//
 /**
-@brief Locates a method inside the loaded library on the Windows OS. The method needs to have C style interface. In case of troubles at this step it is
-suggested the use of dependency walker (http://www.dependencywalker.com/) so that it is made sure that the mangling used when generating
-the dll has been of correct type.
+*   @brief Configures the resource limits of the child processes as requested via the command line
+*
+*   @param [in]  P      Reference to the object handling the command line parsing
+*   @param [out] limits the resource limits to configure
 */
-template<typename TargType>
-inline TargType
-locate_symbol(handle h, std::string const& symbol)
+void ConfigureResourceLimits(const cla::parser& P, ::etas::boost::unit_test::SResourceLimits& limits)
 {
-    return reinterpret_cast<TargType>(GetProcAddress(h, symbol.c_str()));
-}
+    if (P["limit-memory"])
+    {
+        limits.m_memory = static_cast<std::uint64_t>(GetNumericArgument(P, "limit-memory")) << 20;
+    }
+
+    if (P["limit-cpu"])
+    {
+        limits.m_cpuTime = GetNumericArgument(P, "limit-cpu");
+    }
 
-//_________________________________________________________________//
+    if (P["limit-files"])
+    {
+        limits.m_openFiles = GetNumericArgument(P, "limit-files");
+    }
+
+    if (P["limit-processes"])
+    {
+        limits.m_processes = GetNumericArgument(P, "limit-processes");
+    }
+}
 
+//____________________________________________________________________________//
 /**
-@brief  Unloads a library on the Windows OS
+*   @brief Creates the asynchronous log sink requested via the command line (if any)
+*
+*   @param [in]  P      Reference to the object handling the command line parsing
+*   @param [in]  append true to append to an existing log file; false to start the log file afresh
+*   @return             the log sink; nullptr in case no asynchronous log is requested
 */
-inline void
-close(handle h)
+std::unique_ptr<::etas::boost::unit_test::CAsyncLogSink> CreateAsyncLog(const cla::parser& P, bool append)
 {
-    if (h)
+    if (!P["async-log"])
     {
-        FreeLibrary(h);
+        return std::unique_ptr<::etas::boost::unit_test::CAsyncLogSink>();
     }
-}
 
-//_________________________________________________________________//
+    ::etas::boost::unit_test::CAsyncLogSink::EOverflowPolicy policy = ::etas::boost::unit_test::CAsyncLogSink::OverflowBlock;
 
-inline std::string
-error()
-{
-    LPTSTR msg = NULL;
+    if (P["async-log-policy"] && !::etas::boost::unit_test::CAsyncLogSink::ParseOverflowPolicy(GetArgument(P, "async-log-policy"), policy))
+    {
+        throw std::logic_error("--async-log-policy needs to be either 'block' or 'drop'");
+    }
 
-    FormatMessage(FORMAT_MESSAGE_ALLOCATE_BUFFER | FORMAT_MESSAGE_FROM_SYSTEM,
-                  NULL,
-                  GetLastError(),
-                  MAKELANGID(LANG_NEUTRAL, SUBLANG_DEFAULT),
-                  (LPTSTR)&msg,
-                  0, NULL);
+    return std::unique_ptr<::etas::boost::unit_test::CAsyncLogSink>(new ::etas::boost::unit_test::CAsyncLogSink(GetArgument(P, "async-log"),
+        (P["async-log-size"] ? GetNumericArgument(P, "async-log-size") : 1024) * 1024, policy, append));
+}
 
-    std::string res;
+//____________________________________________________________________________//
+/**
+*   @brief Configures an isolated test runner as requested via the command line: stack snapshots, worker placement,
+*          resource limits and tracing. Applies to every runner of a test run alike, reruns of flaky tests included.
+*
+*   @param [in]  P      Reference to the object handling the command line parsing
+*   @param [out] runner the isolated test runner to configure
+*/
+void ConfigureIsolatedTestRunner(const cla::parser& P, ::etas::boost::unit_test::CIsolatedTestRunner& runner)
+{
+    runner.SetSnapshotDirectory(GetArgument(P, "snapshot-dir"));
+    runner.SetPlacement(worker_placement.get());
 
-    if (msg)
+    if (trace_timeline)
     {
-        res = msg;
-        LocalFree(msg);
+        runner.SetTraceTimeline(trace_timeline.get(), GetArgument(P, "trace") + ".worker");
     }
 
-    return res;
+    ::etas::boost::unit_test::SResourceLimits limits;
+    ConfigureResourceLimits(P, limits);
+    runner.SetResourceLimits(limits, GetArgument(P, "limit-cgroup"));
 }
 
-//_________________________________________________________________//
+//____________________________________________________________________________//
+/**
+*   @brief Configures a timeout policy as requested via the command line
+*
+*   @param [in]  P      Reference to the object handling the command line parsing
+*   @param [out] policy the timeout policy to configure
+*/
+void ConfigureTimeouts(const cla::parser& P, ::etas::boost::unit_test::CTimeoutPolicy& policy)
+{
+    if (P["timeout-config"])
+    {
+        std::ifstream config(GetArgument(P, "timeout-config"));
+
+        if (!config)
+        {
+            throw std::logic_error("Fail to open timeout configuration: " + GetArgument(P, "timeout-config"));
+        }
 
-#elif defined(BOOST_HAS_UNISTD_H) // POSIX API
+        policy.Load(config);
+    }
 
-#include <dlfcn.h>
+    if (P["test-timeout"])
+    {
+        policy.SetDefaultTimeout(GetNumericArgument(P, "test-timeout"));
+    }
 
-#include <sys/types.h>
-#include <sys/stat.h>
-#include <fcntl.h>
+    if (P["run-timeout"])
+    {
+        policy.SetGlobalTimeout(GetNumericArgument(P, "run-timeout"));
+    }
+}
 
-typedef void* handle;
+//____________________________________________________________________________//
 
 /**
-*   @brief Loads a dll library on a POSIX run-time environment
+*   @brief Objects involved in the detection of flaky tests
 */
-inline handle
-open(std::string const& file_name)
+struct SFlakyTestDetection
 {
-    return dlopen(file_name.c_str(), RTLD_LOCAL | RTLD_LAZY);
-}
+    ::etas::boost::unit_test::CTimeoutPolicy m_policy;
+    std::unique_ptr<::etas::boost::unit_test::CIsolatedTestRunner> m_runner;
+    std::unique_ptr<::etas::boost::unit_test::CFlakyTestDetector> m_detector;
+    std::unique_ptr<::etas::boost::unit_test::CFlakinessStatistics> m_statistics;
+};
 
-//_________________________________________________________________//
 /**
-*    @brief Locates a method inside the loaded library on a POSIX run-time environment
+*   @brief Sets up the detection of flaky tests as requested via the command line (if any)
+*
+*   @param [in]  P          Reference to the object handling the command line parsing
+*   @param [in]  argc       argument count
+*   @param [in]  argv       argument vector
+*   @param [in]  active     the listeners to notify of test case results
+*   @param [out] detection  receives the objects involved in the detection
+*   @return                 the listeners to register with the test run: either the flaky test detector (which
+*                           forwards to the supplied listeners) or the supplied listeners as-is
 */
-template<typename TargType>
-inline TargType
-locate_symbol(handle h, std::string const& symbol)
+TResultListenerPtrs ConfigureFlakyTestDetection(const cla::parser& P, int argc, char* argv[], const TResultListenerPtrs& active, SFlakyTestDetection& detection)
 {
-    return reinterpret_cast<TargType>(dlsym(h, symbol.c_str()));
-}
+    const unsigned long reruns = GetNumericArgument(P, "rerun-failures");
 
-//_________________________________________________________________//
-/*
-*   @brief Unloads a dll library on a POSIX run-time environment
-*/
-inline void
-close(handle h)
-{
-    if (h)
+    if (reruns == 0)
     {
-        dlclose(h);
+        return active;
     }
-}
-
-//_________________________________________________________________//
-
-inline std::string
-error()
-{
-    return dlerror();
-}
 
-//_________________________________________________________________//
+    ConfigureTimeouts(P, detection.m_policy);
 
-#else
+    detection.m_runner.reset(new ::etas::boost::unit_test::CIsolatedTestRunner(
+        ::etas::boost::unit_test::CChildProcess::GetCurrentExecutable(argv[0]),
+        GetChildArguments(argc, argv, std::vector<std::string>(std::begin(parent_only_arguments), std::end(parent_only_arguments))),
+        detection.m_policy
+    ));
 
-#error "Dynamic library API is unknown"
+    ConfigureIsolatedTestRunner(P, *detection.m_runner);
 
-#endif
-} // namespace dyn_lib
+    detection.m_detector.reset(new ::etas::boost::unit_test::CFlakyTestDetector(static_cast<unsigned int>(reruns), *detection.m_runner, std::cout));
 
-//____________________________________________________________________________//
+    for (auto i = active.begin(), end = active.end(); i != end; ++i)
+    {
+        detection.m_detector->AddListener(**i);
+    }
 
-static std::string test_lib_name;
-static std::string init_func_name("init_unit_test");
+    if (P["flaky-stats"])
+    {
+        detection.m_statistics.reset(new ::etas::boost::unit_test::CFlakinessStatistics(GetArgument(P, "flaky-stats")));
+        detection.m_statistics->Load();
 
-dyn_lib::handle test_lib_handle;
+        detection.m_detector->SetStatistics(detection.m_statistics.get());
+    }
 
-typedef bool (*init_func_ptr)();
+    return TResultListenerPtrs(1, detection.m_detector.get());
+}
 
-//____________________________________________________________________________//
 /**
-*   @brief Load the Boost UTF dll containing the tests, locate the initialization method
-*          (either the default "init_unit_test" or the one supplied via parameter --init) and in case
-*          the initialization method is found, call it.
+*   @brief Completes the detection of flaky tests (if configured), i.e. persists statistics and determines the exit code
 *
-*   @return returns true in case the initialization method has not been located (so that the enumeration can proceed anyway)
-*            In case the initialization method has been found, the method is called and whatever status that method return returns
-*           is returned by load_test_lib
+*   @param [in]  detection  the objects involved in the detection
+*   @param [in]  res        the exit code of the test run
+*   @return                 the exit code of the test run taking the classification of flaky tests into account
 */
-bool load_test_lib()
+int CompleteFlakyTestDetection(const SFlakyTestDetection& detection, int res)
 {
-    init_func_ptr init_func;
-
-    test_lib_handle = dyn_lib::open(test_lib_name);    //load the library via the relevant OS API
-
-    if (!test_lib_handle)
-        throw std::logic_error(std::string("Fail to load test library: ")
-                               .append(dyn_lib::error()));
-
-    init_func = dyn_lib::locate_symbol<init_func_ptr>(test_lib_handle, init_func_name);    //locate the initialization method inside the library
+    if (!detection.m_detector || ((res != ::boost::exit_success) && (res != ::boost::exit_test_failure)))
+    {
+        return res;
+    }
 
-    /**
-    @note It has been decided to suppress that the raise of an exception in case the initialization method is not method.  At any rate the user
-    will know that his manually registered tests has not been listed because they will not appear in the XML file.
-    */
-    /*
-    if( !init_func )
-    throw std::logic_error( std::string("Can't locate test initialization function ")
-    .append( init_func_name )
-    .append( ": " )
-    .append( dyn_lib::error() ) );
-    */
+    if (detection.m_statistics)
+    {
+        detection.m_statistics->Save();
+    }
 
-    return (init_func == nullptr) || ((*init_func)());
+    // Flaky test cases do not fail the test run
+    return detection.m_detector->HasFailures() ? ::boost::exit_test_failure : ::boost::exit_success;
 }
 
 //____________________________________________________________________________//
 /**
-*   @brief Generates an object of type ofstream so as to write to file
+*   @brief Method handling the execution of the tests in the test runner process.
 *
-*   @param [in]  P   Reference to the object handling the command line parsing
-*   @param [in]  arg Full filepath where to write the XML file to
+*   @param [in]  P      Reference to the object handling the command line parsing
+*   @param [in]  argc   argument count
+*   @param [in]  argv   argument vector
+*   @return             The Boost UTF exit code
 */
-std::unique_ptr<std::ofstream> GetListOutputStream(const cla::parser& P, const std::string& arg)
+int RunTests(const cla::parser& P, int argc, char* argv[])
 {
-    std::string listOut;
-    assign_op(listOut, P.get(arg), 0);
+    std::unique_ptr<std::ostream> allocOut;
+    std::unique_ptr<::etas::boost::unit_test::CAllocationTracker> allocTracker;
 
-    if (!listOut.empty())
+    if (P["alloc-report"])
     {
-        return std::unique_ptr<std::ofstream>(new std::ofstream(listOut, (std::ios_base::out | std::ios_base::trunc)));
+        allocOut = GetListOutputStream(P, "alloc-report");
+
+        if (!::etas::boost::unit_test::CAllocationTracker::IsSupported())
+        {
+            std::cout << "Allocation tracking is not supported on this platform/configuration" << std::endl;
+        }
+
+        allocTracker.reset(new ::etas::boost::unit_test::CAllocationTracker(test_lib_name, allocOut.get()));
+        run_observers.push_back(allocTracker.get());
     }
 
-    return std::unique_ptr<std::ofstream>();
-}
+    std::unique_ptr<::etas::boost::unit_test::CSamplingProfiler> profiler;
 
-//____________________________________________________________________________//
+    if (P["profile-tests"])
+    {
+        profiler.reset(new ::etas::boost::unit_test::CSamplingProfiler(GetArgument(P, "profile-tests"),
+            P["profile-interval"] ? GetNumericArgument(P, "profile-interval") : 1000,
+            P["profile-threshold"] ? GetNumericArgument(P, "profile-threshold") : 0));
+        run_observers.push_back(profiler.get());
+    }
 
-typedef std::unique_ptr<::etas::boost::unit_test::CBoostTestTreeLister> TBoostTestTreeListerPtr;
+    // Child processes of a test runner append to the log file which their parent has started
+    async_log = CreateAsyncLog(P, GetBooleanArgument(P, "async-log-append"));
 
-/*
-*   @brief Factory method return the correct type of test enumerator(lister) depending on the verbosity required
-*
-*   @param [in]  arg      string containing either either "list" or "list-debug" on which the factory method will use to determine the type of lister to return
-*   @param [in]  dll      library path containing the Boost UTF tests
-*   @param [in]  out      pointer to an output stream class which the test enumerator will use to output the report
-*   @return      object   of either type CBoostTestTreeLister or CBoostTestTreeDebugLister depending on the verbosity required as supplied by argument arg
-*/
-TBoostTestTreeListerPtr GetTestTreeLister(const std::string& arg, const std::string dll, std::ostream* out = nullptr)
-{
-    out = (out == nullptr) ? &std::cout : out;
+    std::unique_ptr<::etas::boost::unit_test::CTraceObserver> traceObserver;
 
-    if (arg == "list")
+    if (trace_timeline)
     {
-        return TBoostTestTreeListerPtr(new ::etas::boost::unit_test::CBoostTestTreeLister(dll, out)); //less detail
+        traceObserver.reset(new ::etas::boost::unit_test::CTraceObserver(*trace_timeline));
+        run_observers.push_back(traceObserver.get());
     }
-    else
+
+    std::unique_ptr<::etas::boost::unit_test::COutputCapture> capture;
+
+    if (P["capture-output"])
     {
-        return TBoostTestTreeListerPtr(new ::etas::boost::unit_test::CBoostTestTreeDebugLister(dll, out)); //more detail
+        // The Boost UTF log is captured along with the test case output and restored to its destination afterwards
+        capture.reset(new ::etas::boost::unit_test::COutputCapture(GetNumericArgument(P, "capture-output") * 1024,
+            async_log ? async_log->GetStream() : std::cout));
     }
 
-}
+    TOutputStreams streams;
+    TResultListeners listeners;
+    SFlakyTestDetection detection;
+    TResultListenerPtrs active = ConfigureFlakyTestDetection(P, argc, argv, CreateResultListeners(P, streams, listeners), detection);
 
-//____________________________________________________________________________//
-/**
-*   @brief Method utilized to format and write any exceptions to the output stream
-*
-*   @param [in] out    reference to the output stream where to write the exception to
-*   @param [in] dll    library path containing the Boost UTF tests
-*   @param [in] error  exception detail
-*/
-std::ostream& WriteError(std::ostream& out, const std::string& dll, const std::string& error = std::string())
-{
-    out << "<![CDATA[Error: Could not load " << dll << '.';
+    ::etas::boost::unit_test::CTestResultObserver resultObserver;
 
-    if (!error.empty())
+    for (auto i = active.begin(), end = active.end(); i != end; ++i)
     {
-        out << " Detail: " << error;
+        resultObserver.AddListener(**i);
     }
 
-    out << "]]>";
+    resultObserver.SetOutputCapture(capture.get());
 
-    return out;
+    if (resultObserver.HasListeners() || capture)
+    {
+        run_observers.push_back(&resultObserver);
+    }
+
+    if (P["snapshot-file"])
+    {
+        // This process is a child of an isolated test run
+        ::etas::boost::unit_test::CChildProcess::InstallSnapshotHandler(GetArgument(P, "snapshot-file"));
+    }
+
+    int res = ::boost::unit_test::unit_test_main(&init_test_run, argc, argv);
+
+    if (async_log)
+    {
+        // Detach the log before writing out and stopping the sink
+        ::boost::unit_test::unit_test_log.set_stream(std::cout);
+        async_log.reset();
+    }
+
+    return CompleteFlakyTestDetection(detection, res);
 }
 
 //____________________________________________________________________________//
 /**
-*   @brief Method handling the enumeration of the tests.
+*   @brief Method handling the execution of the tests, each one in a dedicated child process, under timeout supervision.
 *
-*   @param [in]  P   Reference to the object handling the command line parsing
-*   @return          Returns either boost::exit_success or boost::exit_failure
+*   @param [in]  P      Reference to the object handling the command line parsing
+*   @param [in]  argc   argument count
+*   @param [in]  argv   argument vector
+*   @return             Either boost::exit_success, boost::exit_test_failure or boost::exit_exception_failure
 */
-int ListTests(const cla::parser& P)
+int RunTestsIsolated(const cla::parser& P, int argc, char* argv[])
 {
-    int res = ::boost::exit_success;
+    ::etas::boost::unit_test::CTimeoutPolicy policy;
+    ConfigureTimeouts(P, policy);
 
-    std::string arg = (P["list"]) ? "list" : "list-debug";
+    // Starts the log file afresh; the child processes append to it
+    std::unique_ptr<::etas::boost::unit_test::CAsyncLogSink> log = CreateAsyncLog(P, false);
+
+    try
+    {
+        LoadTestTree(argc, argv);
+    }
+    catch (std::exception& ex)
+    {
+        WriteError(std::cout, test_lib_name, ((ex.what() == nullptr) ? std::string() : ex.what())) << std::endl;
+        return ::boost::exit_exception_failure;
+    }
 
-    std::unique_ptr<std::ofstream> out = GetListOutputStream(P, arg);
-    TBoostTestTreeListerPtr lister = GetTestTreeLister(arg, test_lib_name, out.get());
+    ::etas::boost::unit_test::CTestCaseCollector collector;
 
-    if (lister != nullptr)
     {
-        std::ostream& listing = lister->WriteHeader();
+        ::etas::boost::unit_test::CTraceSpan span(trace_timeline.get(), "traversal", "collect test cases");
+        ::boost::unit_test::traverse_test_tree(::boost::unit_test::framework::master_test_suite(), collector);
+    }
 
-        try
-        {
-            /**
-            * Load library before enumerating test suite to ensure correct registration.
-            * Execute initialization function since it may be the case that client code registers custom tests
-            */
-            if (load_test_lib())
-            {
-                //if the loading the library was successfull, then we proceed in enumerating the tests.
-                ::boost::unit_test::traverse_test_tree(::boost::unit_test::framework::master_test_suite(), *lister);
-            }
-        }
-        catch (std::exception& ex)
-        {
-            WriteError(listing, test_lib_name, ((ex.what() == nullptr) ? std::string() : ex.what()));
-            res = ::boost::exit_failure;
-        }
-        catch (...)
-        {
-            WriteError(listing, test_lib_name);
-            res = ::boost::exit_failure;
-        }
+    ::etas::boost::unit_test::CIsolatedTestRunner runner(
+        ::etas::boost::unit_test::CChildProcess::GetCurrentExecutable(argv[0]),
+        GetChildArguments(argc, argv, std::vector<std::string>(std::begin(parent_only_arguments), std::end(parent_only_arguments))),
+        policy
+    );
 
-        lister->WriteTrailer();
+    ConfigureIsolatedTestRunner(P, runner);
+
+    TOutputStreams streams;
+    TResultListeners listeners;
+    SFlakyTestDetection detection;
+    TResultListenerPtrs active = ConfigureFlakyTestDetection(P, argc, argv, CreateResultListeners(P, streams, listeners), detection);
+
+    for (auto i = active.begin(), end = active.end(); i != end; ++i)
+    {
+        runner.AddListener(**i);
     }
 
-    return res;
+    return CompleteFlakyTestDetection(detection, runner.Run(collector.GetTestCases(), std::cout));
 }
 
 //____________________________________________________________________________//
@@ -356,6 +1326,148 @@ int ListTests(const cla::parser& P)
 *   @par --test
 *   used to define the path and the name of the DLL containing the Boost UTF tests.
 *
+*   @par --alloc-report
+*   used to define the path of an output XML file which will contain the heap allocation figures of each executed test case: the number of allocations,
+*   the number of bytes allocated, the peak number of live bytes and the number of bytes allocated by the test which are still live at its end.
+*   Allocations are intercepted for the whole process, the test library included. Interception is supported on glibc based systems and on Windows
+*   debug builds (via the CRT allocation hook); sizes are accounted in terms of usable block sizes.
+*
+*   @par --test-timeout
+*   used to define the default time budget, in seconds, of each test case. When any of the timeout directives is supplied, each test case is executed in a
+*   dedicated child process of the Boost External Test Runner. A test case which overruns its time budget is terminated along with its process, reported as
+*   <b>timeout</b> and execution proceeds with the remaining test cases. A Boost UTF <c>timeout</c> decorator takes precedence over any configured timeout.
+*   The --alloc-report directive is not supported in this mode.
+*
+*   @par --run-timeout
+*   used to define the time budget, in seconds, of the whole test run. Test cases which have not been started once the budget is spent are reported as <b>skipped</b>.
+*
+*   @par --timeout-config
+*   used to define the path of a file configuring timeouts per test suite and per label. Each line has the form <c>default = {seconds}</c>, <c>global = {seconds}</c>,
+*   <c>suite:{test suite path} = {seconds}</c> or <c>label:{label} = {seconds}</c>; lines starting with '#' are comments. Label timeouts take precedence over
+*   suite timeouts and the innermost suite applies. The --test-timeout and --run-timeout directives override the respective values of the file.
+*
+*   @par --snapshot-dir
+*   used to define the directory where a stack snapshot of timed out test cases is written to: a minidump (<c>.dmp</c>) on Windows and a backtrace (<c>.stack</c>)
+*   on POSIX systems.
+*
+*   @par --placement
+*   used to pin the child processes executing test cases to processors: <c>core</c> pins each child process to a single core and <c>node</c> to the cores of
+*   a NUMA node, both round-robin over the processors available to the Boost External Test Runner; <c>none</c> (default) does not pin child processes. On
+*   machines with multiple NUMA nodes, the memory of a pinned child process is bound to the node of its cores (on Windows, memory is allocated on the local
+*   node by default). The directive implies that each test case is executed in a dedicated child process. The topology and the placement of each test case
+*   are reported in the <b>--results</b> file (<c>Topology</c> element and <c>cpus</c> and <c>node</c> attributes) so that timings can be reproduced.
+*
+*   @par --reserve-cores, --reserve-label
+*   used to reserve the given number of cores (the highest numbered ones) for test cases labelled as <b>--reserve-label</b> (defaults to <c>benchmark</c>),
+*   e.g. <c>BoostExternalTestRunner.exe --test "{source}" --placement core --reserve-cores 2</c>. Labelled test cases only run on the reserved cores and all
+*   other test cases are kept clear of them. The directive implies that each test case is executed in a dedicated child process.
+*
+*   @par --limit-memory, --limit-cpu, --limit-files, --limit-processes
+*   used to limit the resources of each test case: memory in MiB, processor time in seconds, the number of open files and the number of processes (the
+*   test case process included), e.g. <c>BoostExternalTestRunner.exe --test "{source}" --limit-memory 512 --limit-cpu 60</c>. The directives imply that
+*   each test case is executed in a dedicated child process. A test case which is stopped by one of its limits is reported as <b>resource-limit</b> along
+*   with the exceeded limit and the high-water marks of its memory, processor time, open files and processes. On Linux, memory and processes are limited
+*   via a cgroup v2 group per test case in case one can be created below the cgroup of the Boost External Test Runner (or below <b>--limit-cgroup</b>, a
+*   delegated cgroup v2 directory); otherwise memory is limited in terms of address space and processes are not limited. Processor time and open files
+*   are limited via <c>setrlimit</c>. On Windows, the limits are enforced via job objects (memory in terms of committed memory); open files are not limited.
+*
+*   @par --trace
+*   used to define the path of an output Chrome trace event JSON file (as opened by chrome://tracing or https://ui.perfetto.dev) containing a timeline of the
+*   test run: the loading of the test library, the initialization function, the traversals of the test tree, the setup and teardown of each test suite and
+*   each test case. Suite setup and teardown are measured as the time ahead of the first and after the last child of the suite. When test cases are executed
+*   in child processes, each child process is shown as a process of its own next to a span of the test runner covering the lifetime of the child.
+*
+*   @par --results
+*   used to define the path of an output XML file to which the result of each test case is written as soon as the test case finishes. The file contains the test case
+*   id, path, outcome (<b>passed</b>, <b>failed</b>, <b>aborted</b>, <b>skipped</b>, <b>timeout</b> or <b>flaky</b>), elapsed time in microseconds and, where available, a message.
+*
+*   @par --junit
+*   used to define the path of an output JUnit XML report. Each test case is written as a <c>testcase</c> element as soon as it finishes, along with its
+*   duration and, for test cases which did not pass, a <c>failure</c>, <c>error</c> or <c>skipped</c> element carrying the outcome message. The report
+*   is kept a well-formed document after every test case, so that it remains usable in case the test run is killed.
+*
+*   @par --shard-count, --shard-index
+*   used to split the test cases of a library across multiple Boost External Test Runner invocations (e.g. multiple CI machines). Each invocation executes only
+*   the test cases of the shard with the (zero-based) index supplied via <b>--shard-index</b>. Test cases are assigned to shards deterministically by a stable hash
+*   of their path. Sharding is applied to the whole test tree; Boost UTF selection directives (e.g. --run_test) are applied to the selected shard afterwards.
+*   Test cases which depend on each other (see <c>depends_on</c>) are kept in the same shard, as are the test cases of a test suite with a fixture, so that
+*   the fixture is set up in a single shard. A test suite with a fixture is only split across shards in case it would take more than the fair share of a shard.
+*
+*   @par --shard-durations
+*   used to define the path of a results file (as written by <b>--results</b>) of a previous run. When supplied, test cases are distributed across shards so that
+*   the shards have similar total durations. All shards need to be supplied the same file.
+*
+*   @par --shard-plan
+*   used to define the path of an XML file to which the scheduling decisions of sharding are written: the number of test cases and the cost of each shard,
+*   the test suites with a fixture which are split across shards and the groups of test cases which are kept in the same shard.
+*
+*   @par --merge-results
+*   used to join partial results files (e.g. the results of each shard) into one. The ';' separated list of input files is merged into the file supplied via
+*   <b>--results</b> (or the standard output). The distinct <c>Topology</c> elements of the inputs are retained. No test library is required, e.g.
+*   <c>BoostExternalTestRunner.exe --merge-results "shard0.xml;shard1.xml" --results "all.xml"</c>.
+*
+*   @par --run-list
+*   used to define the path of a file which lists the test units to execute, one test unit id or path (e.g. <c>SuiteA/TestCaseB</c>) per line, as taken
+*   from the discovery output. Empty lines and lines starting with '#' are ignored; listing a test suite selects all of its test cases. The file is read into
+*   hash sets and the selection is applied in a single pass over the test tree, so that selections of any size can be executed without running into
+*   command line length limits, e.g. <c>BoostExternalTestRunner.exe --test "{source}" --run-list "rerun.txt"</c>. The selection cannot be combined with
+*   Boost UTF <b>--run_test</b> filters. Test cases disabled via decorators remain disabled and dependencies of the selected test cases are not selected
+*   implicitly. Entries which do not match any test unit are reported as a warning.
+*
+*   @par --journal
+*   used to define the path of a journal file to which the result of each test case is durably appended as soon as the test case finishes. The journal
+*   identifies the test library build by a fingerprint of its content.
+*
+*   @par --resume
+*   used to resume an interrupted test run from the supplied journal file. In case the journal belongs to the same test library build, the test cases recorded in
+*   the journal are not executed again; a test case which was interrupted while executing (e.g. because it brought the process down) is reported as
+*   <b>aborted</b>. Results of the remaining test cases are appended to the same journal and the <b>--results</b> file combines journalled and new results.
+*   In case the journal belongs to a different build (or does not exist), a new run is started.
+*
+*   @par --rerun-failures
+*   used to define the maximum number of times a test case which did not pass (i.e. failed, aborted or timed out) is executed again at the end of the test run.
+*   Each rerun is executed in a fresh child process so that state left behind by other test cases cannot influence the outcome. A test case which passes on any
+*   rerun is classified as <b>flaky</b>; one which passes on none is a real failure. The classification is reported in the <b>--results</b> file as an additional
+*   entry for the test case which supersedes its initial result. Flaky test cases do not fail the test run.
+*
+*   @par --flaky-stats
+*   used to define the path of a file in which per test case flakiness statistics (number of runs, real failures and flaky runs) are accumulated across test runs.
+*   Only applicable in conjunction with <b>--rerun-failures</b>.
+*
+*   @par --profile-tests
+*   used to define the directory to which a CPU profile of each executed test case is written. The call stacks of the test case are sampled periodically and
+*   written in folded stack format (one <c>{test case path}.folded</c> file per test case, one <c>frame;frame;...;frame {samples}</c> line per distinct stack),
+*   ready to be rendered as a flame graph. On POSIX systems samples are taken in terms of consumed CPU time, on Windows in terms of wall clock time.
+*
+*   @par --profile-interval
+*   used to define the sampling interval, in microseconds, of <b>--profile-tests</b>. Defaults to 1000.
+*
+*   @par --profile-threshold
+*   used to define the minimum duration, in milliseconds, of a test case for its profile to be written. Defaults to 0, i.e. all test cases are profiled.
+*
+*   @par --async-log
+*   used to route the Boost UTF log through an in-memory ring buffer which is written to its destination (<c>stdout</c>, <c>stderr</c> or the path of a log file)
+*   in batches by a background thread, so that heavily logging test cases are not slowed down by log output. Whatever is still buffered is written in case
+*   the process crashes. Takes precedence over the Boost UTF <c>--log_sink</c> directive.
+*
+*   @par --async-log-policy
+*   used to define the behaviour when the ring buffer of <b>--async-log</b> is full: <c>block</c> (default) waits for the background thread to make room,
+*   <c>drop</c> discards the log output which does not fit and reports the amount of discarded output in the log.
+*
+*   @par --async-log-size
+*   used to define the size, in KiB, of the ring buffer of <b>--async-log</b>. Defaults to 1024.
+*
+*   When test cases are executed in child processes (e.g. under timeout supervision or when rerunning failures), the child processes append their log
+*   to the log file started by the supervising test runner.
+*
+*   @par --capture-output
+*   used to capture the standard output, the standard error and the Boost UTF log of each test case and to emit them only for test cases which do not pass,
+*   keeping the log of large test runs readable. The value defines the maximum amount, in KiB, of output retained per test case; the beginning of larger
+*   output is discarded. While a test case runs, its output is held in an in-memory (or temporary) file which is cut down to the most recent output
+*   once it exceeds twice the limit (and at least 1 MiB). Boost UTF loggers writing to a file of their own (<b>--log_sink</b>) are not captured. The
+*   retained output is written to the standard output once the test case finishes and is reported in the <b>--results</b> and <b>--junit</b> documents.
+*   In case the process crashes, the output captured so far (at most the retained amount) is written to the standard output.
+*
 *   @par --list-debug
 *   used to define the path of the output XML file that will contain the test suites, the respective tests contained in the test suite, the source file and the line number
 *   where the test has been declared. A sample XML generated by the command directive <--list-debug> is shown here below
@@ -406,6 +1518,67 @@ int ListTests(const cla::parser& P)
 </BoostTestFramework>
 ~~~~~~~~~~~~~
 *
+*   @par --list-index
+*   used to define the path of an output binary file indexing the test suites and test cases (id, name, path, parent, source file and line) of the library.
+*   The file contains a string table, an array of fixed-size test unit records and hash tables keyed by test unit path and by id, so that it can be memory
+*   mapped and queried in constant time without parsing (refer to <c>BinaryTestIndex.h</c> for the layout and the <c>CBinaryTestIndex</c> reader).
+*   Source locations are those recorded by Boost UTF at registration time.
+*
+*   @par --list-static
+*   used to define the path of an output XML file similar to <b>--list-debug</b> which is derived from the symbol table of the library without loading it,
+*   i.e. without running any of its static initializers or its initialization function. The test tree is rebuilt from the
+*   <c>&lt;suite&gt;::&lt;test&gt;::test_method</c> symbols of auto-registered test cases: the ELF symbol table on POSIX platforms and the exports and
+*   program database (via DbgHelp) on Windows. The root element carries a <c>static="true"</c> attribute. Test unit ids are not known, source locations are
+*   only available on Windows and test cases which are registered manually or generated at runtime (e.g. data-driven test cases) are not listed, e.g.
+*   <c>BoostExternalTestRunner.exe --test "{source}" --list-static "{out}"</c>.
+*
+*   @par --discover, --discover-debug
+*   used to define the path of an output XML file with the same content as the one of <b>--list</b> and <b>--list-debug</b> respectively, which is written
+*   before the tests are executed. Discovery and execution share a single load of the test library, e.g.
+*   <c>BoostExternalTestRunner.exe --test "{source}" --discover-debug "{out}" --results "{results}"</c>. The document describes the complete test tree,
+*   irrespective of any test selection directives.
+*
+*   @par --file-dictionary
+*   used to shorten the output of <b>--list-debug</b> and <b>--discover-debug</b> when supplied the value <c>true</c>. Each distinct source file-path is written
+*   once as a <c>File</c> element, preceding the first test case declared in it, and test cases refer to it via a <c>fileIndex</c> attribute instead of a
+*   <c>file</c> attribute, e.g. <c>&lt;File index="0" path="d:\dev\svn\testproject\numbertest.cpp" /&gt;</c> followed by
+*   <c>&lt;TestCase id="65536" name="NumberTestCaseA" fileIndex="0" line="39" /&gt;</c>.
+*
+*   The test cases generated by a <c>BOOST_DATA_TEST_CASE</c> or a test case template are listed by <b>--list</b>, <b>--list-debug</b>, <b>--discover</b> and
+*   <b>--discover-debug</b> as a single <c>TestCaseFamily</c> element carrying the id range, the size and the shared source location of the family, so that
+*   the listing scales with the number of test cases written rather than with the size of the datasets, e.g.
+*   <c>&lt;TestCaseFamily kind="data" firstId="65538" lastId="75537" size="10000" file="d:\dev\svn\testproject\datatest.cpp" line="12" /&gt;</c> stands for
+*   the test cases <c>_0</c> to <c>_9999</c> (with ids 65538 to 75537). A template family lists the names of its test cases as <c>Instance</c> elements.
+*
+*   @par --expand-families
+*   used to list the test cases of families of generated test cases as individual <c>TestCase</c> elements when supplied the value <c>true</c>.
+*
+*   @par --compress
+*   used to compress the XML output files (<b>--list</b>, <b>--list-debug</b>, <b>--list-static</b>, <b>--discover</b>, <b>--discover-debug</b>, <b>--results</b>, <b>--shard-plan</b>
+*   and <b>--alloc-report</b>) as they are written: <c>gzip</c>, <c>zstd</c> or <c>none</c>. Defaults to the compression implied by the file extension
+*   (<c>.gz</c> or <c>.zst</c>). Zstandard requires a build with <c>ETAS_COMPRESSION_ZSTD</c> defined. Compressed input files (e.g. of <b>--merge-results</b>
+*   and <b>--shard-durations</b>) are recognized by their content and decompressed transparently. Note that compressed results are only complete once the
+*   test run finishes.
+*
+*   @par --history
+*   used to define the path of a binary test history file to which the outcome and elapsed time of each test case is appended once the test run finishes,
+*   e.g. <c>BoostExternalTestRunner.exe --test "{source}" --history "{source}.history"</c>. The file is created if it does not exist. The results of each
+*   run are appended as a single block; a block left incomplete by an interrupted run is ignored and overwritten by the next run. Concurrent test runner
+*   processes may record to the same file; their accesses are serialized by a lock file alongside (<c>{source}.history.lock</c>; refer to
+*   <c>CTestHistory.h</c> for the layout).
+*
+*   @par --history-keep
+*   used to define the number of most recent runs whose individual results are retained (defaults to 16). Once the file holds twice as many runs, the
+*   results of the older runs are folded into per test case totals and the file is rewritten.
+*
+*   @par --history-query, --history-test
+*   used to report the content of a test history file as XML document on the standard output. No test library is required, e.g.
+*   <c>BoostExternalTestRunner.exe --history-query "{source}.history" --history-test "ExampleTestSuite"</c>. <b>--history-test</b> optionally restricts
+*   the report to a test case or to the test cases of a test suite. Each <c>TestCase</c> element states the number of runs per outcome, the mean elapsed
+*   time in microseconds and the outcomes of the retained runs, oldest first, e.g.
+*   <c>&lt;TestCase path="ExampleTestSuite/NumberTestCaseA" passed="41" failed="2" aborted="0" skipped="0" timeout="0" flaky="1" resource-limit="0" meanElapsed="1250" recent="..F.~." /&gt;</c>
+*   where <c>.</c> denotes passed, <c>F</c> failed, <c>A</c> aborted, <c>S</c> skipped, <c>T</c> timeout, <c>~</c> flaky and <c>R</c> resource limit.
+*
 *The typical command line usage of the Boost External Test Runner so as to enumerate tests is
 *
 *   <c>BoostExternalTestRunner.exe --test "{source}" --list-debug "{out}"</c>
@@ -449,6 +1622,11 @@ int ListTests(const cla::parser& P)
 
 #include <boost/test/unit_test.hpp>
 ~~~~~~~~~~~~~
+*
+*Tools which discover and execute tests frequently (e.g. IDE plugins) can avoid spawning a Boost External Test Runner process per request by loading
+*   <b>BoostExternalTestRunnerApi.dll</b> instead. Its C interface (refer to <c>BoostExternalTestRunnerApi.h</c>) opens a test library, enumerates its test units
+*   via a callback, executes a selection of test units and reports test case results as they finish. The conditions listed above apply to the library as well.
+*   Since the Boost UTF framework supports a single test tree per process, a process can load a single test library.
 */
 /*!
   \page License
@@ -477,13 +1655,81 @@ int main(int argc, char* argv[])
         cla::parser P;
 
         P - cla::ignore_mismatch
-                << cla::named_parameter<rt::cstring>("test") - (cla::prefix = "--")
+                << cla::named_parameter<rt::cstring>("test") - (cla::prefix = "--", cla::optional)
                 << cla::named_parameter<rt::cstring>("list") - (cla::prefix = "--", cla::optional)
                 << cla::named_parameter<rt::cstring>("list-debug") - (cla::prefix = "--", cla::optional)
-                << cla::named_parameter<rt::cstring>("init") - (cla::prefix = "--", cla::optional);
+                << cla::named_parameter<rt::cstring>("list-index") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("list-static") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("discover") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("discover-debug") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("init") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("alloc-report") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("test-timeout") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("run-timeout") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("timeout-config") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("snapshot-dir") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("snapshot-file") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("placement") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("reserve-cores") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("reserve-label") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("worker-cpus") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("worker-node") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("worker-test") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("limit-memory") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("limit-cpu") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("limit-files") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("limit-processes") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("limit-cgroup") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("worker-limits") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("trace") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("trace-fragment") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("shard-index") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("shard-count") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("shard-durations") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("shard-plan") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("compress") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("file-dictionary") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("expand-families") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("results") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("junit") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("merge-results") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("history") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("history-keep") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("history-query") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("history-test") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("run-list") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("journal") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("resume") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("rerun-failures") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("flaky-stats") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("profile-tests") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("profile-interval") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("profile-threshold") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("async-log") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("async-log-policy") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("async-log-size") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("async-log-append") - (cla::prefix = "--", cla::optional)
+                << cla::named_parameter<rt::cstring>("capture-output") - (cla::prefix = "--", cla::optional);
 
         P.parse(argc, argv);
 
+        //merging partial results does not involve a test library
+        if (P["merge-results"])
+        {
+            return MergeResults(P);
+        }
+
+        //querying the test history does not involve a test library
+        if (P["history-query"])
+        {
+            return QueryHistory(P);
+        }
+
+        if (!P["test"])
+        {
+            throw std::logic_error("--test is required");
+        }
+
         assign_op(test_lib_name, P.get("test"), 0);
 
         if (P["init"])
@@ -491,22 +1737,63 @@ int main(int argc, char* argv[])
             assign_op(init_func_name, P.get("init"), 0);
         }
 
+        ConfigureTrace(P);
+
+        //pin this process before the library is loaded so that its memory is allocated locally
+        ApplyWorkerPlacement(P);
+
+        if (GetBooleanArgument(P, "worker-limits"))
+        {
+            ::etas::boost::unit_test::InstallResourceLimitHandlers();
+        }
+
+        ConfigurePlacement(P);
+        ConfigureSharding(P);
+        ConfigureJournal(P);
+
+        if (!P["list"] && !P["list-debug"] && !P["list-index"] && !P["list-static"])
+        {
+            ConfigureDiscovery(P);
+            ConfigureRunList(P, argc, argv);
+        }
+
         int res = ::boost::exit_success;
 
         //if the list or the list-debug command line directives are present then just enumerate tests,
         //otherwise execute the tests according to the additional Boost UTF specific  command line options supplied
-        if (P["list"] || P["list-debug"])
+        if (P["list-static"])
+        {
+            //enumerate tests without loading the library
+            res = ListTestsStatic(P);
+        }
+        else if (P["list"] || P["list-debug"])
         {
             res = ListTests(P);
         }
+        else if (P["list-index"])
+        {
+            res = WriteTestIndex(P);
+        }
+        else if (P["test-timeout"] || P["run-timeout"] || P["timeout-config"] || worker_placement || HasResourceLimits(P))
+        {
+            //run tests in child processes under timeout supervision
+            res = RunTestsIsolated(P, argc, argv);
+        }
         else
         {
             //run tests
-            res = ::boost::unit_test::unit_test_main(&load_test_lib, argc, argv);
+            res = RunTests(P, argc, argv);
+        }
+
+        if (GetBooleanArgument(P, "worker-limits"))
+        {
+            res = ::etas::boost::unit_test::GetWorkerExitCode(res);
         }
 
+        WriteTrace(P);
+
         ::boost::unit_test::framework::clear();
-        dyn_lib::close(test_lib_handle);    //unload the library
+        test_lib.reset();    //unload the library
 
         return res;
     }
@@ -515,6 +1802,16 @@ int main(int argc, char* argv[])
         std::cout << "Fail to parse command line arguments: " << ex.msg() << std::endl;
         return -1;
     }
+    catch (std::logic_error const& ex)
+    {
+        std::cout << "Invalid command line arguments: " << ex.what() << std::endl;
+        return -1;
+    }
+    catch (std::runtime_error const& ex)
+    {
+        std::cout << "Fail to run tests: " << ex.what() << std::endl;
+        return -1;
+    }
 }
 
 //____________________________________________________________________________//